@@ -40,8 +40,10 @@
 #include "networkinterfacewatcher.h"
 #include "seshat/seshat.h"
 #include "gitinforecorder.h"
+#include "statusbus.h"
 #include <QMetaType>
 #include <QThread>
+#include <QTimer>
 #include <QList>
 
 using namespace camun::simulator;
@@ -86,6 +88,7 @@ Amun::Amun(bool simulatorOnly, QObject *parent) :
     m_gitInfoRecorder(nullptr)
 {
     qRegisterMetaType<QNetworkInterface>("QNetworkInterface");
+    qRegisterMetaType<QList<Datagram>>("QList<Datagram>");
     qRegisterMetaType<Command>("Command");
     qRegisterMetaType<QList<RobotCommandInfo>>("QList<RobotCommandInfo>");
     qRegisterMetaType< QList<robot::RadioCommand> >("QList<robot::RadioCommand>");
@@ -101,6 +104,8 @@ Amun::Amun(bool simulatorOnly, QObject *parent) :
     qRegisterMetaType<camun::simulator::ErrorSource>("camun::simulator::ErrorSource");
     qRegisterMetaType<amun::CommandReferee>("amun::CommandReferee");
     qRegisterMetaType<SSL_GeometryCameraCalibration>("SSL_GeometryCameraCalibration");
+    qRegisterMetaType<QList<SSL_WrapperPacket>>("QList<SSL_WrapperPacket>");
+    qRegisterMetaType<world::SimulatorState>("world::SimulatorState");
     qRegisterMetaType<world::BallModel>("world::BallModel");
 
     for (int i = 0; i < 3; ++i) {
@@ -164,6 +169,10 @@ Amun::Amun(bool simulatorOnly, QObject *parent) :
 
     m_gitRecorderThread = new QThread(this);
     m_gitRecorderThread->setObjectName("Git Recorder Thread");
+
+    m_statusBusMetricsTimer = new QTimer(this);
+    m_statusBusMetricsTimer->setInterval(1000);
+    connect(m_statusBusMetricsTimer, &QTimer::timeout, this, &Amun::reportStatusBusMetrics);
 }
 
 /*!
@@ -195,6 +204,11 @@ void Amun::start()
     // relay tracking, geometry, referee, controller and accelerator information
     connect(m_processor, SIGNAL(sendStatus(Status)), SLOT(handleStatus(Status)));
 
+    // the strategy status is published on the processor thread without another event loop roundtrip
+    Q_ASSERT(!m_statusBus);
+    m_statusBus.reset(new StatusBus);
+    connect(m_processor, &Processor::sendStrategyStatus, m_statusBus.get(), &StatusBus::publish, Qt::DirectConnection);
+
     m_optionsManager = new OptionsManager;
     m_optionsManager->moveToThread(thread());
     connect(this, SIGNAL(gotCommand(Command)), m_optionsManager, SLOT(handleCommand(Command)));
@@ -244,7 +258,11 @@ void Amun::start()
         connect(m_strategyThread[i], SIGNAL(finished()), m_strategy[i], SLOT(deleteLater()));
 
         // send tracking, geometry and referee to strategy
-        connect(m_processor, SIGNAL(sendStrategyStatus(Status)), m_strategy[i], SLOT(handleStatus(Status)));
+        // the strategy must not miss any status, as these also contain responses to its requests
+        Strategy *strategyObject = m_strategy[i];
+        m_statusBus->subscribe(m_strategyThread[i]->objectName(), strategyObject,
+                               [strategyObject](const Status &status) { strategyObject->handleStatus(status); },
+                               StatusBus::Policy::Lossless);
         connect(m_optionsManager, SIGNAL(sendStatus(Status)), m_strategy[i], SLOT(handleStatus(Status)));
         // forward robot commands to processor
         connect(m_strategy[i], SIGNAL(sendStrategyCommands(bool, QList<RobotCommandInfo>, qint64)),
@@ -323,6 +341,8 @@ void Amun::start()
     if (!m_simulatorOnly) {
         Q_ASSERT(m_radio == nullptr);
         m_radio = new RadioSystem(m_timer);
+        // the timing is shown in the ui
+        m_radio->setTimingReportEnabled(true);
         m_radio->moveToThread(m_radioThread);
         connect(m_radioThread, &QThread::finished, m_radio, &RadioSystem::deleteLater);
         // route commands to transceiver
@@ -355,6 +375,8 @@ void Amun::start()
     }
     m_debugHelperThread->start();
     m_gitRecorderThread->start();
+
+    m_statusBusMetricsTimer->start();
 }
 
 /*!
@@ -364,6 +386,8 @@ void Amun::start()
  */
 void Amun::stop()
 {
+    m_statusBusMetricsTimer->stop();
+
     // stop threads
     m_processorThread->quit();
     m_radioThread->quit();
@@ -410,6 +434,8 @@ void Amun::stop()
     m_processor = nullptr;
     m_integrator = nullptr;
     m_gitInfoRecorder = nullptr;
+    // no thread can publish anymore
+    m_statusBus.reset();
 }
 
 void Amun::setupReceiver(Receiver *&receiver, const QHostAddress &address, quint16 port)
@@ -614,6 +640,33 @@ void Amun::handleStatus(const Status &status)
     m_seshat->handleStatus(status);
 }
 
+void Amun::reportStatusBusMetrics()
+{
+    if (!m_statusBus) {
+        return;
+    }
+
+    quint64 delivered = 0;
+    qint64 totalLatency = 0;
+    qint64 maxLatency = 0;
+    float fill = 0;
+    for (const StatusBus::QueueMetrics &queue : m_statusBus->metrics(true)) {
+        delivered += queue.delivered;
+        totalLatency += queue.meanLatency * static_cast<qint64>(queue.delivered);
+        maxLatency = std::max(maxLatency, queue.maxLatency);
+        fill = std::max(fill, queue.depth / static_cast<float>(queue.capacity));
+    }
+
+    Status status(new amun::Status);
+    amun::Timing *timing = status->mutable_timing();
+    if (delivered > 0) {
+        timing->set_status_bus_latency(totalLatency / static_cast<qint64>(delivered) * 1E-9f);
+        timing->set_status_bus_max_latency(maxLatency * 1E-9f);
+    }
+    timing->set_status_bus_fill(fill);
+    handleStatus(status);
+}
+
 void Amun::handleStatusForReplay(const Status &status)
 {
     if (m_enableTrackingReplay) {
@@ -696,13 +749,13 @@ void Amun::setSimulatorEnabled(bool enabled, bool useNetworkTransceiver)
 
     // setup connections for vision
     if (enabled) {
-        connect(m_simulator, SIGNAL(gotPacket(QByteArray, qint64, QString)),
-                m_processor, SLOT(handleVisionPacket(QByteArray, qint64, QString)));
-        connect(m_simulator, &Simulator::sendRealData, m_processor, &Processor::handleSimulatorExtraVision);
+        // hand over the vision structs directly, serializing them is only necessary for the network
+        connect(m_simulator, &Simulator::gotVisionPackets, m_processor, &Processor::handleVisionPackets);
+        connect(m_simulator, &Simulator::sendRealState, m_processor, &Processor::handleSimulatorState);
 
     } else {
-        connect(m_vision, SIGNAL(gotPacket(QByteArray, qint64, QString)),
-                m_processor, SLOT(handleVisionPacket(QByteArray, qint64, QString)));
+        // a burst of camera frames is passed on as a single event
+        connect(m_vision, &Receiver::gotPackets, m_processor, &Processor::handleVisionDatagrams);
     }
 
     // setup connections for robot responses
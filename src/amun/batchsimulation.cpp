@@ -0,0 +1,168 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "batchsimulation.h"
+#include "simulationpipeline.h"
+#include "processor/processor.h"
+#include "strategy/script/compilerregistry.h"
+#include "protobuf/gamestate.pb.h"
+#include <QMetaType>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// blocks until all workers finished the current step
+class StepBarrier
+{
+public:
+    explicit StepBarrier(int count) : m_count(count) {}
+
+    void wait()
+    {
+        QMutexLocker locker(&m_mutex);
+        const int generation = m_generation;
+        if (++m_waiting == m_count) {
+            m_waiting = 0;
+            m_generation++;
+            m_condition.wakeAll();
+            return;
+        }
+        while (generation == m_generation) {
+            m_condition.wait(&m_mutex);
+        }
+    }
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    const int m_count;
+    int m_waiting = 0;
+    int m_generation = 0;
+};
+
+class BatchWorker : public QThread
+{
+public:
+    BatchWorker(const BatchSimulationConfig &config, const BatchSimulation::StatusHandler &handler,
+                StepBarrier &barrier, qint64 steps, QList<BatchSimulationResult *> results) :
+        m_config(config),
+        m_statusHandler(handler),
+        m_barrier(barrier),
+        m_steps(steps),
+        m_results(results)
+    { }
+
+protected:
+    void run() override
+    {
+        // the pipelines have to be created on this thread, as they are never moved
+        CompilerRegistry compilerRegistry;
+        std::vector<std::unique_ptr<SimulationPipeline>> pipelines;
+        for (BatchSimulationResult *result : m_results) {
+            pipelines.emplace_back(new SimulationPipeline(m_config.simulatorSetup, result->seed, &compilerRegistry));
+            SimulationPipeline *pipeline = pipelines.back().get();
+            const BatchSimulation::StatusHandler &handler = m_statusHandler;
+            QObject::connect(pipeline, &SimulationPipeline::sendStatus, [result, handler](const Status &status) {
+                if (status->has_status_strategy() && status->status_strategy().status().state() == amun::StatusStrategy::FAILED) {
+                    result->strategyFailed = true;
+                }
+                if (status->has_game_state()) {
+                    result->scoreBlue = status->game_state().blue().score();
+                    result->scoreYellow = status->game_state().yellow().score();
+                }
+                if (handler) {
+                    handler(result->instance, status);
+                }
+            });
+            for (const Command &command : m_config.commands) {
+                pipeline->handleCommand(command);
+            }
+        }
+
+        qint64 startTime = pipelines.empty() ? 0 : pipelines.front()->time();
+        for (qint64 i = 0; i < m_steps; i++) {
+            for (auto &pipeline : pipelines) {
+                pipeline->step();
+            }
+            m_barrier.wait();
+        }
+
+        for (int i = 0; i < m_results.size(); i++) {
+            m_results[i]->simulatedTime = pipelines[i]->time() - startTime;
+        }
+    }
+
+private:
+    const BatchSimulationConfig &m_config;
+    const BatchSimulation::StatusHandler &m_statusHandler;
+    StepBarrier &m_barrier;
+    const qint64 m_steps;
+    const QList<BatchSimulationResult *> m_results;
+};
+
+}
+
+BatchSimulation::BatchSimulation(const BatchSimulationConfig &config) :
+    m_config(config)
+{
+    // for the connections to the game controller threads
+    qRegisterMetaType<Command>("Command");
+    qRegisterMetaType<Status>("Status");
+    qRegisterMetaType<amun::CommandReferee>("amun::CommandReferee");
+}
+
+QList<BatchSimulationResult> BatchSimulation::run()
+{
+    QList<BatchSimulationResult> results;
+    for (int i = 0; i < m_config.instances; i++) {
+        BatchSimulationResult result;
+        result.instance = i;
+        result.seed = m_config.firstSeed + i;
+        results.append(result);
+    }
+    if (results.isEmpty()) {
+        return results;
+    }
+
+    const int threadCount = std::min(m_config.instances, m_config.threads > 0 ? m_config.threads : QThread::idealThreadCount());
+    const qint64 tickDuration = 1000 * 1000 * 1000 / Processor::FREQUENCY;
+    const qint64 steps = (m_config.duration + tickDuration - 1) / tickDuration;
+
+    StepBarrier barrier(threadCount);
+    std::vector<std::unique_ptr<BatchWorker>> workers;
+    for (int t = 0; t < threadCount; t++) {
+        QList<BatchSimulationResult *> workerResults;
+        for (int i = t; i < results.size(); i += threadCount) {
+            workerResults.append(&results[i]);
+        }
+        workers.emplace_back(new BatchWorker(m_config, m_statusHandler, barrier, steps, workerResults));
+    }
+    for (auto &worker : workers) {
+        worker->start();
+    }
+    for (auto &worker : workers) {
+        worker->wait();
+    }
+    return results;
+}
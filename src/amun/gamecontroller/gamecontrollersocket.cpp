@@ -81,18 +81,20 @@ bool GameControllerSocket::sendGameControllerMessage(const google::protobuf::Mes
     if (connectGameController()) {
         google::protobuf::uint32 messageLength = message->ByteSize();
         int bufferLength = messageLength + 20; // for some extra space
-        std::vector<google::protobuf::uint8> buffer(bufferLength);
+        // reuse the buffer, tracking data is sent continuously
+        if (m_sendBuffer.size() < bufferLength) {
+            m_sendBuffer.resize(bufferLength);
+        }
 
-        google::protobuf::io::ArrayOutputStream arrayOutput(buffer.data(), bufferLength);
+        google::protobuf::io::ArrayOutputStream arrayOutput(m_sendBuffer.data(), bufferLength);
         google::protobuf::io::CodedOutputStream codedOutput(&arrayOutput);
         if (!google::protobuf::util::SerializeDelimitedToCodedStream(*message, &codedOutput)) {
             return false;
         }
-
-        QByteArray serializedMessage((char*)buffer.data(), (int)codedOutput.ByteCount());
-
-        auto count = m_gameControllerSocket.write(serializedMessage);
-        return count == serializedMessage.size();
+        const qint64 size = codedOutput.ByteCount();
+        // write copies into the socket buffer
+        auto count = m_gameControllerSocket.write(m_sendBuffer.constData(), size);
+        return count == size;
     }
     return false;
 }
@@ -44,6 +44,7 @@ private:
     QTcpSocket m_gameControllerSocket;
     int m_nextPackageSize = -1; // negative if not known yet
     QByteArray m_partialPacket;
+    QByteArray m_sendBuffer;
     unsigned int m_sizeBytesPosition = 0;
     QHostAddress m_gameControllerHost;
 
@@ -78,7 +78,10 @@ private:
     GameControllerSocket m_gcCIProtocolConnection;
     std::unique_ptr<SSLVisionTracked> m_trackedVisionGenerator;
     SSL_Referee m_lastReferee;
-    std::string m_geometryString;
+    world::Geometry m_lastGeometry;
+    bool m_geometrySent = false;
+    gameController::CiInput m_trackedFrameInput;
+    qint64 m_lastTrackedFrameTime = 0;
     // these inputs will be sent once the first packet goes through to the GC
     QVector<gameController::CiInput> m_queuedInputs;
     world::Geometry::Division m_currentDivision = world::Geometry::A;
@@ -101,4 +104,6 @@ private:
 
     // the first port that will be chosen for the connection if it is available
     static constexpr int GC_CI_PORT_START = 10209;
+    // minimum time between two tracked frames sent to the game controller, in nanoseconds
+    static constexpr qint64 TRACKED_FRAME_INTERVAL = 20 * 1000 * 1000;
 };
@@ -31,6 +31,7 @@
 #include <QRegularExpression>
 #include <QFile>
 #include <QTcpServer>
+#include <google/protobuf/util/message_differencer.h>
 
 static const QString SENDER_NAME_FOR_REFEREE = "Internal/SSL Game Controller";
 
@@ -84,13 +85,14 @@ void InternalGameController::handleStatus(const Status &status)
     }
 
     if (status->has_geometry()) {
-        const std::string str = status->geometry().SerializeAsString();
-        if (str != m_geometryString) {
+        // compare the fields directly, serializing the geometry just for the comparison is wasteful
+        if (!m_geometrySent || !google::protobuf::util::MessageDifferencer::Equals(status->geometry(), m_lastGeometry)) {
             gameController::CiInput input;
             input.set_timestamp(status->world_state().time());
             convertToSSlGeometry(status->geometry(), input.mutable_geometry()->mutable_field());
             if (sendCiInput(input)) {
-                m_geometryString = str;
+                m_lastGeometry.CopyFrom(status->geometry());
+                m_geometrySent = true;
             }
         }
 
@@ -130,11 +132,17 @@ void InternalGameController::handleStatus(const Status &status)
     }
 
     if (status->has_world_state()) {
-        gameController::CiInput ciInput;
-        ciInput.set_timestamp(status->world_state().time());
-        m_trackedVisionGenerator->createTrackedFrame(status->world_state(), ciInput.mutable_tracker_packet());
-
-        sendCiInput(ciInput);
+        // the game controller only evaluates slow changing situations like ball placement,
+        // thus there is no need to serialize and send every tracking frame
+        const qint64 worldTime = status->world_state().time();
+        if (worldTime < m_lastTrackedFrameTime || worldTime - m_lastTrackedFrameTime >= TRACKED_FRAME_INTERVAL) {
+            // the input is reused to avoid reallocating the robot messages each time
+            m_trackedFrameInput.set_timestamp(worldTime);
+            m_trackedVisionGenerator->createTrackedFrame(status->world_state(), m_trackedFrameInput.mutable_tracker_packet());
+            if (sendCiInput(m_trackedFrameInput)) {
+                m_lastTrackedFrameTime = worldTime;
+            }
+        }
 
         // the delayed sending of the freekick command from handlePlacementFailure()
         if (m_continueFrameCounter > 0) {
@@ -597,8 +605,9 @@ void InternalGameController::start()
         m_lastReferee.Clear();
         handleRefereeUpdate(prevReferee, true);
 
-        // trigger a re-send of the geometry
-        m_geometryString.clear();
+        // trigger a re-send of the geometry and tracking data
+        m_geometrySent = false;
+        m_lastTrackedFrameTime = 0;
     }
 
     // find a free port for the ci connection
@@ -65,6 +65,10 @@ void SSLVisionTracked::createTrackedFrame(const world::State &state, gameControl
     packet->set_uuid(m_uuid);
     packet->set_source_name(SOURCE_NAME);
     auto frame = packet->mutable_tracked_frame();
+    // the packet may be reused, clearing keeps the previously allocated messages around
+    frame->clear_balls();
+    frame->clear_robots();
+    frame->clear_capabilities();
     frame->set_frame_number(m_trackedFrameCounter++);
     frame->set_timestamp(state.time() / NS_PER_SEC);
 
@@ -47,6 +47,8 @@ class OptionsManager;
 class Seshat;
 class CommandConverter;
 class GitInfoRecorder;
+class StatusBus;
+class QTimer;
 
 namespace camun {
     namespace simulator {
@@ -85,6 +87,7 @@ private slots:
     void handleReplayStatus(const Status &status);
     void handleStatusForReplay(const Status &status);
     void handleCommandLocally(const Command& command);
+    void reportStatusBusMetrics();
 
 private:
     void setupReceiver(Receiver *&receiver, const QHostAddress &address, quint16 port);
@@ -142,6 +145,9 @@ private:
 
     CommandConverter *m_commandConverter;
 	GitInfoRecorder *m_gitInfoRecorder;
+
+    std::unique_ptr<StatusBus> m_statusBus;
+    QTimer *m_statusBusMetricsTimer;
 };
 
 #endif // AMUN_H
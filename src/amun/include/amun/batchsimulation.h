@@ -0,0 +1,75 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef BATCHSIMULATION_H
+#define BATCHSIMULATION_H
+
+#include "protobuf/command.h"
+#include "protobuf/status.h"
+#include <QList>
+#include <cstdint>
+#include <functional>
+
+struct BatchSimulationConfig
+{
+    amun::SimulatorSetup simulatorSetup;
+    // sent to every instance before the first step, e.g. teams, realism and strategy loads
+    QList<Command> commands;
+    int instances = 1;
+    // number of worker threads, uses QThread::idealThreadCount() if zero
+    int threads = 0;
+    // simulated time per instance in nanoseconds
+    qint64 duration = 0;
+    // instance i uses the simulator seed firstSeed + i
+    uint32_t firstSeed = 1;
+};
+
+struct BatchSimulationResult
+{
+    int instance = 0;
+    uint32_t seed = 0;
+    qint64 simulatedTime = 0;
+    bool strategyFailed = false;
+    uint32_t scoreBlue = 0;
+    uint32_t scoreYellow = 0;
+};
+
+// Runs many independent simulator, processor and strategy pipelines without a running event loop.
+// The instances are distributed over a pool of worker threads and advance in lockstep,
+// one processor tick at a time.
+class BatchSimulation
+{
+public:
+    typedef std::function<void(int instance, const Status &status)> StatusHandler;
+
+    explicit BatchSimulation(const BatchSimulationConfig &config);
+    BatchSimulation(const BatchSimulation&) = delete;
+    BatchSimulation& operator=(const BatchSimulation&) = delete;
+
+    // the handler is called from the worker thread of the instance
+    void setStatusHandler(const StatusHandler &handler) { m_statusHandler = handler; }
+    // blocks until every instance simulated the configured duration
+    QList<BatchSimulationResult> run();
+
+private:
+    const BatchSimulationConfig m_config;
+    StatusHandler m_statusHandler;
+};
+
+#endif // BATCHSIMULATION_H
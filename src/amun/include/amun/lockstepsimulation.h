@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef LOCKSTEPSIMULATION_H
+#define LOCKSTEPSIMULATION_H
+
+#include "protobuf/command.h"
+#include "protobuf/status.h"
+#include <QList>
+#include <QObject>
+#include <cstdint>
+#include <memory>
+
+class CompilerRegistry;
+class SimulationPipeline;
+
+// Drop-in replacement for AmunClient in simulation only setups.
+// Simulator, processor and strategies run on the calling thread and advance in a fixed order,
+// one processor tick at a time and as fast as possible. Thus the results only depend on the
+// seed and the received commands, but not on the timing of the machine.
+class LockstepSimulation : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LockstepSimulation(uint32_t seed, QObject *parent = nullptr);
+    ~LockstepSimulation() override;
+    LockstepSimulation(const LockstepSimulation&) = delete;
+    LockstepSimulation& operator=(const LockstepSimulation&) = delete;
+
+    // commands sent before are applied before the first tick
+    void start();
+
+signals:
+    void gotStatus(const Status &status);
+
+public slots:
+    void sendCommand(const Command &command);
+
+private:
+    void scheduleRun();
+    void run();
+    void step();
+
+private:
+    std::unique_ptr<CompilerRegistry> m_compilerRegistry;
+    std::unique_ptr<SimulationPipeline> m_pipeline;
+    bool m_started = false;
+    bool m_runScheduled = false;
+    bool m_inStep = false;
+    QList<Command> m_pendingCommands;
+};
+
+#endif // LOCKSTEPSIMULATION_H
@@ -0,0 +1,61 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef STATUSBUS_H
+#define STATUSBUS_H
+
+#include "core/statusqueue.h"
+#include "protobuf/status.h"
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//! Fan-out of status messages to subscribers on other threads.
+//! Each subscriber owns a StatusQueue which is drained on the thread of its context object.
+class StatusBus : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef StatusQueue::Policy Policy;
+    typedef StatusQueue::Metrics QueueMetrics;
+    typedef StatusQueue::Handler Handler;
+
+public:
+    explicit StatusBus(QObject *parent = nullptr);
+    ~StatusBus() override;
+    StatusBus(const StatusBus&) = delete;
+    StatusBus& operator=(const StatusBus&) = delete;
+
+    // all subscriptions must be done before the first status is published
+    void subscribe(const QString &name, QObject *context, Handler handler, Policy policy, int capacity = 256);
+    QList<QueueMetrics> metrics(bool reset = false) const;
+
+public slots:
+    // thread safe
+    void publish(const Status &status);
+
+private:
+    std::vector<std::shared_ptr<StatusQueue>> m_queues;
+};
+
+#endif // STATUSBUS_H
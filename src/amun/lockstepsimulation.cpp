@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "lockstepsimulation.h"
+#include "simulationpipeline.h"
+#include "strategy/script/compilerregistry.h"
+#include <QMetaObject>
+#include <QMetaType>
+
+// return to the event loop after 100 ms of simulated time, to handle e.g. exit requests
+static const int TICKS_PER_RUN = 10;
+
+LockstepSimulation::LockstepSimulation(uint32_t seed, QObject *parent) :
+    QObject(parent),
+    m_compilerRegistry(new CompilerRegistry)
+{
+    // for the queued connections inside the pipeline
+    qRegisterMetaType<Command>("Command");
+    qRegisterMetaType<Status>("Status");
+    qRegisterMetaType<amun::CommandReferee>("amun::CommandReferee");
+
+    amun::SimulatorSetup defaultSimulatorSetup;
+    simulatorSetupSetDefault(defaultSimulatorSetup);
+    m_pipeline.reset(new SimulationPipeline(defaultSimulatorSetup, seed, m_compilerRegistry.get()));
+    connect(m_pipeline.get(), &SimulationPipeline::sendStatus, this, &LockstepSimulation::gotStatus);
+}
+
+LockstepSimulation::~LockstepSimulation()
+{
+    // the strategies reference the compiler registry
+    m_pipeline.reset();
+}
+
+void LockstepSimulation::start()
+{
+    m_started = true;
+    scheduleRun();
+}
+
+void LockstepSimulation::sendCommand(const Command &command)
+{
+    if (m_inStep) {
+        // receivers of gotStatus may answer with a command, apply it after the tick
+        // just like a queued connection to Amun would
+        m_pendingCommands.append(command);
+        return;
+    }
+    m_pipeline->handleCommand(command);
+    scheduleRun();
+}
+
+void LockstepSimulation::scheduleRun()
+{
+    if (!m_started || m_runScheduled || m_pipeline->isPaused()) {
+        return;
+    }
+    m_runScheduled = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        run();
+    }, Qt::QueuedConnection);
+}
+
+void LockstepSimulation::run()
+{
+    m_runScheduled = false;
+    for (int i = 0; i < TICKS_PER_RUN && !m_pipeline->isPaused(); i++) {
+        step();
+    }
+    // resumed by the command that ends the pause
+    scheduleRun();
+}
+
+void LockstepSimulation::step()
+{
+    m_inStep = true;
+    m_pipeline->step();
+    m_inStep = false;
+
+    const QList<Command> commands = m_pendingCommands;
+    m_pendingCommands.clear();
+    for (const Command &command : commands) {
+        m_pipeline->handleCommand(command);
+    }
+}
@@ -0,0 +1,177 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "multidatagramsocket.h"
+#include <QHostAddress>
+#include <QNetworkInterface>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+// room for a single SCM_TIMESTAMPNS message
+static const std::size_t CONTROL_SIZE = CMSG_SPACE(sizeof(timespec));
+
+/*!
+ * \class MultiDatagramSocket
+ * \ingroup amun
+ * \brief Linux udp socket which receives datagrams in batches
+ *
+ * All buffers are allocated once on construction, reading a batch does not
+ * allocate any memory.
+ */
+
+MultiDatagramSocket::MultiDatagramSocket(int batchSize, int maxDatagramSize) :
+    m_batchSize(batchSize),
+    m_maxDatagramSize(maxDatagramSize),
+    m_fd(-1),
+    m_buffer(std::size_t(batchSize) * maxDatagramSize),
+    m_control(std::size_t(batchSize) * CONTROL_SIZE),
+    m_iovecs(batchSize),
+    m_headers(batchSize),
+    m_addresses(batchSize),
+    m_packets(batchSize)
+{
+    for (int i = 0; i < m_batchSize; i++) {
+        m_iovecs[i].iov_base = m_buffer.data() + std::size_t(i) * m_maxDatagramSize;
+        m_iovecs[i].iov_len = m_maxDatagramSize;
+    }
+}
+
+MultiDatagramSocket::~MultiDatagramSocket()
+{
+    close();
+}
+
+void MultiDatagramSocket::setError(const char *operation)
+{
+    m_errorString = QString("%1: %2").arg(operation).arg(std::strerror(errno));
+}
+
+bool MultiDatagramSocket::bind(quint16 port)
+{
+    close();
+
+    m_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_fd == -1) {
+        setError("socket");
+        return false;
+    }
+
+    // same behaviour as QUdpSocket::ShareAddress
+    const int enable = 1;
+    if (::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == -1) {
+        setError("SO_REUSEADDR");
+        close();
+        return false;
+    }
+    // without kernel timestamps the receive time is taken after reading
+    ::setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+        setError("bind");
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MultiDatagramSocket::close()
+{
+    if (m_fd != -1) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool MultiDatagramSocket::joinMulticastGroup(const QHostAddress &group, const QNetworkInterface &iface)
+{
+    if (m_fd == -1 || group.protocol() != QAbstractSocket::IPv4Protocol) {
+        return false;
+    }
+
+    ip_mreqn request;
+    std::memset(&request, 0, sizeof(request));
+    request.imr_multiaddr.s_addr = htonl(group.toIPv4Address());
+    request.imr_address.s_addr = htonl(INADDR_ANY);
+    request.imr_ifindex = iface.index();
+    if (::setsockopt(m_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request)) == -1) {
+        setError("IP_ADD_MEMBERSHIP");
+        return false;
+    }
+    return true;
+}
+
+int MultiDatagramSocket::readBatch()
+{
+    if (m_fd == -1) {
+        return -1;
+    }
+
+    // the kernel overwrites the lengths, thus reset them for every call
+    for (int i = 0; i < m_batchSize; i++) {
+        msghdr &header = m_headers[i].msg_hdr;
+        std::memset(&header, 0, sizeof(header));
+        header.msg_name = &m_addresses[i];
+        header.msg_namelen = sizeof(sockaddr_in);
+        header.msg_iov = &m_iovecs[i];
+        header.msg_iovlen = 1;
+        header.msg_control = m_control.data() + std::size_t(i) * CONTROL_SIZE;
+        header.msg_controllen = CONTROL_SIZE;
+        m_headers[i].msg_len = 0;
+    }
+
+    int count;
+    do {
+        count = ::recvmmsg(m_fd, m_headers.data(), m_batchSize, MSG_DONTWAIT, nullptr);
+    } while (count == -1 && errno == EINTR);
+
+    if (count == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        setError("recvmmsg");
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        msghdr &header = m_headers[i].msg_hdr;
+        Packet &packet = m_packets[i];
+        packet.data = static_cast<const char*>(m_iovecs[i].iov_base);
+        packet.size = int(m_headers[i].msg_len);
+        packet.sender = ntohl(m_addresses[i].sin_addr.s_addr);
+        packet.timestamp = 0;
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                packet.timestamp = qint64(ts.tv_sec) * 1000000000LL + qint64(ts.tv_nsec);
+            }
+        }
+    }
+    return count;
+}
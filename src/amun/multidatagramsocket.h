@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef MULTIDATAGRAMSOCKET_H
+#define MULTIDATAGRAMSOCKET_H
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+struct iovec;
+struct mmsghdr;
+struct sockaddr_in;
+class QHostAddress;
+class QNetworkInterface;
+
+// IPv4 udp socket reading batches of datagrams with a single recvmmsg call
+// each datagram carries the kernel receive timestamp (SO_TIMESTAMPNS)
+class MultiDatagramSocket
+{
+public:
+    struct Packet {
+        const char *data;
+        int size;
+        // CLOCK_REALTIME in nanoseconds, 0 if the kernel did not provide a timestamp
+        qint64 timestamp;
+        // in host byte order
+        quint32 sender;
+    };
+
+public:
+    MultiDatagramSocket(int batchSize, int maxDatagramSize);
+    ~MultiDatagramSocket();
+    MultiDatagramSocket(const MultiDatagramSocket&) = delete;
+    MultiDatagramSocket& operator=(const MultiDatagramSocket&) = delete;
+
+    bool bind(quint16 port);
+    void close();
+    int descriptor() const { return m_fd; }
+    int batchSize() const { return m_batchSize; }
+    bool joinMulticastGroup(const QHostAddress &group, const QNetworkInterface &iface);
+
+    // reads up to batchSize datagrams without blocking
+    // returns the number of datagrams read or -1 on error
+    // the packets point into an internal buffer and stay valid until the next call
+    int readBatch();
+    const Packet &packet(int index) const { return m_packets[index]; }
+
+    QString errorString() const { return m_errorString; }
+
+private:
+    void setError(const char *operation);
+
+private:
+    const int m_batchSize;
+    const int m_maxDatagramSize;
+    int m_fd;
+
+    std::vector<char> m_buffer;
+    std::vector<char> m_control;
+    std::vector<iovec> m_iovecs;
+    std::vector<mmsghdr> m_headers;
+    std::vector<sockaddr_in> m_addresses;
+    std::vector<Packet> m_packets;
+
+    QString m_errorString;
+};
+
+#endif // MULTIDATAGRAMSOCKET_H
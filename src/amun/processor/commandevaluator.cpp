@@ -29,6 +29,8 @@
 
 CommandEvaluator::CommandEvaluator(const robot::Specs &specs) :
     m_specs(specs),
+    m_splinesOrdered(true),
+    m_activeSpline(0),
     m_startTime(0),
     m_baseSpeed(0, 0, 0),
     m_baseSpeedTime(0)
@@ -39,6 +41,7 @@ void CommandEvaluator::setInput(const robot::ControllerInput &input, qint64 curr
 {
     m_input = input;
     m_startTime = currentTime;
+    compileSplines();
 }
 
 void CommandEvaluator::clearInput()
@@ -175,27 +178,61 @@ GlobalSpeed CommandEvaluator::evaluateSplineAtTime(const qint64 worldTime)
     int activeSplineIndex = findActiveSpline(timeElapsed);
     if (activeSplineIndex >= 0) {
         // generate the desired state
-        return evaluateSplinePartAtTime(m_input.spline(activeSplineIndex), timeElapsed);
+        return evaluateSplinePartAtTime(m_splines[activeSplineIndex], timeElapsed);
     }
     return GlobalSpeed(0, 0, 0);
 }
 
+void CommandEvaluator::compileSplines()
+{
+    m_splines.clear();
+    m_splines.reserve(m_input.spline_size());
+    m_splinesOrdered = true;
+    m_activeSpline = 0;
+
+    for (const robot::Spline &spline : m_input.spline()) {
+        CompiledSpline compiled;
+        compiled.t_start = spline.t_start();
+        compiled.t_end = spline.t_end();
+        const robot::Polynomial *polynomials[3] = { &spline.x(), &spline.y(), &spline.phi() };
+        float *derivatives[3] = { compiled.x, compiled.y, compiled.phi };
+        for (int i = 0; i < 3; i++) {
+            derivatives[i][0] = polynomials[i]->a1();
+            derivatives[i][1] = 2 * polynomials[i]->a2();
+            derivatives[i][2] = 3 * polynomials[i]->a3();
+        }
+
+        if (!m_splines.empty() && m_splines.back().t_end > compiled.t_start) {
+            m_splinesOrdered = false;
+        }
+        m_splines.push_back(compiled);
+    }
+}
+
 int CommandEvaluator::findActiveSpline(const float time)
 {
-    for (int i = 0; i < m_input.spline_size(); i++) {
-        const robot::Spline &spline = m_input.spline(i);
-        if (spline.t_start() <= time && time < spline.t_end()) {
+    // the time only increases between calls for an input, so the search can usually continue
+    // at the last active spline. If the splines overlap, the first matching one has to be found.
+    int start = m_activeSpline;
+    if (!m_splinesOrdered || start >= int(m_splines.size()) || time < m_splines[start].t_start) {
+        start = 0;
+    }
+
+    for (int i = start; i < int(m_splines.size()); i++) {
+        const CompiledSpline &spline = m_splines[i];
+        if (spline.t_start <= time && time < spline.t_end) {
+            m_activeSpline = i;
             return i;
         }
     }
     return -1;
 }
 
-GlobalSpeed CommandEvaluator::evaluateSplinePartAtTime(const robot::Spline &spline, const float t)
+GlobalSpeed CommandEvaluator::evaluateSplinePartAtTime(const CompiledSpline &spline, const float t)
 {
-    float v_x = spline.x().a1() + (2 * spline.x().a2() + 3 * spline.x().a3() * t) * t;
-    float v_y = spline.y().a1() + (2 * spline.y().a2() + 3 * spline.y().a3() * t) * t;
-    float omega = spline.phi().a1() + (2 * spline.phi().a2() + 3 * spline.phi().a3() * t) * t;
+    float v_x = spline.x[0] + (spline.x[1] + spline.x[2] * t) * t;
+    float v_y = spline.y[0] + (spline.y[1] + spline.y[2] * t) * t;
+    float omega = spline.phi[0] + (spline.phi[1] + spline.phi[2] * t) * t;
     return GlobalSpeed(v_x, v_y, omega);
 }
 
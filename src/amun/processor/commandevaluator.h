@@ -25,6 +25,7 @@
 #include "coordinatehelper.h"
 #include "protobuf/robot.pb.h"
 #include <QtGlobal>
+#include <vector>
 
 namespace amun { class DebugValues; }
 namespace world { class Robot; }
@@ -49,14 +50,26 @@ public:
     bool hasInput();
     qint64 startTime() const{ return m_startTime; }
 
+private:
+    // spline part with the coefficients of its derivative, v(t) = v0 + (v1 + v2 * t) * t
+    struct CompiledSpline
+    {
+        float t_start;
+        float t_end;
+        float x[3];
+        float y[3];
+        float phi[3];
+    };
+
 private:
     static float robotToPhi(const world::Robot *robot);
     GlobalSpeed evaluateInput(bool hasTrackedRobot, float robotPhi, qint64 worldTime, const robot::Command &command, amun::DebugValues *debug, bool hasManualCommand);
     LocalSpeed evaluateLocalManualControl(const robot::Command &command);
     GlobalSpeed evaluateGlobalManualControl(const robot::Command &command);
     GlobalSpeed evaluateSplineAtTime(const qint64 worldTime);
+    void compileSplines();
     int findActiveSpline(const float time);
-    GlobalSpeed evaluateSplinePartAtTime(const robot::Spline &spline, const float t);
+    static GlobalSpeed evaluateSplinePartAtTime(const CompiledSpline &spline, const float t);
 
     void logInvalidCommand(amun::DebugValues *debug, qint64 worldTime);
     void drawSpline(amun::DebugValues *debug);
@@ -69,6 +82,12 @@ private:
     const robot::Specs m_specs;
 
     robot::ControllerInput m_input;
+    // m_input in a layout for fast evaluation, built once per input
+    std::vector<CompiledSpline> m_splines;
+    // true if the splines are ordered by time and do not overlap
+    bool m_splinesOrdered;
+    // index of the last active spline, the next search starts there
+    int m_activeSpline;
     // Time (absolute) when new input arrived, in ns.
     qint64 m_startTime;
 
@@ -21,6 +21,8 @@
 #ifndef PROCESSOR_H
 #define PROCESSOR_H
 
+#include "core/allocationprofiler.h"
+#include "core/datagram.h"
 #include "protobuf/command.h"
 #include "protobuf/robotcommand.h"
 #include "protobuf/ssl_mixed_team.pb.h"
@@ -32,6 +34,7 @@
 #include <QThread>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -50,6 +53,8 @@ class Processor : public QObject
 
 public:
     static const int FREQUENCY;
+    // state of trackers, world parameters and referee, see Tracker::Checkpoint
+    struct TrackingCheckpoint;
 
     explicit Processor(const Timer *timer, bool isReplay);
     ~Processor() override;
@@ -58,6 +63,8 @@ public:
     bool getIsFlipped() const { return m_lastFlipped; }
     InternalGameController *getInternalGameController() const { return m_gameController; }
     void resetTracking();
+    std::shared_ptr<const TrackingCheckpoint> trackingCheckpoint() const;
+    void restoreTrackingCheckpoint(const TrackingCheckpoint &checkpoint);
 
 signals:
     void sendStatus(const Status &status);
@@ -70,7 +77,11 @@ public slots:
     void setScaling(double scaling);
     void handleRefereePacket(const QByteArray &data, qint64 time, QString sender);
     void handleVisionPacket(const QByteArray &data, qint64 time, QString sender);
+    void handleVisionDatagrams(const QList<Datagram> &packets);
     void handleSimulatorExtraVision(const QByteArray &data);
+    // in-process variants without a serialization roundtrip
+    void handleVisionPackets(const QList<SSL_WrapperPacket> &packets, qint64 time, QString sender);
+    void handleSimulatorState(const world::SimulatorState &state);
     void handleMixedTeamInfo(const QByteArray &data, qint64 time);
     void handleRadioResponses(const QList<robot::RadioResponse> &responses);
     void handleCommand(const Command &command);
@@ -101,6 +112,7 @@ private:
     void clearExtraData();
     void injectRawWorldState(Status &status);
     void clearRawWorldState();
+    void handleVisionWrapper(const SSL_WrapperPacket &wrapper, qint64 time, const QString &sender);
     void injectUserControl(Status &status, bool isBlue);
     Status assembleStatus(qint64 time, bool resetRaw);
     void injectAndClearDebugValues(qint64 currentTime, Status &status);
@@ -121,7 +133,7 @@ private:
     std::unique_ptr<Tracker> m_speedTracker;
     std::unique_ptr<Tracker> m_simpleTracker;
     QList<robot::RadioResponse> m_responses;
-    QList<QByteArray> m_extraVision;
+    QList<world::SimulatorState> m_extraVision;
     /*! \brief Pair of SSL_WrapperPacket and the time it was received. */
     std::vector<std::pair<SSL_WrapperPacket, qint64>> m_visionWrapperPackets;
     ssl::TeamPlan m_mixedTeamInfo;
@@ -142,6 +154,9 @@ private:
 
     bool m_transceiverEnabled;
 
+    // allocation totals at the previous tick
+    AllocationProfiler::Totals m_lastAllocations;
+
     world::DivisionDimensions m_divisionDimensions;
 };
 
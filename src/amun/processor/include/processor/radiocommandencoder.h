@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef RADIOCOMMANDENCODER_H
+#define RADIOCOMMANDENCODER_H
+
+#include "protobuf/robot.pb.h"
+#include <QtGlobal>
+#include <cstddef>
+
+// converts robot commands to the over the air format of the robot firmware
+// the payload is written to a caller provided buffer of at least MAX_PAYLOAD_SIZE bytes,
+// the functions return the number of bytes written
+class RadioCommandEncoder
+{
+public:
+    // maximum payload of a nrf24 packet
+    static constexpr std::size_t MAX_PAYLOAD_SIZE = 32;
+
+    static std::size_t encode2014(const robot::Command &command, int id, bool charge, quint8 packetCounter, quint8 irParam, char *out);
+    static std::size_t encodeSync2014(qint64 processingDelay, quint8 packetCounter, char *out);
+    static std::size_t encodePasta(const robot::Command &command, int id, bool charge, quint8 packetCounter, quint8 irParam, qint64 processingDelay, char *out);
+
+    static std::size_t expectedResponseSize2014();
+    static std::size_t expectedResponseSizePasta();
+};
+
+#endif // RADIOCOMMANDENCODER_H
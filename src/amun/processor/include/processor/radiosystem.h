@@ -53,6 +53,7 @@ private:
 public:
     explicit RadioSystem(const Timer *timer);
     ~RadioSystem();
+    void setTimingReportEnabled(bool enabled);
 
 signals:
     void sendStatus(const Status &status);
@@ -93,7 +94,8 @@ private:
     bool m_charge;
     QMap<QPair<Radio::Generation, uint>, DroppedFrameCounter> m_droppedFrames;
     QMap<QPair<Radio::Generation, uint>, uint> m_ir_param;
-    QMap<quint8, qint64> m_frameTimes;
+    // send time of each packet counter value, -1 if not used yet
+    std::array<qint64, 256> m_frameTimes;
 
     quint8 m_packetCounter;
     QTimer *m_timeoutTimer;
@@ -105,6 +107,7 @@ private:
     QList<robot::RadioCommand> m_commands;
     qint64 m_processingStart;
     int m_droppedCommands;
+    bool m_reportTiming;
 
     /** TransceiverLayer for two generations.
      *
@@ -35,12 +35,25 @@ class Referee : public QObject
 {
     Q_OBJECT
 
+public:
+    struct Checkpoint
+    {
+        amun::GameState gameState;
+        world::Ball ball;
+        quint32 counter;
+        bool flipped;
+        std::optional<SSL_Referee::Command> lastCommand;
+        std::string sourceIdentifier;
+    };
+
 public:
     explicit Referee();
 
 public:
     const amun::GameState& gameState() const { return m_gameState; }
     bool getFlipped() const { return m_flipped; }
+    Checkpoint checkpoint() const;
+    void restore(const Checkpoint &checkpoint);
 
 public slots:
     void handlePacket(const QByteArray &data, const QString &sender);
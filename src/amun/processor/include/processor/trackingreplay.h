@@ -23,6 +23,8 @@
 
 #include <QObject>
 #include <QCache>
+#include <QMap>
+#include <memory>
 
 #include "protobuf/ssl_referee.h"
 #include "protobuf/status.h"
@@ -54,6 +56,10 @@ private:
     // the tracking can not go back in time, therefore add a cache for already processed packages
     QCache<QString, Status> m_statusCache;
     QString m_currentPacketString;
+
+    // the tracking state in regular intervals, avoids restarting the tracking when seeking backwards.
+    // Limited in count, the ones farthest from the current position are dropped first
+    QMap<qint64, std::shared_ptr<const Processor::TrackingCheckpoint>> m_checkpoints;
 };
 
 #endif // TRACKINGREPLAY_H
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef TRANSCEIVERPACKET_H
+#define TRANSCEIVERPACKET_H
+
+#include <QtGlobal>
+#include <array>
+#include <cstddef>
+
+namespace Radio { class Address; }
+
+// usb transfer to a transceiver, built in place in a fixed buffer which is reused every cycle
+class TransceiverPacket
+{
+public:
+    // fits the commands for a full team including sync, ping and status requests
+    static constexpr std::size_t CAPACITY = 2048;
+
+    void clear() { m_size = 0; }
+    const char *data() const { return m_data.data(); }
+    std::size_t size() const { return m_size; }
+
+    // all functions return false and leave the packet unchanged if it is full
+    bool addSendCommand(const Radio::Address &target, std::size_t expectedResponseSize, const char *data, std::size_t len);
+    bool addPing(qint64 time);
+    bool addStatusRequest();
+
+private:
+    bool append(std::size_t length, const void *first, std::size_t firstLength,
+                const void *second = nullptr, std::size_t secondLength = 0,
+                const void *third = nullptr, std::size_t thirdLength = 0);
+
+private:
+    std::array<char, CAPACITY> m_data;
+    std::size_t m_size = 0;
+};
+
+#endif // TRANSCEIVERPACKET_H
@@ -25,7 +25,9 @@
 #include "protobuf/ssl_wrapper.pb.h"
 #include "protobuf/world.pb.h"
 #include "referee.h"
+#include "core/allocationprofiler.h"
 #include "core/timer.h"
+#include "core/tracing.h"
 #include "core/configuration.h"
 #include "gamecontroller/internalgamecontroller.h"
 #include "tracking/tracker.h"
@@ -38,6 +40,16 @@
 #include <google/protobuf/text_format.h>
 #include <optional>
 
+struct Processor::TrackingCheckpoint
+{
+    std::shared_ptr<const Tracker::Checkpoint> tracker;
+    std::shared_ptr<const Tracker::Checkpoint> speedTracker;
+    std::shared_ptr<const Tracker::Checkpoint> simpleTracker;
+    WorldParameters::Checkpoint worldParameters;
+    Referee::Checkpoint referee;
+    bool lastFlipped;
+};
+
 struct Processor::Robot
 {
     explicit Robot(const robot::Specs &specs) :
@@ -310,6 +322,7 @@ void Processor::process(qint64 overwriteTime)
     // We have these three different times to consider for each processing step.
     // currentTime is the time we have *now*, which is used to compute the world state in this point in time.
     const qint64 currentTime = overwriteTime == -1 ? m_timer->currentTime() : overwriteTime;
+    TraceSpan span("Processor::process", currentTime);
     // controllerTime is supposed to be the time at which the command we will send out in this call arrives
     // at the robot and the robot can actually act on it
     const qint64 controllerTime = currentTime + m_trackingRadioCommandDelay;
@@ -319,9 +332,12 @@ void Processor::process(qint64 overwriteTime)
     const qint64 nextProcessControllerTime = currentTime + tickDuration + m_trackingRadioCommandDelay;
 
     // run tracking
-    m_tracker->process(currentTime);
-    m_speedTracker->process(currentTime);
-    m_simpleTracker->process(currentTime);
+    {
+        TraceSpan trackingSpan("Processor::tracking", currentTime);
+        m_tracker->process(currentTime);
+        m_speedTracker->process(currentTime);
+        m_simpleTracker->process(currentTime);
+    }
 
     Status status = assembleStatus(currentTime, false);
     injectAndClearDebugValues(currentTime, status);
@@ -364,6 +380,7 @@ void Processor::process(qint64 overwriteTime)
     QList<robot::RadioCommand> radio_commands_prio;
 
     {
+        TraceSpan controllerSpan("Processor::controller", currentTime);
         QList<robot::RadioCommand> radio_commands;
         // compute world state and speed for the time at which the command reaches the robot
         world::State commandWorldState, radioWorldState;
@@ -409,6 +426,14 @@ void Processor::process(qint64 overwriteTime)
 
     // publish world state and timing information
     status->mutable_timing()->set_controller((Timer::systemTime() - controller_start) * 1E-9f);
+    if (AllocationProfiler::isEnabled()) {
+        const AllocationProfiler::Totals allocations = AllocationProfiler::totals();
+        if (m_lastAllocations.allocations != 0) {
+            status->mutable_timing()->set_allocations(allocations.allocations - m_lastAllocations.allocations);
+            status->mutable_timing()->set_allocated_bytes(allocations.bytes - m_lastAllocations.bytes);
+        }
+        m_lastAllocations = allocations;
+    }
     emit sendStatus(status);
 
     if (m_transceiverEnabled) {
@@ -453,8 +478,8 @@ void Processor::injectRawWorldState(Status &status)
 {
     world::State* worldState = status->mutable_world_state();
 
-    for(const QByteArray& data : m_extraVision) {
-        worldState->add_reality()->ParseFromArray(data.data(), data.size());
+    for(const world::SimulatorState& state : m_extraVision) {
+        worldState->add_reality()->CopyFrom(state);
     }
 
     worldState->set_has_vision_data(!m_visionWrapperPackets.empty());
@@ -555,7 +580,25 @@ void Processor::handleVisionPacket(const QByteArray &data, qint64 time, QString
     if (!wrapper.ParseFromArray(data.data(), data.size())) {
         return;
     }
+    handleVisionWrapper(wrapper, time, sender);
+}
+
+void Processor::handleVisionDatagrams(const QList<Datagram> &packets)
+{
+    for (const Datagram &packet : packets) {
+        handleVisionPacket(packet.data, packet.time, packet.sender);
+    }
+}
+
+void Processor::handleVisionPackets(const QList<SSL_WrapperPacket> &packets, qint64 time, QString sender)
+{
+    for (const SSL_WrapperPacket &wrapper : packets) {
+        handleVisionWrapper(wrapper, time, sender);
+    }
+}
 
+void Processor::handleVisionWrapper(const SSL_WrapperPacket &wrapper, qint64 time, const QString &sender)
+{
     m_visionWrapperPackets.emplace_back(wrapper, time);
 
     if (wrapper.has_geometry()) {
@@ -573,7 +616,15 @@ void Processor::handleVisionPacket(const QByteArray &data, qint64 time, QString
 
 void Processor::handleSimulatorExtraVision(const QByteArray &data)
 {
-    m_extraVision.append(data);
+    world::SimulatorState state;
+    if (state.ParseFromArray(data.data(), data.size())) {
+        m_extraVision.append(state);
+    }
+}
+
+void Processor::handleSimulatorState(const world::SimulatorState &state)
+{
+    m_extraVision.append(state);
 }
 
 void Processor::handleMixedTeamInfo(const QByteArray &data, qint64)
@@ -679,6 +730,29 @@ void Processor::resetTracking()
     m_worldParameters->reset();
 }
 
+std::shared_ptr<const Processor::TrackingCheckpoint> Processor::trackingCheckpoint() const
+{
+    auto checkpoint = std::make_shared<TrackingCheckpoint>();
+    checkpoint->tracker = m_tracker->checkpoint();
+    checkpoint->speedTracker = m_speedTracker->checkpoint();
+    checkpoint->simpleTracker = m_simpleTracker->checkpoint();
+    checkpoint->worldParameters = m_worldParameters->checkpoint();
+    checkpoint->referee = m_referee->checkpoint();
+    checkpoint->lastFlipped = m_lastFlipped;
+    return checkpoint;
+}
+
+void Processor::restoreTrackingCheckpoint(const TrackingCheckpoint &checkpoint)
+{
+    m_tracker->restore(*checkpoint.tracker);
+    m_speedTracker->restore(*checkpoint.speedTracker);
+    m_simpleTracker->restore(*checkpoint.simpleTracker);
+    m_worldParameters->restore(checkpoint.worldParameters);
+    m_referee->restore(checkpoint.referee);
+    m_lastFlipped = checkpoint.lastFlipped;
+    m_visionWrapperPackets.clear();
+}
+
 void Processor::handleControl(Team &team, const amun::CommandControl &control)
 {
     // clear all previously set commands
@@ -0,0 +1,207 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "radiocommandencoder.h"
+#include "firmware-interface/radiocommand.h"
+#include "firmware-interface/radiocommand2014.h"
+#include "firmware-interface/radiocommandpasta.h"
+#include <QtGlobal>
+#include <cstring>
+#include <numbers>
+
+static_assert(sizeof(RadioCommand2014) <= RadioCommandEncoder::MAX_PAYLOAD_SIZE, "Radio command 2014 does not fit into the payload");
+static_assert(sizeof(RadioCommandPasta) <= RadioCommandEncoder::MAX_PAYLOAD_SIZE, "Radio command pasta does not fit into the payload");
+static_assert(sizeof(RadioSync2014) <= RadioCommandEncoder::MAX_PAYLOAD_SIZE, "Radio sync 2014 does not fit into the payload");
+
+std::size_t RadioCommandEncoder::encode2014(const robot::Command &command, int id, bool charge, quint8 packetCounter, quint8 irParam, char *out)
+{
+    // copy command
+    RadioCommand2014 data;
+    data.charge = charge;
+    data.standby = command.standby();
+    data.counter = packetCounter;
+    data.dribbler = qBound<qint32>(-RADIOCOMMAND2014_DRIBBLER_MAX, command.dribbler() * RADIOCOMMAND2014_DRIBBLER_MAX, RADIOCOMMAND2014_DRIBBLER_MAX);
+    data.chip = command.kick_style() == robot::Command::Chip;
+    if (data.chip) {
+        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMAND2014_CHIP_MAX * RADIOCOMMAND2014_KICK_MAX, RADIOCOMMAND2014_KICK_MAX);
+    } else {
+        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMAND2014_LINEAR_MAX * RADIOCOMMAND2014_KICK_MAX, RADIOCOMMAND2014_KICK_MAX);
+    }
+    data.v_s = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.output0().v_s() * 1000.0f, RADIOCOMMAND2014_V_MAX);
+    data.v_f = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.output0().v_f() * 1000.0f, RADIOCOMMAND2014_V_MAX);
+    data.omega = qBound<qint32>(-RADIOCOMMAND2014_OMEGA_MAX, command.output0().omega() * 1000.0f, RADIOCOMMAND2014_OMEGA_MAX);
+
+    const int OMEGA_QUANTIZATION = 5;
+    const int V_QUANTIZATION = 2;
+    const float delta1_v_s = command.output1().v_s() - command.output0().v_s();
+    const float delta1_v_f = command.output1().v_f() - command.output0().v_f();
+    const float delta1_omega = command.output1().omega() - command.output0().omega();
+    data.delta1_v_s = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta1_v_s * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
+    data.delta1_v_f = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta1_v_f * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
+    data.delta1_omega = qBound<qint32>(-RADIOCOMMAND2014_DELTA_OMEGA_MAX, delta1_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMAND2014_DELTA_OMEGA_MAX);
+
+    const float delta2_v_s = command.output2().v_s() - command.output1().v_s();
+    const float delta2_v_f = command.output2().v_f() - command.output1().v_f();
+    // compensate for possible quantization errors
+    const float sent_delta1_omega = data.delta1_omega * (OMEGA_QUANTIZATION / 1000.0f);
+    const float omegaWithDelta1 = command.output0().omega() + sent_delta1_omega;
+    const float delta2_omega = command.output2().omega() - omegaWithDelta1;
+    data.delta2_v_s = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta2_v_s * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
+    data.delta2_v_f = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta2_v_f * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
+    data.delta2_omega = qBound<qint32>(-RADIOCOMMAND2014_DELTA_OMEGA_MAX, delta2_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMAND2014_DELTA_OMEGA_MAX);
+
+    data.id = id;
+    data.force_kick = command.force_kick();
+    data.ir_param = qBound<quint8>(0, irParam, 63);
+    data.eject_sdcard = command.eject_sdcard();
+    data.unused = 0;
+
+    if (command.has_cur_v_s()) {
+        data.cur_v_s = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.cur_v_s() * 1000.0f, RADIOCOMMAND2014_V_MAX);
+        data.cur_v_f = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.cur_v_f() * 1000.0f, RADIOCOMMAND2014_V_MAX);
+        data.cur_omega = qBound<qint32>(-RADIOCOMMAND2014_OMEGA_MAX, command.cur_omega() * 1000.0f, RADIOCOMMAND2014_OMEGA_MAX);
+    } else {
+        data.cur_v_s = RADIOCOMMAND2014_INVALID_SPEED;
+        data.cur_v_f = RADIOCOMMAND2014_INVALID_SPEED;
+        data.cur_omega = RADIOCOMMAND2014_INVALID_SPEED;
+    }
+
+    std::memcpy(out, &data, sizeof(data));
+    return sizeof(data);
+}
+
+std::size_t RadioCommandEncoder::encodeSync2014(qint64 processingDelay, quint8 packetCounter, char *out)
+{
+    // processing usually takes a few hundred microseconds, bound to 2ms to avoid outliers
+    processingDelay = qMin((qint64)2*1000*1000, processingDelay);
+
+    // times are in nanoseconds
+    qint64 US_TO_NS = 1000;
+    // just an estimate
+    qint64 usbTransferTime = 250 * US_TO_NS;
+    qint64 nrfRadioStartupTime = 130 * US_TO_NS;
+    int nrfPacketHeaderBits = 65;
+    int syncPacketPayloadBytes = sizeof(RadioSync2014);
+    int BITS_PER_BYTE = 8;
+    // transfer rate: 1MBit/s
+    int BIT_TRANSFER_TIME = 1 * US_TO_NS;
+    qint64 syncPacketTransmissionTime = (nrfPacketHeaderBits + BITS_PER_BYTE * syncPacketPayloadBytes) * BIT_TRANSFER_TIME;
+    qint64 syncPacketDelay = usbTransferTime + nrfRadioStartupTime + syncPacketTransmissionTime;
+
+    RadioSync2014 data;
+    data.counter = packetCounter;
+    data.time_offset = (processingDelay + syncPacketDelay) / 1000;
+
+    std::memcpy(out, &data, sizeof(data));
+    return sizeof(data);
+}
+
+std::size_t RadioCommandEncoder::encodePasta(const robot::Command &command, int id, bool charge, quint8 packetCounter, quint8 irParam, qint64 processingDelay, char *out)
+{
+    // copy command
+    RadioCommandPasta data;
+    data.charge = charge;
+    data.standby = command.standby();
+    data.counter = packetCounter;
+    data.dribbler = qBound<qint32>(-RADIOCOMMANDPASTA_DRIBBLER_MAX, command.dribbler() * RADIOCOMMANDPASTA_DRIBBLER_MAX, RADIOCOMMANDPASTA_DRIBBLER_MAX);
+    data.chip = command.kick_style() == robot::Command::Chip;
+    if (data.chip) {
+        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMANDPASTA_CHIP_MAX * RADIOCOMMANDPASTA_KICK_MAX, RADIOCOMMANDPASTA_KICK_MAX);
+    } else {
+        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMANDPASTA_LINEAR_MAX * RADIOCOMMANDPASTA_KICK_MAX, RADIOCOMMANDPASTA_KICK_MAX);
+    }
+    data.v_x = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.output0().v_x() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
+    data.v_y = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.output0().v_y() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
+    data.omega = qBound<qint32>(-RADIOCOMMANDPASTA_OMEGA_MAX, command.output0().omega() * 1000.0f, RADIOCOMMANDPASTA_OMEGA_MAX);
+
+    const int OMEGA_QUANTIZATION = 5;
+    const int V_QUANTIZATION = 2;
+    const float delta1_v_x = command.output1().v_x() - command.output0().v_x();
+    const float delta1_v_y = command.output1().v_y() - command.output0().v_y();
+    const float delta1_omega = command.output1().omega() - command.output0().omega();
+    data.delta1_v_x = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta1_v_x * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
+    data.delta1_v_y = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta1_v_y * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
+    data.delta1_omega = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_OMEGA_MAX, delta1_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMANDPASTA_DELTA_OMEGA_MAX);
+
+    const float delta2_v_x = command.output2().v_x() - command.output1().v_x();
+    const float delta2_v_y = command.output2().v_y() - command.output1().v_y();
+    // compensate for possible quantization errors
+    const float sent_delta1_omega = data.delta1_omega * (OMEGA_QUANTIZATION / 1000.0f);
+    const float omegaWithDelta1 = command.output0().omega() + sent_delta1_omega;
+    const float delta2_omega = command.output2().omega() - omegaWithDelta1;
+    data.delta2_v_x = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta2_v_x * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
+    data.delta2_v_y = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta2_v_y * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
+    data.delta2_omega = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_OMEGA_MAX, delta2_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMANDPASTA_DELTA_OMEGA_MAX);
+
+    data.id = id;
+    data.force_kick = command.force_kick();
+    data.ir_param = qBound<quint8>(0, irParam, 63);
+    data.eject_sdcard = command.eject_sdcard();
+    data.unused = 0;
+
+    if (command.has_cur_v_s()) {
+        data.cur_v_s = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.cur_v_s() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
+        data.cur_v_f = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.cur_v_f() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
+
+        float phi = command.cur_phi();
+        while (phi < -std::numbers::pi) {
+            phi += std::numbers::pi * 2;
+        }
+        while (phi >= std::numbers::pi) {
+            phi -= std::numbers::pi * 2;
+        }
+        data.cur_phi = qBound<qint32>(-RADIOCOMMANDPASTA_PHI_MAX, phi * RADIOCOMMANDPASTA_PHI_MAX / std::numbers::pi, RADIOCOMMANDPASTA_PHI_MAX);
+    } else {
+        data.cur_v_s = RADIOCOMMANDPASTA_INVALID_SPEED;
+        data.cur_v_f = RADIOCOMMANDPASTA_INVALID_SPEED;
+        data.cur_phi = RADIOCOMMANDPASTA_INVALID_SPEED;
+    }
+
+    // processing usually takes a few hundred microseconds, bound to 2ms to avoid outliers
+    processingDelay = qMin((qint64)2*1000*1000, processingDelay);
+
+    // times are in nanoseconds
+    constexpr qint64 US_TO_NS = 1000;
+    // just an estimate
+    constexpr qint64 usbTransferTime = 250 * US_TO_NS;
+    constexpr qint64 nrfRadioStartupTime = 130 * US_TO_NS;
+    constexpr int nrfPacketHeaderBits = 65;
+    // TODO check if this even makes sense anymore since we don't directly send the sync packet and instead flush after preparing all robot commands
+    constexpr int syncPacketPayloadBytes = sizeof(RadioSync2014);
+    constexpr int BITS_PER_BYTE = 8;
+    // transfer rate: 1MBit/s
+    constexpr int BIT_TRANSFER_TIME = 1 * US_TO_NS;
+    qint64 syncPacketTransmissionTime = (nrfPacketHeaderBits + BITS_PER_BYTE * syncPacketPayloadBytes) * BIT_TRANSFER_TIME;
+    qint64 syncPacketDelay = usbTransferTime + nrfRadioStartupTime + syncPacketTransmissionTime;
+    data.counter = packetCounter;
+    data.time_offset = (processingDelay + syncPacketDelay) / 1000;
+
+    std::memcpy(out, &data, sizeof(data));
+    return sizeof(data);
+}
+
+std::size_t RadioCommandEncoder::expectedResponseSize2014()
+{
+    return sizeof(RadioResponseHeader) + sizeof(RadioResponse2014);
+}
+
+std::size_t RadioCommandEncoder::expectedResponseSizePasta()
+{
+    return sizeof(RadioResponseHeader) + sizeof(RadioResponsePasta);
+}
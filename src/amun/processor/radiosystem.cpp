@@ -20,9 +20,11 @@
  ***************************************************************************/
 
 #include "core/timer.h"
+#include "core/tracing.h"
 #include "firmware-interface/radiocommand.h"
 #include "firmware-interface/radiocommand2014.h"
 #include "firmware-interface/radiocommandpasta.h"
+#include "radiocommandencoder.h"
 #include "radiosystem.h"
 #include "transceiverlayer.h"
 #include <QByteArray>
@@ -30,7 +32,6 @@
 #include <QTimer>
 #include <algorithm>
 #include <array>
-#include <numbers>
 
 #ifdef USB_FOUND
 #include "transceiver2015.h"
@@ -66,12 +67,15 @@ RadioSystem::RadioSystem(const Timer *timer) :
     m_onlyRestartAfterTimestamp(0),
     m_timer(timer),
     m_droppedCommands(0),
+    m_reportTiming(false),
 #ifdef USB_FOUND
     m_context(new USBThread())
 #else
     m_context(nullptr)
 #endif // USB_FOUND
 {
+    m_frameTimes.fill(-1);
+
     m_timeoutTimer = new QTimer(this);
     m_timeoutTimer->setSingleShot(true);
     connect(m_timeoutTimer, &QTimer::timeout, this, &RadioSystem::timeout);
@@ -103,14 +107,27 @@ void RadioSystem::handleRadioCommands(const QList<robot::RadioCommand> &commands
 
 void RadioSystem::process()
 {
-    Status status(new amun::Status);
+    TraceSpan span("RadioSystem::sendCommand", m_processingStart);
     const qint64 transceiver_start = Timer::systemTime();
 
     // charging the condensator can be enabled / disable separately
     sendCommand(m_commands, m_charge, m_processingStart);
 
-    status->mutable_timing()->set_transceiver((Timer::systemTime() - transceiver_start) * 1E-9f);
-    emit sendStatus(status);
+    if (m_reportTiming) {
+        Status status(new amun::Status);
+        status->mutable_timing()->set_transceiver((Timer::systemTime() - transceiver_start) * 1E-9f);
+        emit sendStatus(status);
+    }
+}
+
+/*!
+ * \brief Enable sending the time needed to send the commands as status
+ *
+ * This is disabled by default to avoid allocating a status every cycle.
+ */
+void RadioSystem::setTimingReportEnabled(bool enabled)
+{
+    m_reportTiming = enabled;
 }
 
 void RadioSystem::handleCommand(const Command &command)
@@ -363,7 +380,7 @@ void RadioSystem::handleResponsePacket(QList<robot::RadioResponse> &responses, c
             r.set_ball_detected(packet->ball_detected);
             r.set_cap_charged(packet->cap_charged);
         }
-        if (m_frameTimes.contains(packet->counter)) {
+        if (m_frameTimes[packet->counter] >= 0) {
             r.set_radio_rtt((time - m_frameTimes[packet->counter]) * 1E-9f);
         }
         responses.append(r);
@@ -412,7 +429,7 @@ void RadioSystem::handleResponsePacket(QList<robot::RadioResponse> &responses, c
             r.set_ball_detected(packet->ball_detected);
             r.set_cap_charged(packet->cap_charged);
         }
-        if (m_frameTimes.contains(packet->counter)) {
+        if (m_frameTimes[packet->counter] >= 0) {
             r.set_radio_rtt((time - m_frameTimes[packet->counter]) * 1E-9f);
         }
         responses.append(r);
@@ -421,86 +438,22 @@ void RadioSystem::handleResponsePacket(QList<robot::RadioResponse> &responses, c
 
 void RadioSystem::addRobot2014Command(int id, const robot::Command &command, bool charge, quint8 packetCounter)
 {
-    // copy command
-    RadioCommand2014 data;
-    data.charge = charge;
-    data.standby = command.standby();
-    data.counter = packetCounter;
-    data.dribbler = qBound<qint32>(-RADIOCOMMAND2014_DRIBBLER_MAX, command.dribbler() * RADIOCOMMAND2014_DRIBBLER_MAX, RADIOCOMMAND2014_DRIBBLER_MAX);
-    data.chip = command.kick_style() == robot::Command::Chip;
-    if (data.chip) {
-        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMAND2014_CHIP_MAX * RADIOCOMMAND2014_KICK_MAX, RADIOCOMMAND2014_KICK_MAX);
-    } else {
-        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMAND2014_LINEAR_MAX * RADIOCOMMAND2014_KICK_MAX, RADIOCOMMAND2014_KICK_MAX);
-    }
-    data.v_s = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.output0().v_s() * 1000.0f, RADIOCOMMAND2014_V_MAX);
-    data.v_f = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.output0().v_f() * 1000.0f, RADIOCOMMAND2014_V_MAX);
-    data.omega = qBound<qint32>(-RADIOCOMMAND2014_OMEGA_MAX, command.output0().omega() * 1000.0f, RADIOCOMMAND2014_OMEGA_MAX);
-
-    const int OMEGA_QUANTIZATION = 5;
-    const int V_QUANTIZATION = 2;
-    const float delta1_v_s = command.output1().v_s() - command.output0().v_s();
-    const float delta1_v_f = command.output1().v_f() - command.output0().v_f();
-    const float delta1_omega = command.output1().omega() - command.output0().omega();
-    data.delta1_v_s = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta1_v_s * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
-    data.delta1_v_f = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta1_v_f * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
-    data.delta1_omega = qBound<qint32>(-RADIOCOMMAND2014_DELTA_OMEGA_MAX, delta1_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMAND2014_DELTA_OMEGA_MAX);
-
-    const float delta2_v_s = command.output2().v_s() - command.output1().v_s();
-    const float delta2_v_f = command.output2().v_f() - command.output1().v_f();
-    // compensate for possible quantization errors
-    const float sent_delta1_omega = data.delta1_omega * (OMEGA_QUANTIZATION / 1000.0f);
-    const float omegaWithDelta1 = command.output0().omega() + sent_delta1_omega;
-    const float delta2_omega = command.output2().omega() - omegaWithDelta1;
-    data.delta2_v_s = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta2_v_s * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
-    data.delta2_v_f = qBound<qint32>(-RADIOCOMMAND2014_DELTA_V_MAX, delta2_v_f * 1000.0f / V_QUANTIZATION, RADIOCOMMAND2014_DELTA_V_MAX);
-    data.delta2_omega = qBound<qint32>(-RADIOCOMMAND2014_DELTA_OMEGA_MAX, delta2_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMAND2014_DELTA_OMEGA_MAX);
-
-    data.id = id;
-    data.force_kick = command.force_kick();
-    data.ir_param = qBound<quint8>(0, m_ir_param[qMakePair(Generation::Gen2014, id)], 63);
-    data.eject_sdcard = command.eject_sdcard();
-    data.unused = 0;
-
-    if (command.has_cur_v_s()) {
-        data.cur_v_s = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.cur_v_s() * 1000.0f, RADIOCOMMAND2014_V_MAX);
-        data.cur_v_f = qBound<qint32>(-RADIOCOMMAND2014_V_MAX, command.cur_v_f() * 1000.0f, RADIOCOMMAND2014_V_MAX);
-        data.cur_omega = qBound<qint32>(-RADIOCOMMAND2014_OMEGA_MAX, command.cur_omega() * 1000.0f, RADIOCOMMAND2014_OMEGA_MAX);
-    } else {
-        data.cur_v_s = RADIOCOMMAND2014_INVALID_SPEED;
-        data.cur_v_f = RADIOCOMMAND2014_INVALID_SPEED;
-        data.cur_omega = RADIOCOMMAND2014_INVALID_SPEED;
-    }
+    char payload[RadioCommandEncoder::MAX_PAYLOAD_SIZE];
+    const quint8 irParam = m_ir_param.value(qMakePair(Generation::Gen2014, uint(id)));
+    const std::size_t size = RadioCommandEncoder::encode2014(command, id, charge, packetCounter, irParam, payload);
 
     for (const auto& transceiver : m_transceivers[IndexGen2014]) {
         transceiver->addSendCommand(
             Address { Unicast, Generation::Gen2014, id },
-            sizeof(RadioResponseHeader) + sizeof(RadioResponse2014),
-            reinterpret_cast<const char *>(&data), sizeof(data));
+            RadioCommandEncoder::expectedResponseSize2014(),
+            payload, size);
     }
 }
 
 void RadioSystem::addRobot2014Sync(qint64 processingDelay, quint8 packetCounter)
 {
-    // processing usually takes a few hundred microseconds, bound to 2ms to avoid outliers
-    processingDelay = qMin((qint64)2*1000*1000, processingDelay);
-
-    // times are in nanoseconds
-    qint64 US_TO_NS = 1000;
-    // just an estimate
-    qint64 usbTransferTime = 250 * US_TO_NS;
-    qint64 nrfRadioStartupTime = 130 * US_TO_NS;
-    int nrfPacketHeaderBits = 65;
-    int syncPacketPayloadBytes = sizeof(RadioSync2014);
-    int BITS_PER_BYTE = 8;
-    // transfer rate: 1MBit/s
-    int BIT_TRANSFER_TIME = 1 * US_TO_NS;
-    qint64 syncPacketTransmissionTime = (nrfPacketHeaderBits + BITS_PER_BYTE * syncPacketPayloadBytes) * BIT_TRANSFER_TIME;
-    qint64 syncPacketDelay = usbTransferTime + nrfRadioStartupTime + syncPacketTransmissionTime;
-
-    RadioSync2014 data;
-    data.counter = packetCounter;
-    data.time_offset = (processingDelay + syncPacketDelay) / 1000;
+    char payload[RadioCommandEncoder::MAX_PAYLOAD_SIZE];
+    const std::size_t size = RadioCommandEncoder::encodeSync2014(processingDelay, packetCounter, payload);
 
     for (const auto& transceiver : m_transceivers[IndexGen2014]) {
         transceiver->addSendCommand(
@@ -510,95 +463,21 @@ void RadioSystem::addRobot2014Sync(qint64 processingDelay, quint8 packetCounter)
             // receive their command packet if it immediatelly follows the sync
             // packet adding the delay fixes the problem reliably
             1,
-            reinterpret_cast<const char *>(&data), sizeof(data));
+            payload, size);
     }
 }
 
 void RadioSystem::addRobotPastaCommand(int id, const robot::Command &command, bool charge, quint8 packetCounter, qint64 processingDelay)
 {
-    // copy command
-    RadioCommandPasta data;
-    data.charge = charge;
-    data.standby = command.standby();
-    data.counter = packetCounter;
-    data.dribbler = qBound<qint32>(-RADIOCOMMANDPASTA_DRIBBLER_MAX, command.dribbler() * RADIOCOMMANDPASTA_DRIBBLER_MAX, RADIOCOMMANDPASTA_DRIBBLER_MAX);
-    data.chip = command.kick_style() == robot::Command::Chip;
-    if (data.chip) {
-        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMANDPASTA_CHIP_MAX * RADIOCOMMANDPASTA_KICK_MAX, RADIOCOMMANDPASTA_KICK_MAX);
-    } else {
-        data.shot_power = qMin<quint32>(command.kick_power() / RADIOCOMMANDPASTA_LINEAR_MAX * RADIOCOMMANDPASTA_KICK_MAX, RADIOCOMMANDPASTA_KICK_MAX);
-    }
-    data.v_x = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.output0().v_x() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
-    data.v_y = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.output0().v_y() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
-    data.omega = qBound<qint32>(-RADIOCOMMANDPASTA_OMEGA_MAX, command.output0().omega() * 1000.0f, RADIOCOMMANDPASTA_OMEGA_MAX);
-
-    const int OMEGA_QUANTIZATION = 5;
-    const int V_QUANTIZATION = 2;
-    const float delta1_v_x = command.output1().v_x() - command.output0().v_x();
-    const float delta1_v_y = command.output1().v_y() - command.output0().v_y();
-    const float delta1_omega = command.output1().omega() - command.output0().omega();
-    data.delta1_v_x = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta1_v_x * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
-    data.delta1_v_y = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta1_v_y * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
-    data.delta1_omega = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_OMEGA_MAX, delta1_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMANDPASTA_DELTA_OMEGA_MAX);
-
-    const float delta2_v_x = command.output2().v_x() - command.output1().v_x();
-    const float delta2_v_y = command.output2().v_y() - command.output1().v_y();
-    // compensate for possible quantization errors
-    const float sent_delta1_omega = data.delta1_omega * (OMEGA_QUANTIZATION / 1000.0f);
-    const float omegaWithDelta1 = command.output0().omega() + sent_delta1_omega;
-    const float delta2_omega = command.output2().omega() - omegaWithDelta1;
-    data.delta2_v_x = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta2_v_x * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
-    data.delta2_v_y = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_V_MAX, delta2_v_y * 1000.0f / V_QUANTIZATION, RADIOCOMMANDPASTA_DELTA_V_MAX);
-    data.delta2_omega = qBound<qint32>(-RADIOCOMMANDPASTA_DELTA_OMEGA_MAX, delta2_omega * (1000.0f / OMEGA_QUANTIZATION), RADIOCOMMANDPASTA_DELTA_OMEGA_MAX);
-
-    data.id = id;
-    data.force_kick = command.force_kick();
-    data.ir_param = qBound<quint8>(0, m_ir_param[qMakePair(Radio::Generation::GenPasta, id)], 63);
-    data.eject_sdcard = command.eject_sdcard();
-    data.unused = 0;
-
-    if (command.has_cur_v_s()) {
-        data.cur_v_s = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.cur_v_s() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
-        data.cur_v_f = qBound<qint32>(-RADIOCOMMANDPASTA_V_MAX, command.cur_v_f() * 1000.0f, RADIOCOMMANDPASTA_V_MAX);
-
-        float phi = command.cur_phi();
-        while (phi < -std::numbers::pi) {
-            phi += std::numbers::pi * 2;
-        }
-        while (phi >= std::numbers::pi) {
-            phi -= std::numbers::pi * 2;
-        }
-        data.cur_phi = qBound<qint32>(-RADIOCOMMANDPASTA_PHI_MAX, phi * RADIOCOMMANDPASTA_PHI_MAX / std::numbers::pi, RADIOCOMMANDPASTA_PHI_MAX);
-    } else {
-        data.cur_v_s = RADIOCOMMANDPASTA_INVALID_SPEED;
-        data.cur_v_f = RADIOCOMMANDPASTA_INVALID_SPEED;
-        data.cur_phi = RADIOCOMMANDPASTA_INVALID_SPEED;
-    }
-
-    // processing usually takes a few hundred microseconds, bound to 2ms to avoid outliers
-    processingDelay = qMin((qint64)2*1000*1000, processingDelay);
-
-    // times are in nanoseconds
-    constexpr qint64 US_TO_NS = 1000;
-    // just an estimate
-    constexpr qint64 usbTransferTime = 250 * US_TO_NS;
-    constexpr qint64 nrfRadioStartupTime = 130 * US_TO_NS;
-    constexpr int nrfPacketHeaderBits = 65;
-    // TODO check if this even makes sense anymore since we don't directly send the sync packet and instead flush after preparing all robot commands
-    constexpr int syncPacketPayloadBytes = sizeof(RadioSync2014);
-    constexpr int BITS_PER_BYTE = 8;
-    // transfer rate: 1MBit/s
-    constexpr int BIT_TRANSFER_TIME = 1 * US_TO_NS;
-    qint64 syncPacketTransmissionTime = (nrfPacketHeaderBits + BITS_PER_BYTE * syncPacketPayloadBytes) * BIT_TRANSFER_TIME;
-    qint64 syncPacketDelay = usbTransferTime + nrfRadioStartupTime + syncPacketTransmissionTime;
-    data.counter = packetCounter;
-    data.time_offset = (processingDelay + syncPacketDelay) / 1000;
+    char payload[RadioCommandEncoder::MAX_PAYLOAD_SIZE];
+    const quint8 irParam = m_ir_param.value(qMakePair(Generation::GenPasta, uint(id)));
+    const std::size_t size = RadioCommandEncoder::encodePasta(command, id, charge, packetCounter, irParam, processingDelay, payload);
 
     for (const auto& transceiver : m_transceivers[IndexGenPasta]) {
         transceiver->addSendCommand(
             Address { Unicast, Generation::GenPasta, id },
-            sizeof(RadioResponseHeader) + sizeof(RadioResponsePasta),
-            reinterpret_cast<const char *>(&data), sizeof(data));
+            RadioCommandEncoder::expectedResponseSizePasta(),
+            payload, size);
     }
 }
 
@@ -608,12 +487,12 @@ void RadioSystem::sendCommand(const QList<robot::RadioCommand> &commands, bool c
         return;
     }
 
-    typedef QList<robot::RadioCommand> RobotList;
-
-    QMap<Radio::Generation, RobotList> generations;
-    foreach (const robot::RadioCommand &robot, commands) {
-        // group by generation
-        generations[uintToGeneration(robot.generation())].append(robot);
+    bool hasRobot2014Commands = false;
+    for (const robot::RadioCommand &robot : commands) {
+        if (uintToGeneration(robot.generation()) == Radio::Generation::Gen2014) {
+            hasRobot2014Commands = true;
+            break;
+        }
     }
 
     m_packetCounter++;
@@ -629,20 +508,19 @@ void RadioSystem::sendCommand(const QList<robot::RadioCommand> &commands, bool c
 
     const qint64 completionTime = m_timer->currentTime();
     const qint64 syncTime = processingStart - completionTime;
-    bool hasRobot2014Commands = generations.contains(Radio::Generation::Gen2014);
     if (hasRobot2014Commands) {
-        const qint64 completionTime = m_timer->currentTime();
         addRobot2014Sync(syncTime, m_packetCounter);
     }
 
-    QMapIterator<Radio::Generation, RobotList> it(generations);
-    while (it.hasNext()) {
-        it.next();
-
-        foreach (const robot::RadioCommand &radio_command, it.value()) {
-            if (it.key() == Radio::Generation::Gen2014) {
+    // the commands are encoded grouped by generation, without copying them
+    for (const Radio::Generation generation : {Radio::Generation::Gen2014, Radio::Generation::GenPasta}) {
+        for (const robot::RadioCommand &radio_command : commands) {
+            if (uintToGeneration(radio_command.generation()) != generation) {
+                continue;
+            }
+            if (generation == Radio::Generation::Gen2014) {
                 addRobot2014Command(radio_command.id(), radio_command.command(), charge, m_packetCounter);
-            } else if (it.key() == Radio::Generation::GenPasta) {
+            } else if (generation == Radio::Generation::GenPasta) {
                 addRobotPastaCommand(radio_command.id(), radio_command.command(), charge, m_packetCounter, syncTime);
             }
         }
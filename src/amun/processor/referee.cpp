@@ -122,6 +122,36 @@ void Referee::handlePacket(const QByteArray &data, const QString &sender)
     }
 }
 
+/*!
+ * \brief Copy the complete referee state
+ * \return Checkpoint that can be passed to \ref restore
+ */
+Referee::Checkpoint Referee::checkpoint() const
+{
+    Checkpoint checkpoint;
+    checkpoint.gameState.CopyFrom(m_gameState);
+    checkpoint.ball.CopyFrom(m_ball);
+    checkpoint.counter = m_counter;
+    checkpoint.flipped = m_flipped;
+    checkpoint.lastCommand = m_lastCommand;
+    checkpoint.sourceIdentifier = m_sourceIdentifier;
+    return checkpoint;
+}
+
+/*!
+ * \brief Restore a referee state previously created by \ref checkpoint
+ * \param checkpoint The state to restore
+ */
+void Referee::restore(const Checkpoint &checkpoint)
+{
+    m_gameState.CopyFrom(checkpoint.gameState);
+    m_ball.CopyFrom(checkpoint.ball);
+    m_counter = checkpoint.counter;
+    m_flipped = checkpoint.flipped;
+    m_lastCommand = checkpoint.lastCommand;
+    m_sourceIdentifier = checkpoint.sourceIdentifier;
+}
+
 void Referee::setFlipped(bool flipped)
 {
     m_flipped = flipped;
@@ -56,6 +56,17 @@ BallTracker::BallTracker(const BallTracker& previousFilter, qint32 primaryCamera
     m_groundFilter->moveToCamera(primaryCamera);
 }
 
+BallTracker *BallTracker::copy() const
+{
+    BallTracker *filter = new BallTracker(*this, m_primaryCamera);
+    filter->m_lastPrimaryTime = m_lastPrimaryTime;
+    filter->m_frameCounter = m_frameCounter;
+    filter->m_visionFrames = m_visionFrames;
+    filter->m_rawMeasurements = m_rawMeasurements;
+    filter->m_cachedDistToCamera = m_cachedDistToCamera;
+    return filter;
+}
+
 BallTracker::~BallTracker()
 {
     delete m_flyFilter;
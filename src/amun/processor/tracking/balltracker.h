@@ -40,6 +40,8 @@ public:
     ~BallTracker() override;
     BallTracker(const BallTracker&) = delete;
     BallTracker& operator=(const BallTracker&) = delete;
+    // creates an exact copy of the filter, unlike the camera handover constructor
+    BallTracker *copy() const;
 
 public:
     void update(qint64 time);
@@ -30,6 +30,7 @@
 #include <QPair>
 #include <QByteArray>
 #include <QObject>
+#include <memory>
 
 class BallTracker;
 class RobotFilter;
@@ -55,6 +56,44 @@ private:
         qint64 time;
     };
 
+public:
+    /*!
+     * \brief Complete copy of the tracking state at one point in time
+     *
+     * The ball filters keep references to the camera information and the
+     * ball model owned by the tracker. A checkpoint may therefore only be
+     * restored into the tracker that created it.
+     */
+    class Checkpoint
+    {
+    public:
+        ~Checkpoint();
+        Checkpoint(const Checkpoint&) = delete;
+        Checkpoint& operator=(const Checkpoint&) = delete;
+
+    private:
+        Checkpoint() = default;
+        friend class Tracker;
+
+        std::unique_ptr<CameraInfo> cameraInfo;
+        qint64 visionTransmissionDelay;
+        qint64 timeSinceLastReset;
+        qint64 timeToReset;
+        world::BallModel ballModel;
+        QMap<qint32, qint64> lastUpdateTime;
+        QList<Packet> visionPackets;
+        qint64 lastSlowVisionFrame;
+        int numSlowVisionFrames;
+        QList<BallTracker*> ballFilter;
+        // index into ballFilter, -1 if no filter was selected
+        int currentBallFilter;
+        RobotMap robotFilterYellow;
+        RobotMap robotFilterBlue;
+        bool aoiEnabled;
+        AreaOfInterest aoi;
+        int desiredRobotCamera;
+    };
+
 public:
     Tracker(bool robotsOnly, bool isSpeedTracker, WorldParameters *m_worldParameters);
     ~Tracker();
@@ -71,6 +110,8 @@ public:
     void queueRadioCommands(const QList<robot::RadioCommand> &radio_commands, qint64 time);
     void handleCommand(const amun::CommandTracking &command, qint64 time);
     void reset();
+    std::shared_ptr<const Checkpoint> checkpoint() const;
+    void restore(const Checkpoint &checkpoint);
     void updateTeam(const robot::Team &team, bool isBlue);
 
 public slots:
@@ -90,6 +131,9 @@ private:
     BallTracker* bestBallFilter();
     void prioritizeBallFilters();
 
+    static RobotMap copyRobotFilters(const RobotMap &robotMap);
+    static void deleteRobotFilters(RobotMap &robotMap);
+
 private:
     typedef QPair<robot::RadioCommand, qint64> RadioCommand;
     CameraInfo * const m_cameraInfo;
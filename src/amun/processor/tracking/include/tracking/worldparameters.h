@@ -38,6 +38,17 @@ class WorldParameters : public QObject
 {
     Q_OBJECT
 
+public:
+    struct Checkpoint
+    {
+        FieldTransform fieldTransform;
+        QMap<int, QString> cameraSender;
+        world::Geometry geometry;
+        world::Geometry virtualFieldGeometry;
+        world::BallModel ballModel;
+        bool virtualFieldEnabled;
+    };
+
 public:
     explicit WorldParameters(bool simulatorEnabled, bool isReplay);
 
@@ -45,6 +56,8 @@ public:
     void setFlip(bool flip) { m_fieldTransform.setFlip(flip); }
 
     void reset();
+    Checkpoint checkpoint() const;
+    void restore(const Checkpoint &checkpoint);
     void handleCommand(const amun::CommandTracking &command, bool simulatorEnabled);
     void handleVisionGeometry(const SSL_GeometryData &geometry, const QString &sender);
 
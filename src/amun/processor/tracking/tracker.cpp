@@ -52,17 +52,37 @@ Tracker::~Tracker()
     delete m_cameraInfo;
 }
 
-void Tracker::reset()
+Tracker::Checkpoint::~Checkpoint()
 {
-    for (const QList<RobotFilter*>& list : m_robotFilterYellow) {
-        qDeleteAll(list);
+    deleteRobotFilters(robotFilterYellow);
+    deleteRobotFilters(robotFilterBlue);
+    qDeleteAll(ballFilter);
+}
+
+Tracker::RobotMap Tracker::copyRobotFilters(const RobotMap &robotMap)
+{
+    RobotMap copy;
+    for (auto it = robotMap.begin(); it != robotMap.end(); ++it) {
+        QList<RobotFilter*> &filters = copy[it.key()];
+        for (const RobotFilter *filter : it.value()) {
+            filters.append(new RobotFilter(*filter));
+        }
     }
-    m_robotFilterYellow.clear();
+    return copy;
+}
 
-    for (const QList<RobotFilter*>& list : m_robotFilterBlue) {
+void Tracker::deleteRobotFilters(RobotMap &robotMap)
+{
+    for (const QList<RobotFilter*>& list : robotMap) {
         qDeleteAll(list);
     }
-    m_robotFilterBlue.clear();
+    robotMap.clear();
+}
+
+void Tracker::reset()
+{
+    deleteRobotFilters(m_robotFilterYellow);
+    deleteRobotFilters(m_robotFilterBlue);
 
     qDeleteAll(m_ballFilter);
     m_ballFilter.clear();
@@ -74,6 +94,68 @@ void Tracker::reset()
     m_cameraInfo->focalLength.clear();
 }
 
+std::shared_ptr<const Tracker::Checkpoint> Tracker::checkpoint() const
+{
+    std::shared_ptr<Checkpoint> checkpoint(new Checkpoint);
+    checkpoint->cameraInfo = std::make_unique<CameraInfo>(*m_cameraInfo);
+    checkpoint->visionTransmissionDelay = m_visionTransmissionDelay;
+    checkpoint->timeSinceLastReset = m_timeSinceLastReset;
+    checkpoint->timeToReset = m_timeToReset;
+    checkpoint->ballModel.CopyFrom(m_ballModel);
+    checkpoint->lastUpdateTime = m_lastUpdateTime;
+    checkpoint->visionPackets = m_visionPackets;
+    checkpoint->lastSlowVisionFrame = m_lastSlowVisionFrame;
+    checkpoint->numSlowVisionFrames = m_numSlowVisionFrames;
+
+    checkpoint->currentBallFilter = -1;
+    for (const BallTracker *filter : m_ballFilter) {
+        if (filter == m_currentBallFilter) {
+            checkpoint->currentBallFilter = checkpoint->ballFilter.size();
+        }
+        checkpoint->ballFilter.append(filter->copy());
+    }
+
+    checkpoint->robotFilterYellow = copyRobotFilters(m_robotFilterYellow);
+    checkpoint->robotFilterBlue = copyRobotFilters(m_robotFilterBlue);
+    checkpoint->aoiEnabled = m_aoiEnabled;
+    checkpoint->aoi = m_aoi;
+    checkpoint->desiredRobotCamera = m_desiredRobotCamera;
+    return checkpoint;
+}
+
+void Tracker::restore(const Checkpoint &checkpoint)
+{
+    reset();
+
+    // the filters point to the camera info and ball model of this tracker,
+    // so only the contents may be replaced
+    *m_cameraInfo = *checkpoint.cameraInfo;
+    m_ballModel.CopyFrom(checkpoint.ballModel);
+
+    m_visionTransmissionDelay = checkpoint.visionTransmissionDelay;
+    m_timeSinceLastReset = checkpoint.timeSinceLastReset;
+    m_timeToReset = checkpoint.timeToReset;
+    m_lastUpdateTime = checkpoint.lastUpdateTime;
+    m_visionPackets = checkpoint.visionPackets;
+    m_lastSlowVisionFrame = checkpoint.lastSlowVisionFrame;
+    m_numSlowVisionFrames = checkpoint.numSlowVisionFrames;
+
+    m_currentBallFilter = nullptr;
+    for (const BallTracker *filter : checkpoint.ballFilter) {
+        BallTracker *copy = filter->copy();
+        if (m_ballFilter.size() == checkpoint.currentBallFilter) {
+            m_currentBallFilter = copy;
+        }
+        m_ballFilter.append(copy);
+    }
+
+    m_robotFilterYellow = copyRobotFilters(checkpoint.robotFilterYellow);
+    m_robotFilterBlue = copyRobotFilters(checkpoint.robotFilterBlue);
+    m_aoiEnabled = checkpoint.aoiEnabled;
+    m_aoi = checkpoint.aoi;
+    m_desiredRobotCamera = checkpoint.desiredRobotCamera;
+}
+
 void Tracker::process(qint64 currentTime)
 {
     // reset time is used to immediatelly show robots after reset
@@ -53,6 +53,31 @@ void WorldParameters::reset()
     m_cameraSender.clear();
 }
 
+WorldParameters::Checkpoint WorldParameters::checkpoint() const
+{
+    Checkpoint checkpoint;
+    checkpoint.fieldTransform = m_fieldTransform;
+    checkpoint.cameraSender = m_cameraSender;
+    checkpoint.geometry.CopyFrom(m_geometry);
+    checkpoint.virtualFieldGeometry.CopyFrom(m_virtualFieldGeometry);
+    checkpoint.ballModel.CopyFrom(m_ballModel);
+    checkpoint.virtualFieldEnabled = m_virtualFieldEnabled;
+    return checkpoint;
+}
+
+void WorldParameters::restore(const Checkpoint &checkpoint)
+{
+    // the tracking filters keep a reference to the field transform
+    m_fieldTransform = checkpoint.fieldTransform;
+    m_cameraSender = checkpoint.cameraSender;
+    m_geometry.CopyFrom(checkpoint.geometry);
+    m_virtualFieldGeometry.CopyFrom(checkpoint.virtualFieldGeometry);
+    m_ballModel.CopyFrom(checkpoint.ballModel);
+    m_virtualFieldEnabled = checkpoint.virtualFieldEnabled;
+    // the geometry may differ from the one that was last sent
+    m_geometryUpdated = true;
+}
+
 void WorldParameters::handleCommand(const amun::CommandTracking &command, bool simulatorEnabled)
 {
     const bool simulatorEnabledBefore = m_simulatorEnabled;
@@ -22,7 +22,15 @@
 #include "core/timer.h"
 #include "core/configuration.h"
 
+#include <iterator>
+
 static const QString SENDER_NAME_FOR_REFEREE = "TrackingReplay";
+static const qint64 CHECKPOINT_INTERVAL = 100 * 1000 * 1000; // 100 ms
+// the packets between a checkpoint and the seek target are not replayed, so older checkpoints
+// could keep filters of objects that vanished in between, about three vision frames
+static const qint64 MAX_CHECKPOINT_AGE = 50 * 1000 * 1000; // 50 ms
+// bounds the memory usage for long logs, covers one minute of log
+static const int MAX_CHECKPOINTS = 600;
 
 TrackingReplay::TrackingReplay(Timer *timer) :
     m_timer(timer),
@@ -80,7 +88,13 @@ void TrackingReplay::handleStatus(const Status &status)
         m_lastTrackingReplayGameState = status;
     }
     if (previousTime > status->time()) {
-        m_replayProcessor.resetTracking();
+        // continue with the tracking state from a few frames before the status if possible
+        auto checkpoint = m_checkpoints.upperBound(status->time());
+        if (checkpoint != m_checkpoints.begin() && status->time() - std::prev(checkpoint).key() <= MAX_CHECKPOINT_AGE) {
+            m_replayProcessor.restoreTrackingCheckpoint(*std::prev(checkpoint).value());
+        } else {
+            m_replayProcessor.resetTracking();
+        }
     }
     if (status->has_team_blue()) {
         Command command(new amun::Command);
@@ -165,5 +179,21 @@ void TrackingReplay::handleStatus(const Status &status)
             }
         }
         m_replayProcessor.process(status->world_state().time());
+
+        const qint64 time = status->world_state().time();
+        auto next = m_checkpoints.upperBound(time);
+        if ((next == m_checkpoints.begin() || time - std::prev(next).key() >= CHECKPOINT_INTERVAL)
+                && (next == m_checkpoints.end() || next.key() - time >= CHECKPOINT_INTERVAL)) {
+            m_checkpoints.insert(time, m_replayProcessor.trackingCheckpoint());
+
+            // keep the checkpoints closest to the current position, seeking usually happens around it
+            if (m_checkpoints.size() > MAX_CHECKPOINTS) {
+                if (time - m_checkpoints.firstKey() > m_checkpoints.lastKey() - time) {
+                    m_checkpoints.erase(m_checkpoints.begin());
+                } else {
+                    m_checkpoints.erase(std::prev(m_checkpoints.end()));
+                }
+            }
+        }
     }
 }
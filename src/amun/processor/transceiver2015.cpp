@@ -30,6 +30,7 @@
 #include "usbdevice.h"
 #include "usbthread.h"
 #include <QByteArray>
+#include <QDebug>
 #include <QString>
 #include <libusb.h>
 #include <QEventLoop>
@@ -139,69 +140,21 @@ Transceiver2015::~Transceiver2015()
 
 void Transceiver2015::addSendCommand(const Radio::Address &target, size_t expectedResponseSize, const char *data, size_t len)
 {
-    TransceiverCommandPacket senderCommand;
-    senderCommand.command = COMMAND_SEND_NRF24;
-    senderCommand.size = len + sizeof(TransceiverSendNRF24Packet);
-
-    const auto getTargetAddress = [&](int broadcastGenerationTag, const uint8_t unicastAddressTemplate[], size_t addressTemplateLength) -> TransceiverSendNRF24Packet {
-        TransceiverSendNRF24Packet targetAddress;
-
-        if (target.isBroadcast()) {
-            // robot_datagram is used to broadcast both at generation 2014 and 2018
-            memcpy(targetAddress.address, robot_datagram, sizeof(robot_datagram));
-            // broadcast (0x1f) to generation with broadcastGenerationTag
-            targetAddress.address[0] |= 0x1f | broadcastGenerationTag;
-        } else {
-            memcpy(targetAddress.address, unicastAddressTemplate, addressTemplateLength);
-            targetAddress.address[0] |= target.unicastTarget();
-        }
-
-        targetAddress.expectedResponseSize = expectedResponseSize;
-
-        return targetAddress;
-    };
-
-    TransceiverSendNRF24Packet targetAddress;
-    switch (target.generation) {
-    case Radio::Generation::Gen2014:
-        targetAddress = getTargetAddress(
-            0x20, robot2014_address, sizeof(robot2014_address)
-        );
-        break;
-    case Radio::Generation::GenPasta:
-        targetAddress = getTargetAddress(
-            robotPasta_address[0], robotPasta_address, sizeof(robotPasta_address)
-        );
-        break;
+    if (!m_packet.addSendCommand(target, expectedResponseSize, data, len)) {
+        qWarning() << m_debugName << "dropped radio command, the transceiver packet is full";
     }
-
-    m_packet.append((const char*) &senderCommand, sizeof(senderCommand));
-    m_packet.append((const char*) &targetAddress, sizeof(targetAddress));
-    m_packet.append((const char*) data, len);
 }
 
 void Transceiver2015::addPingPacket(qint64 time)
 {
     // Append ping packet with current timestamp
-    TransceiverCommandPacket senderCommand;
-    senderCommand.command = COMMAND_PING;
-    senderCommand.size = sizeof(TransceiverPingData);
-
-    TransceiverPingData ping;
-    ping.time = time;
-
-    m_packet.append((const char*) &senderCommand, sizeof(senderCommand));
-    m_packet.append((const char*) &ping, sizeof(ping));
+    m_packet.addPing(time);
 }
 
 void Transceiver2015::addStatusPacket()
 {
     // request count of dropped usb packets
-    TransceiverCommandPacket senderCommand;
-    senderCommand.command = COMMAND_STATUS;
-    senderCommand.size = 0;
-
-    m_packet.append((const char*) &senderCommand, sizeof(senderCommand));
+    m_packet.addStatusRequest();
 }
 
 void Transceiver2015::flush(qint64 time)
@@ -211,7 +164,7 @@ void Transceiver2015::flush(qint64 time)
         addPingPacket(time);
     }
 
-    write(m_packet);
+    write(m_packet.data(), m_packet.size());
 }
 
 void Transceiver2015::handleCommand(const Command &command)
@@ -297,11 +250,16 @@ std::optional<TransceiverError> Transceiver2015::read()
 }
 
 std::optional<TransceiverError> Transceiver2015::write(const QByteArray &packet)
+{
+    return write(packet.data(), packet.size());
+}
+
+std::optional<TransceiverError> Transceiver2015::write(const char *data, qint64 size)
 {
     // close radio link on errors
     // transmission usually either succeeds completely or fails horribly
     // write does not actually guarantee complete delivery!
-    if (m_device->write(packet) < 0) {
+    if (m_device->write(data, size) < 0) {
         return TransceiverError(m_debugName, m_device->errorString());
     }
 
@@ -25,6 +25,7 @@
 #include "protobuf/command.h"
 #include "protobuf/status.h"
 #include "transceiverlayer.h"
+#include "transceiverpacket.h"
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -59,7 +60,7 @@ public:
         return m_connectionState == State::CONNECTED;
     }
 
-    void newCycle() final { m_packet.resize(0); }
+    void newCycle() final { m_packet.clear(); }
 
     static bool openDevice();
 
@@ -84,6 +85,7 @@ protected:
 
 private:
     [[nodiscard]] std::optional<TransceiverError> write(const QByteArray &packet);
+    [[nodiscard]] std::optional<TransceiverError> write(const char *data, qint64 size);
 
     [[nodiscard]] std::optional<TransceiverError> handleInitPacket(const char *data, uint size);
     void handlePingPacket(const char *data, uint size);
@@ -105,7 +107,8 @@ private:
 
     amun::TransceiverConfiguration m_configuration;
 
-    QByteArray m_packet;
+    // command packet of the current cycle, reused to avoid allocations
+    TransceiverPacket m_packet;
 
     QString m_debugName;
 };
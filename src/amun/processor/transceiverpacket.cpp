@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "transceiverpacket.h"
+#include "firmware-interface/radiocommand.h"
+#include "firmware-interface/radiocommand2014.h"
+#include "firmware-interface/radiocommandpasta.h"
+#include "firmware-interface/transceiver2012.h"
+#include "radio_address.h"
+#include <cstring>
+
+typedef struct
+{
+    int64_t time;
+} __attribute__ ((packed)) TransceiverPingData;
+
+bool TransceiverPacket::append(std::size_t length, const void *first, std::size_t firstLength,
+                               const void *second, std::size_t secondLength,
+                               const void *third, std::size_t thirdLength)
+{
+    // only ever write complete commands
+    if (m_size + length > CAPACITY) {
+        return false;
+    }
+    char *out = m_data.data() + m_size;
+    std::memcpy(out, first, firstLength);
+    if (secondLength > 0) {
+        std::memcpy(out + firstLength, second, secondLength);
+    }
+    if (thirdLength > 0) {
+        std::memcpy(out + firstLength + secondLength, third, thirdLength);
+    }
+    m_size += length;
+    return true;
+}
+
+bool TransceiverPacket::addSendCommand(const Radio::Address &target, std::size_t expectedResponseSize, const char *data, std::size_t len)
+{
+    TransceiverCommandPacket senderCommand;
+    senderCommand.command = COMMAND_SEND_NRF24;
+    senderCommand.size = len + sizeof(TransceiverSendNRF24Packet);
+
+    const auto getTargetAddress = [&](int broadcastGenerationTag, const uint8_t unicastAddressTemplate[], size_t addressTemplateLength) -> TransceiverSendNRF24Packet {
+        TransceiverSendNRF24Packet targetAddress{};
+
+        if (target.isBroadcast()) {
+            // robot_datagram is used to broadcast both at generation 2014 and 2018
+            memcpy(targetAddress.address, robot_datagram, sizeof(robot_datagram));
+            // broadcast (0x1f) to generation with broadcastGenerationTag
+            targetAddress.address[0] |= 0x1f | broadcastGenerationTag;
+        } else {
+            memcpy(targetAddress.address, unicastAddressTemplate, addressTemplateLength);
+            targetAddress.address[0] |= target.unicastTarget();
+        }
+
+        targetAddress.expectedResponseSize = expectedResponseSize;
+
+        return targetAddress;
+    };
+
+    TransceiverSendNRF24Packet targetAddress{};
+    switch (target.generation) {
+    case Radio::Generation::Gen2014:
+        targetAddress = getTargetAddress(
+            0x20, robot2014_address, sizeof(robot2014_address)
+        );
+        break;
+    case Radio::Generation::GenPasta:
+        targetAddress = getTargetAddress(
+            robotPasta_address[0], robotPasta_address, sizeof(robotPasta_address)
+        );
+        break;
+    }
+
+    return append(sizeof(senderCommand) + sizeof(targetAddress) + len,
+                  &senderCommand, sizeof(senderCommand),
+                  &targetAddress, sizeof(targetAddress),
+                  data, len);
+}
+
+bool TransceiverPacket::addPing(qint64 time)
+{
+    // Append ping packet with current timestamp
+    TransceiverCommandPacket senderCommand;
+    senderCommand.command = COMMAND_PING;
+    senderCommand.size = sizeof(TransceiverPingData);
+
+    TransceiverPingData ping;
+    ping.time = time;
+
+    return append(sizeof(senderCommand) + sizeof(ping), &senderCommand, sizeof(senderCommand), &ping, sizeof(ping));
+}
+
+bool TransceiverPacket::addStatusRequest()
+{
+    // request count of dropped usb packets
+    TransceiverCommandPacket senderCommand;
+    senderCommand.command = COMMAND_STATUS;
+    senderCommand.size = 0;
+
+    return append(sizeof(senderCommand), &senderCommand, sizeof(senderCommand));
+}
@@ -20,10 +20,20 @@
 
 #include "receiver.h"
 #include "core/timer.h"
+#include "core/tracing.h"
 #include <QNetworkInterface>
 #include <QNetworkProxy>
+#include <QSocketNotifier>
 #include <QUdpSocket>
 
+#ifdef Q_OS_LINUX
+#include "multidatagramsocket.h"
+#endif
+
+// large enough for any udp datagram
+static const int MAX_DATAGRAM_SIZE = 65536;
+static const int BATCH_SIZE = 16;
+
 /*!
  * \class Receiver
  * \ingroup amun
@@ -41,6 +51,12 @@
  * \param sender The sender of the packet
  */
 
+/*!
+ * \fn void Receiver::gotPackets(const QList<Datagram> &packets)
+ * \brief This signal is emitted once for all packets read in one go
+ * \param packets The received packets in order of arrival
+ */
+
 /*!
  * \brief Constructor
  * \param groupAddress Address of the multicast group to listen on
@@ -50,7 +66,11 @@ Receiver::Receiver(const QHostAddress &groupAddress, quint16 port, Timer *timer)
     m_groupAddress(groupAddress),
     m_port(port),
     m_socket(nullptr),
-    m_timer(timer)
+    m_timer(timer),
+#ifdef Q_OS_LINUX
+    m_batchNotifier(nullptr),
+#endif
+    m_lastSenderAddress(0)
 { }
 
 /*!
@@ -68,6 +88,10 @@ void Receiver::startListen()
 {
     stopListen();
 
+    if (startBatchListen()) {
+        return;
+    }
+
     m_socket = new QUdpSocket(this);
     // Proxying vision / referee packets won't work
     // ssh can't handle udp proxying
@@ -103,6 +127,39 @@ void Receiver::stopListen()
 {
     delete m_socket;
     m_socket = NULL;
+#ifdef Q_OS_LINUX
+    delete m_batchNotifier;
+    m_batchNotifier = nullptr;
+    m_batchSocket.reset();
+#endif
+}
+
+/*!
+ * \brief Listen using recvmmsg and kernel receive timestamps
+ * \return false if the platform doesn't support it or the socket can't be bound,
+ * the caller should use a QUdpSocket instead
+ */
+bool Receiver::startBatchListen()
+{
+#ifdef Q_OS_LINUX
+    std::unique_ptr<MultiDatagramSocket> socket(new MultiDatagramSocket(BATCH_SIZE, MAX_DATAGRAM_SIZE));
+    if (!socket->bind(m_port)) {
+        // let the QUdpSocket report the error
+        return false;
+    }
+    if (!m_groupAddress.isNull()) {
+        foreach (const QNetworkInterface& iface, QNetworkInterface::allInterfaces()) {
+            socket->joinMulticastGroup(m_groupAddress, iface);
+        }
+    }
+
+    m_batchSocket = std::move(socket);
+    m_batchNotifier = new QSocketNotifier(m_batchSocket->descriptor(), QSocketNotifier::Read, this);
+    connect(m_batchNotifier, &QSocketNotifier::activated, this, &Receiver::readBatchData);
+    return true;
+#else
+    return false;
+#endif
 }
 
 /*!
@@ -111,13 +168,18 @@ void Receiver::stopListen()
  */
 void Receiver::updateInterface(const QNetworkInterface& interface)
 {
-    if (m_socket == nullptr) {
+    if (m_groupAddress.isNull()) {
         return;
     }
-    if (!m_groupAddress.isNull()) {
-        // just try joining
+    // just try joining
+    if (m_socket != nullptr) {
         m_socket->joinMulticastGroup(m_groupAddress, interface);
     }
+#ifdef Q_OS_LINUX
+    if (m_batchSocket) {
+        m_batchSocket->joinMulticastGroup(m_groupAddress, interface);
+    }
+#endif
 }
 
 /*!
@@ -137,15 +199,76 @@ void Receiver::updatePort(quint16 port)
 }
 
 /*!
- * \brief Read a packet from the socket and emit \ref gotPacket
+ * \brief Read all pending packets from the socket and deliver them
  */
 void Receiver::readData()
 {
+    QList<Datagram> packets;
     while (m_socket->hasPendingDatagrams()) {
-        QByteArray data;
-        data.resize(m_socket->pendingDatagramSize());
+        TraceSpan span("Receiver::readData");
+        Datagram packet;
+        packet.data.resize(m_socket->pendingDatagramSize());
         QHostAddress senderAdddress;
-        m_socket->readDatagram(data.data(), data.size(), &senderAdddress);
-        emit gotPacket(data, m_timer->currentTime(), senderAdddress.toString());
+        m_socket->readDatagram(packet.data.data(), packet.data.size(), &senderAdddress);
+        packet.time = m_timer->currentTime();
+        packet.sender = senderAdddress.toString();
+        span.setTick(packet.time);
+        packets.append(packet);
+    }
+    deliver(packets);
+}
+
+/*!
+ * \brief Read all pending packets in batches and deliver them
+ *
+ * The packets are stamped with the time at which the kernel received them,
+ * which excludes the delay until this thread gets scheduled.
+ */
+void Receiver::readBatchData()
+{
+#ifdef Q_OS_LINUX
+    QList<Datagram> packets;
+    int count;
+    do {
+        TraceSpan span("Receiver::readBatchData");
+        count = m_batchSocket->readBatch();
+        if (count <= 0) {
+            break;
+        }
+        const qint64 readTime = Timer::systemTime();
+        for (int i = 0; i < count; i++) {
+            const MultiDatagramSocket::Packet &p = m_batchSocket->packet(i);
+            const qint64 receiveTime = p.timestamp > 0 ? p.timestamp : readTime;
+            packets.append(Datagram{QByteArray(p.data, p.size), m_timer->timeAt(receiveTime), senderString(p.sender)});
+        }
+        span.setTick(packets.last().time);
+        // a partial batch means that the socket is drained
+    } while (count == m_batchSocket->batchSize());
+
+    if (count < 0) {
+        qWarning() << "Failed to read from port" << m_port << m_batchSocket->errorString();
+    }
+    deliver(packets);
+#endif
+}
+
+const QString &Receiver::senderString(quint32 address)
+{
+    // all packets usually come from the same host, avoid converting the address every time
+    if (address != m_lastSenderAddress || m_lastSender.isEmpty()) {
+        m_lastSenderAddress = address;
+        m_lastSender = QHostAddress(address).toString();
+    }
+    return m_lastSender;
+}
+
+void Receiver::deliver(const QList<Datagram> &packets)
+{
+    if (packets.isEmpty()) {
+        return;
+    }
+    for (const Datagram &packet : packets) {
+        emit gotPacket(packet.data, packet.time, packet.sender);
     }
+    emit gotPackets(packets);
 }
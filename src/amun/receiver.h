@@ -22,8 +22,12 @@
 #define RECEIVER_H
 
 #include <QUdpSocket>
+#include "core/datagram.h"
 #include "protobuf/status.h"
+#include <memory>
 
+class MultiDatagramSocket;
+class QSocketNotifier;
 class Timer;
 
 class Receiver : public QObject
@@ -38,6 +42,7 @@ public:
 
 signals:
     void gotPacket(const QByteArray &data, qint64 time, QString sender);
+    void gotPackets(const QList<Datagram> &packets);
     void sendStatus(const Status &status);
 
 public slots:
@@ -48,12 +53,27 @@ public slots:
 
 private slots:
     void readData();
+    void readBatchData();
+
+private:
+    bool startBatchListen();
+    const QString &senderString(quint32 address);
+    void deliver(const QList<Datagram> &packets);
 
 private:
     QHostAddress m_groupAddress;
     quint16 m_port;
     QUdpSocket *m_socket;
     Timer *m_timer;
+
+#ifdef Q_OS_LINUX
+    // receives multiple datagrams per syscall with kernel timestamps
+    std::unique_ptr<MultiDatagramSocket> m_batchSocket;
+    QSocketNotifier *m_batchNotifier;
+#endif
+
+    quint32 m_lastSenderAddress;
+    QString m_lastSender;
 };
 
 #endif // RECEIVER_H
@@ -29,6 +29,7 @@ namespace BufferedStatusSourceInternal {
 
     signals:
         void readPackets(int startPacket, int count);
+        void seekPackets(int startPacket, int count);
     };
 }
 
@@ -43,14 +44,19 @@ BufferedStatusSource::BufferedStatusSource(std::shared_ptr<StatusSource> statusS
 {
     updateBufferSize(100); // assume 100% speed
     connect(m_signalSource, &SignalSource::readPackets, &*m_statusSource, &StatusSource::readPackets);
+    connect(m_signalSource, &SignalSource::seekPackets, &*m_statusSource, &StatusSource::seekPackets);
     connect(&*m_statusSource, &StatusSource::gotStatus, this, &BufferedStatusSource::addStatus);
 }
 
-void BufferedStatusSource::requestPackets(int start, int size) {
+void BufferedStatusSource::requestPackets(int start, int size, bool seek) {
     m_expectedPacket = start;
     m_nextPackets.clear();
     m_nextRequestPacket = start + size;
-    emit m_signalSource->readPackets(start, size);
+    if (seek) {
+        emit m_signalSource->seekPackets(start, size);
+    } else {
+        emit m_signalSource->readPackets(start, size);
+    }
     return;
 }
 
@@ -49,7 +49,8 @@ public:
     bool hasData();
     QPair<int, Status> peek() const;
     void pop();
-    void requestPackets(int startPacket, int count);
+    // when seeking, the first status is complete on its own, see StatusSource::seekPackets
+    void requestPackets(int startPacket, int count, bool seek = false);
     int requestedBufferSize(); // something like this is needed in logmanager to spool packets instead of seeking if the data is already there.
     const std::shared_ptr<StatusSource>& getStatusSource() const {
         return m_statusSource;
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef LOGFILECATALOG_H
+#define LOGFILECATALOG_H
+
+#include "protobuf/logfile.pb.h"
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+// Persistent index of the log UIDs in the log directories.
+// Log files are only read again if their size or modification time changed,
+// which is checked on every update. Directories are only listed again
+// after the file system watcher reported a change.
+class QFileInfo;
+class QFileSystemWatcher;
+
+class LogFileCatalog : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LogFileCatalog(const QString &catalogFile = defaultCatalogFile(), QObject *parent = nullptr);
+    LogFileCatalog(const LogFileCatalog&) = delete;
+    LogFileCatalog& operator=(const LogFileCatalog&) = delete;
+
+    static QString defaultCatalogFile();
+    // the log locations configured in ra
+    static QStringList configuredDirectories();
+
+    void update(const QStringList &directories);
+    bool save();
+    // offers the log files with the given uid and all files without a known uid
+    void addOffers(const logfile::Uid &uid, const QStringList &directories, logfile::LogOffer *offers) const;
+    int fileCount() const;
+
+private slots:
+    void directoryChanged(const QString &path);
+
+private:
+    struct Entry {
+        qint64 size;
+        qint64 modified;
+        logfile::LogOfferEntry::QUALITY quality;
+        logfile::Uid uid;
+        // precomputed for the lookups
+        QString uidKey;
+    };
+    // entries by file name
+    typedef QMap<QString, Entry> Directory;
+
+    static QString uidKey(const logfile::Uid &uid);
+    void load();
+    void scanDirectory(const QString &path);
+    void refreshDirectory(const QString &path);
+    void updateEntry(const QFileInfo &info, Entry &entry, bool isNew);
+    static void readEntry(const QString &filename, Entry &entry);
+
+private:
+    const QString m_catalogFile;
+    bool m_loaded;
+    bool m_changed;
+    QHash<QString, Directory> m_directories;
+    QSet<QString> m_scannedDirectories;
+    QFileSystemWatcher *m_watcher;
+};
+
+#endif // LOGFILECATALOG_H
@@ -30,6 +30,7 @@
 #include <QFile>
 #include <QList>
 
+#include <memory>
 #include <optional>
 
 class QMutex;
@@ -66,16 +67,24 @@ public:
 
 public slots:
     void readPackets(int startPacket, int count) override;
+    void seekPackets(int startPacket, int count) override;
+
+private:
+    class KeyframeBuilder;
 
 private:
     bool indexFile();
+    void startKeyframeBuilder();
     void close();
+    Status readCompleteStatus(int packet);
 
     QString m_errorMsg;
 
 
     QList<SeqLogFileReader::Memento> m_packets;
     QList<qint64> m_timings;
+    // builds the long living parts of the log state every KEYFRAME_INTERVAL packets after opening
+    std::unique_ptr<KeyframeBuilder> m_keyframeBuilder;
     bool m_headerCorrect;
     SeqLogFileReader m_reader;
 };
@@ -22,6 +22,7 @@
 #define SEQLOGFILEREADER_H
 
 #include "protobuf/status.h"
+#include <QCache>
 #include <QObject>
 #include <QString>
 #include <QDataStream>
@@ -71,6 +72,16 @@ public:
     static QList<Memento> createMementos(const QList<qint64>& offsets, qint32 groupedPackages);
 
     qint32 groupSize() const { return m_packageGroupSize; }
+    // keep up to the given amount of decompressed groups (in kilobytes) in memory, 0 disables the cache.
+    // The least recently used groups are dropped first.
+    void setGroupCacheSize(int kiloBytes) { m_groupCache.setMaxCost(kiloBytes); }
+
+private:
+    struct Group
+    {
+        QByteArray data;
+        QList<qint32> offsets;
+    };
 
 private:
     bool readVersion();
@@ -105,6 +116,8 @@ private:
     bool m_readingTimstamps;
     // m_baseOffset for the first group
     qint64 m_startOffset;
+    // decompressed groups indexed by their m_baseOffset
+    QCache<qint64, Group> m_groupCache;
 };
 
 #endif // SEQLOGFILEREADER_H
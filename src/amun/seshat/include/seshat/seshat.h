@@ -26,6 +26,7 @@
 #include "protobuf/command.h"
 #include "combinedlogwriter.h"
 
+class LogFileCatalog;
 class TimedStatusSource;
 class StatusSource;
 
@@ -74,6 +75,8 @@ private:
     bool m_storedPlaybackPaused = true;
     bool m_isTrackingReplay = false;
     QList<Status> m_horusStrategyBuffer;
+    // kept alive to answer log uid requests without reading all log files
+    LogFileCatalog *m_logCatalog;
 };
 
 #endif
@@ -42,6 +42,9 @@ public:
 
 public slots:
     virtual void readPackets(int startPacket, int count) = 0;
+    // like readPackets, but the first status additionally contains all information
+    // required to display the log at that point (geometry, teams, game state, ...)
+    virtual void seekPackets(int startPacket, int count) { readPackets(startPacket, count); }
 
 signals:
     void gotStatus(int packet, const Status &status);
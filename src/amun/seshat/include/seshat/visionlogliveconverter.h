@@ -31,6 +31,7 @@
 #include <QMap>
 #include <QByteArray>
 #include <QCache>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -55,7 +56,17 @@ public slots:
     void readPackets(int startPacket, int count) override;
 
 private:
+    // complete tracking state after the status with the respective index was read
+    struct Checkpoint {
+        std::shared_ptr<const Tracker::Checkpoint> tracker;
+        WorldParameters::Checkpoint worldParameters;
+        Referee::Checkpoint referee;
+        bool lastFlipped;
+    };
+
     qint64 processPacket(int packet, qint64 nextProcess); // in logfile packets, return the time of the read packet
+    void createCheckpoint(int packet);
+    void restoreCheckpoint(int packet);
 
 private:
     VisionLogReader *m_logFile;
@@ -74,6 +85,8 @@ private:
     QString m_indexError;
 
     QCache<int, Status> m_packetCache;
+    // sparse, indexed by the status packet number, the ones farthest from the current packet are dropped first
+    QMap<int, Checkpoint> m_checkpoints;
 
     bool m_warningSent = false;
 };
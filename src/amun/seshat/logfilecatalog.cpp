@@ -0,0 +1,260 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "logfilecatalog.h"
+#include "seqlogfilereader.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <iostream>
+
+LogFileCatalog::LogFileCatalog(const QString &catalogFile, QObject *parent) :
+    QObject(parent),
+    m_catalogFile(catalogFile),
+    m_loaded(false),
+    m_changed(false),
+    m_watcher(new QFileSystemWatcher(this))
+{
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &LogFileCatalog::directoryChanged);
+}
+
+QString LogFileCatalog::defaultCatalogFile()
+{
+    // shared between ra and the command line tools
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/ER-Force/logcatalog";
+}
+
+QStringList LogFileCatalog::configuredDirectories()
+{
+    QStringList directories;
+    QSettings s("ER-Force", "Ra");
+    s.beginGroup("LogLocation");
+    int size = s.beginReadArray("locations");
+    for (int i = 0; i < size; ++i) {
+        s.setArrayIndex(i);
+        directories.append(s.value("path").toString());
+    }
+    s.endArray();
+    s.endGroup();
+    return directories;
+}
+
+QString LogFileCatalog::uidKey(const logfile::Uid &uid)
+{
+    // two uids are a perfect match if all parts are identical
+    QString key;
+    for (const logfile::UidEntry &part : uid.parts()) {
+        key += QString::fromStdString(part.hash()) + ":" + QString::number(part.flags()) + "+";
+    }
+    return key;
+}
+
+void LogFileCatalog::load()
+{
+    m_loaded = true;
+
+    QFile file(m_catalogFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QByteArray data = file.readAll();
+    logfile::LogCatalog catalog;
+    if (!catalog.ParseFromArray(data.data(), data.size())) {
+        std::cerr << "Ignoring invalid log catalog " << m_catalogFile.toStdString() << std::endl;
+        return;
+    }
+
+    for (const logfile::LogCatalogEntry &catalogEntry : catalog.entries()) {
+        const QFileInfo info(QString::fromStdString(catalogEntry.path()));
+        Entry &entry = m_directories[info.absolutePath()][info.fileName()];
+        entry.size = catalogEntry.size();
+        entry.modified = catalogEntry.modified();
+        entry.quality = catalogEntry.quality();
+        entry.uid = catalogEntry.uid();
+        entry.uidKey = uidKey(entry.uid);
+    }
+}
+
+bool LogFileCatalog::save()
+{
+    if (!m_changed) {
+        return true;
+    }
+
+    logfile::LogCatalog catalog;
+    for (auto dir = m_directories.constBegin(); dir != m_directories.constEnd(); ++dir) {
+        for (auto it = dir.value().constBegin(); it != dir.value().constEnd(); ++it) {
+            logfile::LogCatalogEntry *catalogEntry = catalog.add_entries();
+            catalogEntry->set_path(QDir(dir.key()).filePath(it.key()).toStdString());
+            catalogEntry->set_size(it->size);
+            catalogEntry->set_modified(it->modified);
+            catalogEntry->set_quality(it->quality);
+            if (it->quality == logfile::LogOfferEntry::PERFECT) {
+                catalogEntry->mutable_uid()->CopyFrom(it->uid);
+            }
+        }
+    }
+
+    QDir().mkpath(QFileInfo(m_catalogFile).absolutePath());
+    QSaveFile file(m_catalogFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const std::string data = catalog.SerializeAsString();
+    file.write(data.data(), data.size());
+    if (!file.commit()) {
+        return false;
+    }
+    m_changed = false;
+    return true;
+}
+
+void LogFileCatalog::update(const QStringList &directories)
+{
+    if (!m_loaded) {
+        load();
+    }
+    for (const QString &directory : directories) {
+        const QString path = QDir(directory).absolutePath();
+        if (!m_scannedDirectories.contains(path)) {
+            scanDirectory(path);
+        } else {
+            refreshDirectory(path);
+        }
+    }
+}
+
+void LogFileCatalog::directoryChanged(const QString &path)
+{
+    // the watcher only reports added and removed files reliably,
+    // so the directory is listed again on the next update
+    m_scannedDirectories.remove(path);
+}
+
+void LogFileCatalog::readEntry(const QString &filename, Entry &entry)
+{
+    entry.quality = logfile::LogOfferEntry::UNREADABLE;
+    entry.uid.Clear();
+    entry.uidKey.clear();
+
+    SeqLogFileReader slfr;
+    if (!slfr.open(filename)) {
+        std::cout << slfr.errorMsg().toStdString() << std::endl; // TODO: stdout
+        return;
+    }
+    Status s = slfr.readStatus();
+    if (s.isNull()) {
+        return;
+    }
+    if (!s->has_log_id()) {
+        entry.quality = logfile::LogOfferEntry::UNKNOWN;// TODO: This way or Rehash and reask?
+        return;
+    }
+    entry.quality = logfile::LogOfferEntry::PERFECT;
+    entry.uid.CopyFrom(s->log_id());
+    entry.uidKey = uidKey(entry.uid);
+}
+
+void LogFileCatalog::scanDirectory(const QString &path)
+{
+    m_scannedDirectories.insert(path);
+    if (QFileInfo(path).isDir() && !m_watcher->directories().contains(path)) {
+        m_watcher->addPath(path);
+    }
+
+    Directory &directory = m_directories[path];
+    Directory updated;
+    QDir dir(path);
+    const QFileInfoList files(dir.entryInfoList({"*.log"}, QDir::Files | QDir::Readable));
+    for (const QFileInfo &info : files) {
+        auto it = directory.constFind(info.fileName());
+        Entry entry = it != directory.constEnd() ? it.value() : Entry();
+        updateEntry(info, entry, it == directory.constEnd());
+        updated.insert(info.fileName(), entry);
+    }
+    if (updated.size() != directory.size()) {
+        m_changed = true;
+    }
+    directory = updated;
+}
+
+void LogFileCatalog::refreshDirectory(const QString &path)
+{
+    // logs that are still being recorded change without a directory change,
+    // thus the known files are checked on every update
+    Directory &directory = m_directories[path];
+    const QDir dir(path);
+    for (auto it = directory.begin(); it != directory.end();) {
+        const QFileInfo info(dir.filePath(it.key()));
+        if (!info.isFile()) {
+            it = directory.erase(it);
+            m_changed = true;
+            continue;
+        }
+        updateEntry(info, it.value(), false);
+        ++it;
+    }
+}
+
+void LogFileCatalog::updateEntry(const QFileInfo &info, Entry &entry, bool isNew)
+{
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    if (!isNew && entry.size == info.size() && entry.modified == modified) {
+        return;
+    }
+
+    // only new or modified files have to be read
+    entry.size = info.size();
+    entry.modified = modified;
+    readEntry(info.absoluteFilePath(), entry);
+    m_changed = true;
+}
+
+void LogFileCatalog::addOffers(const logfile::Uid &uid, const QStringList &directories, logfile::LogOffer *offers) const
+{
+    const QString key = uidKey(uid);
+    for (const QString &directory : directories) {
+        const QString path = QDir(directory).absolutePath();
+        const Directory entries = m_directories.value(path);
+        for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+            // TODO: Offer some non-perfect matches in the future.
+            if (it->quality == logfile::LogOfferEntry::PERFECT && it->uidKey != key) {
+                continue;
+            }
+            auto* entry = offers->add_entries();
+            entry->mutable_uri()->set_path(QDir(path).filePath(it.key()).toStdString());
+            entry->set_name(it.key().toStdString());
+            entry->set_quality(it->quality);
+        }
+    }
+}
+
+int LogFileCatalog::fileCount() const
+{
+    int count = 0;
+    for (const Directory &directory : m_directories) {
+        count += directory.size();
+    }
+    return count;
+}
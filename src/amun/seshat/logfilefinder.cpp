@@ -17,15 +17,13 @@
  *   You should have received a copy of the GNU General Public License     *
  *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
  ***************************************************************************/
-#include <iostream>
 #include <string>
-#include <QDir>
-#include <QSettings>
 
 #include "logfilefinder.h"
-#include "logfilereader.h"
+#include "logfilecatalog.h"
 
-LogFileFinder::LogFileFinder()
+LogFileFinder::LogFileFinder(LogFileCatalog &catalog) :
+    m_catalog(catalog)
 {
 }
 
@@ -102,36 +100,6 @@ static LogFileFinder::LogFileQuality compareHash(const logfile::Uid& timeline, c
     return LogFileFinder::LogFileQuality::PARTIAL_MATCH;
 }
 
-void LogFileFinder::addDirectory(const QString& s, logfile::LogOffer* offers)
-{
-    QDir dir(s);
-    QFileInfoList files(dir.entryInfoList({"*.log"}, QDir::Files | QDir::Readable));
-    for(const QFileInfo &info : files) {
-        QString filename = info.absoluteFilePath();
-        SeqLogFileReader slfr;
-        auto* entry = offers->add_entries();
-        entry->mutable_uri()->set_path(filename.toStdString());
-        entry->set_name(info.fileName().toStdString());
-        if(!slfr.open(filename)) {
-            entry->set_quality(logfile::LogOfferEntry::UNREADABLE);
-            std::cout << slfr.errorMsg().toStdString() << std::endl; // TODO: stdout
-            continue;
-        }
-        Status s = slfr.readStatus();
-        if (s.isNull()) {
-            entry->set_quality(logfile::LogOfferEntry::UNREADABLE);
-        } else if (!s->has_log_id()) {
-            entry->set_quality(logfile::LogOfferEntry::UNKNOWN);// TODO: This way or Rehash and reask?
-        } else {
-            entry->set_quality(logfile::LogOfferEntry::PERFECT); // TODO: Offer some non-perfect matches in the future.
-            const logfile::Uid& uid = s->log_id();
-            if (!isPerfectMatch(m_hash, uid)) {
-                offers->mutable_entries()->RemoveLast();
-            }
-        }
-    }
-}
-
 Status LogFileFinder::find(const logfile::Uid& hash)
 {
     m_hash = hash;
@@ -195,15 +163,9 @@ Status LogFileFinder::findAll()
 
 void LogFileFinder::findLocal(logfile::LogOffer* offers)
 {
-    QSettings s("ER-Force", "Ra");
-    s.beginGroup("LogLocation");
-    int size = s.beginReadArray("locations");
-    for(int i = 0; i < size; ++i){
-        s.setArrayIndex(i);
-        QString path = s.value("path").toString();
-        addDirectory(path, offers);
-    }
-    s.endArray();
-    s.endGroup();
+    // only new or modified log files are read, the lookup uses the catalog
+    const QStringList directories = LogFileCatalog::configuredDirectories();
+    m_catalog.update(directories);
+    m_catalog.save();
+    m_catalog.addOffers(m_hash, directories, offers);
 }
-
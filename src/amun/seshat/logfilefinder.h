@@ -26,6 +26,7 @@
 #include "protobuf/logfile.pb.h"
 #include "protobuf/status.h"
 
+class LogFileCatalog;
 class LogFileReader;
 
 class LogFileFinder
@@ -36,14 +37,14 @@ public:
         PERFECT_MATCH, FULL_MATCH, PARTIAL_MATCH, UNKNOWN, NO_MATCH, NOT_READABLE
     };
 
-    explicit LogFileFinder();
+    explicit LogFileFinder(LogFileCatalog &catalog);
     Status find(const logfile::Uid& m_hash);
     Status find(logfile::Uid&& m_hash);
     Status find(const QString& stringified);
 private:
     void findLocal(logfile::LogOffer* offers);
     Status findAll();
-    void addDirectory(const QString& s, logfile::LogOffer* offers);
+    LogFileCatalog &m_catalog;
     logfile::Uid m_hash;
 };
 
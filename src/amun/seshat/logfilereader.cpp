@@ -20,18 +20,157 @@
 
 #include "logfilereader.h"
 
+#include <QMap>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
 
+// packets between two keyframes, at about 500 status per second
+static const int KEYFRAME_INTERVAL = 500;
+// memory for decompressed packet groups in kilobytes
+static const int GROUP_CACHE_SIZE = 32 * 1024;
+
+// copies the parts of a status that stay valid until they are sent again
+static void mergeLongLivingParts(amun::Status &target, const amun::Status &status)
+{
+    target.set_time(status.time());
+    if (status.has_geometry()) {
+        target.mutable_geometry()->CopyFrom(status.geometry());
+    }
+    if (status.has_team_blue()) {
+        target.mutable_team_blue()->CopyFrom(status.team_blue());
+    }
+    if (status.has_team_yellow()) {
+        target.mutable_team_yellow()->CopyFrom(status.team_yellow());
+    }
+    if (status.has_game_state()) {
+        target.mutable_game_state()->CopyFrom(status.game_state());
+    }
+}
+
+namespace {
+    // the latest world state and debug output per source of a range of packets,
+    // the statuses are only copied once the range is complete
+    struct LatestParts
+    {
+        Status worldState;
+        QMap<amun::DebugSource, Status> debug;
+
+        void add(const Status &status)
+        {
+            if (status->has_world_state()) {
+                worldState = status;
+            }
+            for (const amun::DebugValues &debugValues : status->debug()) {
+                debug[debugValues.source()] = status;
+            }
+        }
+
+        void applyTo(amun::Status &target) const
+        {
+            if (!worldState.isNull()) {
+                target.mutable_world_state()->CopyFrom(worldState->world_state());
+            }
+            if (debug.isEmpty()) {
+                return;
+            }
+            google::protobuf::RepeatedPtrField<amun::DebugValues> kept;
+            for (const amun::DebugValues &debugValues : target.debug()) {
+                if (!debug.contains(debugValues.source())) {
+                    kept.Add()->CopyFrom(debugValues);
+                }
+            }
+            target.mutable_debug()->Swap(&kept);
+            for (auto it = debug.begin(); it != debug.end(); ++it) {
+                for (const amun::DebugValues &debugValues : it.value()->debug()) {
+                    if (debugValues.source() == it.key()) {
+                        target.add_debug()->CopyFrom(debugValues);
+                    }
+                }
+            }
+        }
+    };
+}
+
+// Reads the whole log once with its own reader and publishes a keyframe every KEYFRAME_INTERVAL
+// packets, so that seeking only has to replay the packets after the closest keyframe.
+class LogFileReader::KeyframeBuilder : public QThread
+{
+public:
+    KeyframeBuilder(const QString &filename, int packetCount) :
+        m_filename(filename),
+        m_packetCount(packetCount)
+    { }
+
+    ~KeyframeBuilder() override
+    {
+        requestInterruption();
+        wait();
+    }
+
+    // returns the latest keyframe which is already built and not after the given packet,
+    // keyframePacket is set to the packet it belongs to
+    Status keyframe(int packet, int &keyframePacket)
+    {
+        QMutexLocker locker(&m_mutex);
+        const int index = std::min(packet / KEYFRAME_INTERVAL, m_keyframes.size() - 1);
+        if (index < 0) {
+            return Status();
+        }
+        keyframePacket = index * KEYFRAME_INTERVAL;
+        return m_keyframes[index];
+    }
+
+protected:
+    void run() override
+    {
+        SeqLogFileReader reader;
+        if (!reader.open(m_filename)) {
+            return;
+        }
+        reader.reset();
+
+        // keyframe i contains the state after reading packet i * KEYFRAME_INTERVAL,
+        // including the latest world state and debug output
+        Status keyframe(new amun::Status);
+        LatestParts latest;
+        for (int i = 0; i < m_packetCount && !isInterruptionRequested(); i++) {
+            Status status = reader.readStatus();
+            if (!status.isNull()) {
+                mergeLongLivingParts(*keyframe, *status);
+                latest.add(status);
+            }
+            if (i % KEYFRAME_INTERVAL == 0) {
+                latest.applyTo(*keyframe);
+                latest = LatestParts();
+                Status next(new amun::Status);
+                next->CopyFrom(*keyframe);
+                QMutexLocker locker(&m_mutex);
+                m_keyframes.append(keyframe);
+                // published keyframes are never modified again
+                keyframe = next;
+            }
+        }
+    }
+
+private:
+    const QString m_filename;
+    const int m_packetCount;
+    QMutex m_mutex;
+    QList<Status> m_keyframes;
+};
 
 LogFileReader::LogFileReader()
 {
+    m_reader.setGroupCacheSize(GROUP_CACHE_SIZE);
 }
 
 LogFileReader::LogFileReader(const QList<qint64> &timings, const QList<qint64> &offsets, const qint32 groupedPackages):
     m_packets(SeqLogFileReader::createMementos(offsets, groupedPackages)),
     m_timings(timings)
 {
+    m_reader.setGroupCacheSize(GROUP_CACHE_SIZE);
 }
 
 LogFileReader::~LogFileReader()
@@ -41,10 +180,15 @@ LogFileReader::~LogFileReader()
 
 LogFileReader::LogFileReader(SeqLogFileReader&& reader) : m_reader(std::move(reader))
 {
+    m_reader.setGroupCacheSize(GROUP_CACHE_SIZE);
     m_reader.reset();
     m_headerCorrect = true;
     if (m_reader.isOpen() && !indexFile()) {
         m_reader.close();
+        return;
+    }
+    if (m_reader.isOpen()) {
+        startKeyframeBuilder();
     }
 }
 
@@ -86,12 +230,21 @@ bool LogFileReader::open(const QString &filename)
         return false;
     }
 
+    startKeyframeBuilder();
     return true;
 }
 
+void LogFileReader::startKeyframeBuilder()
+{
+    // reading for the playback takes precedence over building the keyframes
+    m_keyframeBuilder.reset(new KeyframeBuilder(m_reader.fileName(), m_packets.size()));
+    m_keyframeBuilder->start(QThread::LowPriority);
+}
+
 void LogFileReader::close()
 {
     // cleanup everything and close file
+    m_keyframeBuilder.reset();
     m_reader.close();
 
     m_errorMsg.clear();
@@ -155,6 +308,72 @@ void LogFileReader::readPackets(int startPacket, int count)
     }
 }
 
+void LogFileReader::seekPackets(int startPacket, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    emit gotStatus(startPacket, readCompleteStatus(startPacket));
+    readPackets(startPacket + 1, count - 1);
+}
+
+Status LogFileReader::readCompleteStatus(int packet)
+{
+    Status status = readStatus(packet);
+    if (status.isNull()) {
+        return status;
+    }
+
+    // apply the packets between the latest available keyframe and the requested one,
+    // until the keyframes are built this has to start at the beginning of the log
+    amun::Status accumulated;
+    int first = 0;
+    int keyframePacket;
+    const Status keyframe = m_keyframeBuilder ? m_keyframeBuilder->keyframe(packet, keyframePacket) : Status();
+    if (!keyframe.isNull()) {
+        accumulated.CopyFrom(*keyframe);
+        first = keyframePacket + 1;
+    }
+    LatestParts latest;
+    for (int i = first; i < packet; i++) {
+        Status s = readStatus(i);
+        if (s.isNull()) {
+            continue;
+        }
+        mergeLongLivingParts(accumulated, *s);
+        latest.add(s);
+    }
+    latest.applyTo(accumulated);
+
+    // only add what is missing in the requested status
+    Status complete(new amun::Status);
+    complete->CopyFrom(*status);
+    if (!status->has_geometry() && accumulated.has_geometry()) {
+        complete->mutable_geometry()->CopyFrom(accumulated.geometry());
+    }
+    if (!status->has_team_blue() && accumulated.has_team_blue()) {
+        complete->mutable_team_blue()->CopyFrom(accumulated.team_blue());
+    }
+    if (!status->has_team_yellow() && accumulated.has_team_yellow()) {
+        complete->mutable_team_yellow()->CopyFrom(accumulated.team_yellow());
+    }
+    if (!status->has_game_state() && accumulated.has_game_state()) {
+        complete->mutable_game_state()->CopyFrom(accumulated.game_state());
+    }
+    if (!status->has_world_state() && accumulated.has_world_state()) {
+        complete->mutable_world_state()->CopyFrom(accumulated.world_state());
+    }
+    for (const amun::DebugValues &debugValues : accumulated.debug()) {
+        const bool hasSource = std::any_of(status->debug().begin(), status->debug().end(), [&debugValues](const amun::DebugValues &own) {
+            return own.source() == debugValues.source();
+        });
+        if (!hasSource) {
+            complete->add_debug()->CopyFrom(debugValues);
+        }
+    }
+    return complete;
+}
+
 std::optional<QString> LogFileReader::logUIDFromStatus(const Status status) {
     if (!status->has_log_id()) {
         return {};
@@ -25,7 +25,8 @@
 
 SeqLogFileReader::SeqLogFileReader() :
     m_file(new QFile()),
-    m_stream(new QDataStream(m_file.get()))
+    m_stream(new QDataStream(m_file.get())),
+    m_groupCache(0)
 {
     m_mutex = new QMutex(QMutex::Recursive);
     // ensure compatibility across qt versions
@@ -50,7 +51,8 @@ SeqLogFileReader::SeqLogFileReader(SeqLogFileReader&& o) :
     m_packageGroupSize(std::move(o.m_packageGroupSize)),
     m_baseOffset(std::move(o.m_baseOffset)),
     m_readingTimstamps(std::move(o.m_readingTimstamps)),
-    m_startOffset(std::move(o.m_startOffset))
+    m_startOffset(std::move(o.m_startOffset)),
+    m_groupCache(o.m_groupCache.maxCost())
 {
     //leave o in a valid state
     o.m_file.reset(new QFile());
@@ -102,6 +104,7 @@ void SeqLogFileReader::close()
 
     m_errorMsg.clear();
     m_currentGroup.clear();
+    m_groupCache.clear();
 }
 
 QList<SeqLogFileReader::Memento> SeqLogFileReader::createMementos(const QList<qint64>& offsets, qint32 groupedPackages)
@@ -135,6 +138,19 @@ bool SeqLogFileReader::readNextGroup()
         }
     }
     m_baseOffset = baseOffset;
+
+    // the data is implicitly shared, no need to copy it
+    if (const Group *cached = m_groupCache.object(baseOffset)) {
+        quint32 size;
+        *m_stream >> size;
+        m_file->seek(m_file->pos() + size);
+        m_currentGroup = cached->data;
+        m_currentGroupOffsets = cached->offsets;
+        m_currentGroupIndex = 0;
+        m_readingTimstamps = false;
+        return true;
+    }
+
     // read and decompress group
     m_currentGroup.clear();
     *m_stream >> m_currentGroup;
@@ -157,6 +173,10 @@ bool SeqLogFileReader::readNextGroup()
     }
     m_currentGroupIndex = 0;
     m_readingTimstamps = false;
+
+    if (m_groupCache.maxCost() > 0) {
+        m_groupCache.insert(baseOffset, new Group{m_currentGroup, m_currentGroupOffsets}, m_currentGroup.size() / 1024 + 1);
+    }
     return true;
 }
 
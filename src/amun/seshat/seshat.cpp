@@ -25,6 +25,7 @@
 #include "logfilereader.h"
 #include "visionconverter.h"
 #include "logfilefinder.h"
+#include "logfilecatalog.h"
 
 #include <QThread>
 #include <QCoreApplication>
@@ -35,7 +36,8 @@ Seshat::Seshat(int backlogLength, QObject* parent) :
     QObject(parent),
     m_logger(false, backlogLength),
     m_replayLogger(true, backlogLength),
-    m_logthread(new QThread)
+    m_logthread(new QThread),
+    m_logCatalog(new LogFileCatalog(LogFileCatalog::defaultCatalogFile(), this))
 {
     m_logthread->setObjectName("Seshat Log Thread");
     m_logthread->start();
@@ -267,7 +269,7 @@ void Seshat::handleUIDRequest()
 
 void Seshat::handleLogFindRequest(const std::string& logHash)
 {
-    LogFileFinder finder;
+    LogFileFinder finder(*m_logCatalog);
     emit sendUi(finder.find(QString::fromStdString(logHash)));
 }
 
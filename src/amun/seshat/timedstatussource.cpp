@@ -132,16 +132,9 @@ void TimedStatusSource::seekPacket(int packet)
     }
     emit jumped();
 
-    // read a few packets before the new one to have a complete up-to-date status
-    int preloadCount =  10;
-    const int preloadPacket = std::max(0, packet - preloadCount + 1);
-    preloadCount = packet - preloadPacket + 1; // allow playback of the first frames
-
-
-    // fast forward unwanted packets and the preload
-    m_spoolCounter = preloadCount; // playback without time checks
-
-    m_statusSource.requestPackets(preloadPacket, preloadCount); // load the required packets
+    // the status source merges everything required for a complete status into the first packet
+    m_spoolCounter = 1; // playback without time checks
+    m_statusSource.requestPackets(packet, 1, true);
 }
 
 void TimedStatusSource::handlePlaySpeed(int speed)
@@ -22,8 +22,13 @@
 #include "visionlog/visionlogreader.h"
 
 #include <QString>
+#include <iterator>
 
 static const QString SENDER_NAME_FOR_REFEREE = "VisionLogLiveConverter";
+// store the full tracking state once per second of the log (in status packets)
+static const int CHECKPOINT_INTERVAL = 100;
+// bounds the memory usage for long logs, covers five minutes of log
+static const int MAX_CHECKPOINTS = 300;
 
 VisionLogLiveConverter::VisionLogLiveConverter(VisionLogReader *file) :
     m_worldParameters(false, true),
@@ -123,8 +128,15 @@ Status VisionLogLiveConverter::readStatus(int packet)
     int startPacket = m_lastPacket;
     const int PRELOAD_PACKETS = 200; // 2 seconds
     if (packet < m_lastPacket || packet - m_lastPacket > PRELOAD_PACKETS) {
-        m_tracker.reset();
-        startPacket = std::max(0, packet - PRELOAD_PACKETS);
+        // continue from the closest checkpoint before the requested packet if there is one
+        auto checkpoint = m_checkpoints.upperBound(packet);
+        if (checkpoint != m_checkpoints.begin() && packet - std::prev(checkpoint).key() <= PRELOAD_PACKETS) {
+            startPacket = std::prev(checkpoint).key();
+            restoreCheckpoint(startPacket);
+        } else {
+            m_tracker.reset();
+            startPacket = std::max(0, packet - PRELOAD_PACKETS);
+        }
     }
     for (int p = m_timeIndex[startPacket];p < m_timeIndex[packet];p++) {
         qint64 time = processPacket(p, m_timings[startPacket]);
@@ -173,11 +185,44 @@ Status VisionLogLiveConverter::readStatus(int packet)
         m_warningSent = true;
     }
 
+    if (packet % CHECKPOINT_INTERVAL == 0 && !m_checkpoints.contains(packet)) {
+        createCheckpoint(packet);
+    }
+
     // yes, it is really uncomfortable to use smart pointers this way
     m_packetCache.insert(packet, new Status(status));
     return status;
 }
 
+void VisionLogLiveConverter::createCheckpoint(int packet)
+{
+    Checkpoint checkpoint;
+    checkpoint.tracker = m_tracker.checkpoint();
+    checkpoint.worldParameters = m_worldParameters.checkpoint();
+    checkpoint.referee = m_referee.checkpoint();
+    checkpoint.lastFlipped = m_lastFlipped;
+    m_checkpoints.insert(packet, checkpoint);
+
+    // keep the checkpoints closest to the current position, seeking usually happens around it
+    if (m_checkpoints.size() > MAX_CHECKPOINTS) {
+        if (packet - m_checkpoints.firstKey() > m_checkpoints.lastKey() - packet) {
+            m_checkpoints.erase(m_checkpoints.begin());
+        } else {
+            m_checkpoints.erase(std::prev(m_checkpoints.end()));
+        }
+    }
+}
+
+void VisionLogLiveConverter::restoreCheckpoint(int packet)
+{
+    const Checkpoint &checkpoint = m_checkpoints[packet];
+    m_tracker.restore(*checkpoint.tracker);
+    m_worldParameters.restore(checkpoint.worldParameters);
+    m_referee.restore(checkpoint.referee);
+    m_lastFlipped = checkpoint.lastFlipped;
+    m_visionWrapperPackets.clear();
+}
+
 void VisionLogLiveConverter::readPackets(int startPacket, int count)
 {
     // read requested packets
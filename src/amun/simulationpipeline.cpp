@@ -0,0 +1,172 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "simulationpipeline.h"
+#include "commandconverter.h"
+#include "optionsmanager.h"
+#include "gamecontroller/internalgamecontroller.h"
+#include "gamecontroller/strategygamecontrollermediator.h"
+#include "processor/processor.h"
+#include "simulator/fastsimulator.h"
+#include "simulator/simulator.h"
+#include "strategy/strategy.h"
+#include <QCoreApplication>
+
+using camun::simulator::Simulator;
+
+// the simulator asserts a non-zero start time
+static const qint64 START_TIME = 1000 * 1000 * 1000;
+
+SimulationPipeline::SimulationPipeline(const amun::SimulatorSetup &setup, uint32_t seed, CompilerRegistry *compilerRegistry) :
+    m_seed(seed)
+{
+    m_timer.setTime(START_TIME, 0);
+
+    m_processor.reset(new Processor(&m_timer, false));
+    // the processor is triggered by step
+    m_processor->setScaling(0);
+    connect(m_processor.get(), &Processor::sendStatus, this, &SimulationPipeline::handleStatus);
+
+    m_commandConverter.reset(new CommandConverter(&m_timer));
+    connect(m_commandConverter.get(), &CommandConverter::sendStatus, this, &SimulationPipeline::handleStatus);
+    connect(m_processor.get(), &Processor::sendRadioCommands, m_commandConverter.get(), &CommandConverter::handleRadioCommands);
+
+    createSimulator(setup);
+
+    m_optionsManager.reset(new OptionsManager);
+    connect(m_optionsManager.get(), &OptionsManager::sendStatus, this, &SimulationPipeline::handleStatus);
+
+    InternalGameController *gameController = m_processor->getInternalGameController();
+    connect(this, &SimulationPipeline::useInternalGameController, gameController, &InternalGameController::setEnabled);
+    connect(this, &SimulationPipeline::gotCommandForGC, gameController, &InternalGameController::handleCommand);
+    connect(gameController, &InternalGameController::sendCommand, this, &SimulationPipeline::handleCommand);
+
+    for (int i = 0; i < 3; i++) {
+        StrategyType type = StrategyType::BLUE;
+        if (i == 1) {
+            type = StrategyType::YELLOW;
+        } else if (i == 2) {
+            type = StrategyType::AUTOREF;
+        }
+
+        m_gameControllerConnection[i].reset(new StrategyGameControllerMediator(gameController, i == 2));
+        connect(this, &SimulationPipeline::useInternalGameController,
+                m_gameControllerConnection[i].get(), &StrategyGameControllerMediator::switchInternalGameController);
+
+        m_strategy[i].reset(new Strategy(&m_timer, type, nullptr, compilerRegistry, m_gameControllerConnection[i], i == 2));
+        Strategy *strategy = m_strategy[i].get();
+        // processed by step
+        strategy->setManualTrigger(true);
+        connect(m_processor.get(), &Processor::sendStrategyStatus, strategy, &Strategy::handleStatus);
+        // queued like in Amun, as the options may reload the strategy while it sends its status
+        connect(m_optionsManager.get(), &OptionsManager::sendStatus, strategy, &Strategy::handleStatus, Qt::QueuedConnection);
+        connect(strategy, &Strategy::sendStatus, m_optionsManager.get(), &OptionsManager::handleStatus, Qt::QueuedConnection);
+        connect(strategy, &Strategy::sendStrategyCommands, m_processor.get(), &Processor::handleStrategyCommands);
+        connect(strategy, &Strategy::sendHalt, m_processor.get(), &Processor::handleStrategyHalt);
+        connect(m_processor.get(), &Processor::setFlipped, strategy, &Strategy::setFlipped);
+        connect(strategy, &Strategy::gotCommand, this, &SimulationPipeline::handleCommand);
+        connect(strategy, &Strategy::sendStatus, this, &SimulationPipeline::handleStatus);
+    }
+}
+
+void SimulationPipeline::createSimulator(const amun::SimulatorSetup &setup)
+{
+    m_simulator.reset(new Simulator(&m_timer, setup, true));
+    m_simulator->seedPRGN(m_seed);
+    connect(m_simulator.get(), &Simulator::sendStatus, this, &SimulationPipeline::handleStatus);
+    connect(m_processor.get(), &Processor::setFlipped, m_simulator.get(), &Simulator::setFlipped);
+
+    // same connections as for the internal simulator in Amun::setSimulatorEnabled
+    connect(m_commandConverter.get(), &CommandConverter::sendSSLSim, m_simulator.get(), &Simulator::handleRadioCommands);
+    connect(m_simulator.get(), &Simulator::sendSSLSimError, m_commandConverter.get(), &CommandConverter::handleSimulatorErrors);
+    connect(m_simulator.get(), &Simulator::gotVisionPackets, m_processor.get(), &Processor::handleVisionPackets);
+    connect(m_simulator.get(), &Simulator::sendRealState, m_processor.get(), &Processor::handleSimulatorState);
+    connect(m_simulator.get(), &Simulator::sendRadioResponses, m_processor.get(), &Processor::handleRadioResponses);
+}
+
+void SimulationPipeline::handleStatus(const Status &status)
+{
+    // like Amun::handleStatus
+    status->set_time(m_timer.currentTime());
+    emit sendStatus(status);
+}
+
+SimulationPipeline::~SimulationPipeline()
+{
+    // the strategies reference the game controller of the processor
+    for (auto &strategy : m_strategy) {
+        strategy.reset();
+    }
+}
+
+void SimulationPipeline::handleCommand(const Command &command)
+{
+    if (command->has_simulator() && command->simulator().has_simulator_setup()) {
+        // unlike Amun, the time continues to run
+        createSimulator(command->simulator().simulator_setup());
+    }
+    if (command->has_pause_simulator()) {
+        const amun::PauseSimulatorCommand &pause = command->pause_simulator();
+        if (pause.pause()) {
+            m_pauseReasons.insert(pause.reason());
+        } else {
+            m_pauseReasons.remove(pause.reason());
+        }
+    }
+
+    m_simulator->handleCommand(command);
+    m_processor->handleCommand(command);
+    m_commandConverter->handleCommand(command);
+    m_optionsManager->handleCommand(command);
+    for (auto &strategy : m_strategy) {
+        strategy->handleCommand(command);
+    }
+
+    if (command->has_referee()) {
+        const amun::CommandReferee &referee = command->referee();
+        const bool internalAutorefBefore = m_useInternalReferee && m_useAutoref;
+        if (referee.has_active()) {
+            m_useInternalReferee = referee.active();
+        }
+        if (referee.has_use_internal_autoref()) {
+            m_useAutoref = referee.use_internal_autoref();
+        }
+        const bool internalAutoref = m_useInternalReferee && m_useAutoref;
+        if (internalAutoref != internalAutorefBefore) {
+            m_strategy[2]->blockSignals(!internalAutoref);
+            m_strategy[2]->setEnabled(internalAutoref);
+        }
+        emit useInternalGameController(internalAutoref);
+        emit gotCommandForGC(referee);
+    }
+}
+
+void SimulationPipeline::step()
+{
+    const qint64 tickDuration = 1000 * 1000 * 1000 / Processor::FREQUENCY;
+    // vision packets and radio responses are passed to the processor by direct connections
+    FastSimulator::goToTime(m_simulator.get(), &m_timer, m_timer.currentTime() + tickDuration);
+    m_processor->process();
+    // the strategies got the new status from the processor, run them without waiting for their idle timer
+    for (auto &strategy : m_strategy) {
+        strategy->tryProcess();
+    }
+    // deliver queued signals, e.g. from the game controller thread, timers are never run
+    QCoreApplication::sendPostedEvents();
+}
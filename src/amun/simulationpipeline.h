@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef SIMULATIONPIPELINE_H
+#define SIMULATIONPIPELINE_H
+
+#include "core/timer.h"
+#include "protobuf/command.h"
+#include "protobuf/status.h"
+#include <QObject>
+#include <QSet>
+#include <array>
+#include <cstdint>
+#include <memory>
+
+class CommandConverter;
+class CompilerRegistry;
+class OptionsManager;
+class Processor;
+class Strategy;
+class StrategyGameControllerMediator;
+namespace camun {
+    namespace simulator {
+        class Simulator;
+    }
+}
+
+// simulator, processor and strategies wired up like in Amun, but stepped manually
+class SimulationPipeline : public QObject
+{
+    Q_OBJECT
+public:
+    SimulationPipeline(const amun::SimulatorSetup &setup, uint32_t seed, CompilerRegistry *compilerRegistry);
+    ~SimulationPipeline() override;
+    SimulationPipeline(const SimulationPipeline&) = delete;
+    SimulationPipeline& operator=(const SimulationPipeline&) = delete;
+
+    // advances the simulation by one processor tick and runs the strategies on the result
+    void step();
+    qint64 time() const { return m_timer.currentTime(); }
+    // set by pause_simulator commands, step still advances the simulation
+    bool isPaused() const { return !m_pauseReasons.isEmpty(); }
+
+signals:
+    void sendStatus(const Status &status);
+    void gotCommandForGC(const amun::CommandReferee &refereeCommand);
+    void useInternalGameController(bool enabled);
+
+public slots:
+    void handleCommand(const Command &command);
+
+private slots:
+    void handleStatus(const Status &status);
+
+private:
+    void createSimulator(const amun::SimulatorSetup &setup);
+
+private:
+    const uint32_t m_seed;
+    Timer m_timer;
+    std::unique_ptr<Processor> m_processor;
+    std::unique_ptr<camun::simulator::Simulator> m_simulator;
+    std::unique_ptr<CommandConverter> m_commandConverter;
+    std::unique_ptr<OptionsManager> m_optionsManager;
+    std::array<std::shared_ptr<StrategyGameControllerMediator>, 3> m_gameControllerConnection;
+    std::array<std::unique_ptr<Strategy>, 3> m_strategy;
+    bool m_useInternalReferee = false;
+    bool m_useAutoref = false;
+    QSet<amun::PauseSimulatorReason> m_pauseReasons;
+};
+
+#endif // SIMULATIONPIPELINE_H
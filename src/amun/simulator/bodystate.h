@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef BODYSTATE_H
+#define BODYSTATE_H
+
+#include <btBulletDynamicsCommon.h>
+
+namespace camun {
+    namespace simulator {
+        struct BodyState;
+    }
+}
+
+// complete dynamic state of a rigid body, restoring it reproduces the motion of the body
+struct camun::simulator::BodyState
+{
+    btTransform transform;
+    btVector3 linearVelocity;
+    btVector3 angularVelocity;
+    int activationState;
+    btScalar deactivationTime;
+
+    static BodyState save(const btRigidBody *body)
+    {
+        return BodyState{body->getWorldTransform(), body->getLinearVelocity(), body->getAngularVelocity(),
+                    body->getActivationState(), body->getDeactivationTime()};
+    }
+
+    void restore(btRigidBody *body) const
+    {
+        body->setWorldTransform(transform);
+        body->setInterpolationWorldTransform(transform);
+        if (body->getMotionState()) {
+            body->getMotionState()->setWorldTransform(transform);
+        }
+        body->setLinearVelocity(linearVelocity);
+        body->setAngularVelocity(angularVelocity);
+        body->setInterpolationLinearVelocity(linearVelocity);
+        body->setInterpolationAngularVelocity(angularVelocity);
+        body->clearForces();
+        body->forceActivationState(activationState);
+        body->setDeactivationTime(deactivationTime);
+    }
+};
+
+#endif // BODYSTATE_H
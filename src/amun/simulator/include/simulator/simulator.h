@@ -24,17 +24,18 @@
 #include "protobuf/command.h"
 #include "protobuf/status.h"
 #include "protobuf/sslsim.h"
+#include "protobuf/ssl_wrapper.pb.h"
 #include <QList>
 #include <QMap>
 #include <QPair>
 #include <QQueue>
 #include <QByteArray>
+#include <memory>
 #include <tuple>
 #include <random>
 
 // higher values break the rolling friction of the ball
 const float SIMULATOR_SCALE = 10.0f;
-const float SUB_TIMESTEP = 1/200.f;
 const float COLLISION_MARGIN = 0.04f;
 const unsigned FOCAL_LENGTH = 390;
 
@@ -64,6 +65,7 @@ class camun::simulator::Simulator : public QObject
 
 public:
     typedef QMap<unsigned int, QPair<SimRobot*, unsigned int>> RobotMap; /*First int: ID, Second int: Generation*/
+    struct Snapshot;
 
     explicit Simulator(const Timer *timer, const amun::SimulatorSetup &setup, bool useManualTrigger = false);
     ~Simulator() override;
@@ -71,12 +73,19 @@ public:
     Simulator& operator=(const Simulator&) = delete;
     void handleSimulatorTick(double timeStep);
     void seedPRGN(uint32_t seed);
+    // the snapshot can be restored into every simulator created with the same setup,
+    // the timer has to be reset to the time of the snapshot by the caller
+    std::shared_ptr<const Snapshot> snapshot() const;
+    void restore(const Snapshot &snapshot);
 
 signals:
     void gotPacket(const QByteArray &data, qint64 time, QString sender);
+    // in-process alternative to gotPacket, the packets are only serialized if gotPacket is connected
+    void gotVisionPackets(const QList<SSL_WrapperPacket> &packets, qint64 time, QString sender);
     void sendStatus(const Status &status);
     void sendRadioResponses(const QList<robot::RadioResponse> &responses);
     void sendRealData(const QByteArray& data); // sends amun::SimulatorState
+    void sendRealState(const world::SimulatorState &state); // in-process alternative to sendRealData
     void sendSSLSimError(const QList<SSLSimError>& errors, ErrorSource source);
 
 public slots:
@@ -90,12 +99,17 @@ public slots:
     void process();
 
 private slots:
-    void sendVisionPacket();
+    void sendDueVisionPackets();
 
 private:
+    // packets for all cameras, ground truth, send time
+    typedef std::tuple<QList<SSL_WrapperPacket>, world::SimulatorState, qint64> VisionPacket;
+
     void sendSSLSimErrorInternal(ErrorSource source);
     void resetFlipped(RobotMap &robots, float side);
-    std::tuple<QList<QByteArray>, QByteArray, qint64> createVisionPacket();
+    VisionPacket createVisionPacket();
+    void sendVisionPacket();
+    void scheduleVisionPacket();
     void resetVisionPackets();
     void setTeam(RobotMap &list, float side, const robot::Team &team, QMap<uint32_t, robot::Specs>& specs);
     void moveBall(const sslsim::TeleportBall &ball);
@@ -107,8 +121,9 @@ private:
     typedef std::tuple<SSLSimRobotControl, qint64, bool> RadioCommand;
     SimulatorData *m_data;
     QQueue<RadioCommand> m_radioCommands;
-    QQueue<std::tuple<QList<QByteArray>, QByteArray, qint64>> m_visionPackets;
-    QQueue<QTimer *> m_visionTimers;
+    QQueue<VisionPacket> m_visionPackets;
+    // fires for the oldest pending vision packet, the send times are increasing
+    QTimer *m_visionTimer;
     bool m_isPartial;
     const Timer *m_timer;
     QTimer *m_trigger;
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "robotshapecache.h"
+#include "mesh.h"
+#include "simulator.h"
+#include <btBulletDynamicsCommon.h>
+
+using namespace camun::simulator;
+
+RobotShapes::RobotShapes(const robot::Specs &specs)
+{
+    m_body = new btCompoundShape;
+    btTransform robotShapeTransform;
+    robotShapeTransform.setIdentity();
+
+    // subtract collision margin from dimensions
+    Mesh mesh(specs.radius() - COLLISION_MARGIN / SIMULATOR_SCALE,
+              specs.height() - 2 * COLLISION_MARGIN / SIMULATOR_SCALE, specs.angle(), 0.04f, specs.dribbler_height() + 0.02f);
+    for (const QList<QVector3D> & hullPart : mesh.hull()) {
+        btConvexHullShape* hullPartShape = new btConvexHullShape;
+        m_shapes.append(hullPartShape);
+        for (const QVector3D& v : hullPart) {
+            // the bounding box is only computed once all points are known
+            hullPartShape->addPoint(btVector3(v.x(), v.y(), v.z()) * SIMULATOR_SCALE, false);
+        }
+        hullPartShape->recalcLocalAabb();
+        m_body->addChildShape(robotShapeTransform, hullPartShape);
+    }
+    m_shapes.append(m_body);
+
+    m_dribbler = new btCylinderShapeX(btVector3(specs.dribbler_width() / 2.0f, 0.007f, 0.007f) * SIMULATOR_SCALE);
+    m_shapes.append(m_dribbler);
+}
+
+RobotShapes::~RobotShapes()
+{
+    qDeleteAll(m_shapes);
+}
+
+std::shared_ptr<const RobotShapes> RobotShapeCache::shapes(const robot::Specs &specs)
+{
+    const Key key(specs.radius(), specs.height(), specs.angle(), specs.dribbler_height(), specs.dribbler_width());
+    std::shared_ptr<const RobotShapes> shapes = m_shapes[key].lock();
+    if (shapes) {
+        return shapes;
+    }
+
+    // drop the entries of specs that are no longer used by any robot
+    for (auto it = m_shapes.begin(); it != m_shapes.end();) {
+        if (it->second.expired() && it->first != key) {
+            it = m_shapes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    shapes = std::make_shared<const RobotShapes>(specs);
+    m_shapes[key] = shapes;
+    return shapes;
+}
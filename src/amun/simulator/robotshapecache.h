@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef ROBOTSHAPECACHE_H
+#define ROBOTSHAPECACHE_H
+
+#include "protobuf/robot.pb.h"
+#include <QList>
+#include <map>
+#include <memory>
+#include <tuple>
+
+class btCollisionShape;
+class btCompoundShape;
+class btCylinderShape;
+
+namespace camun {
+    namespace simulator {
+        class RobotShapes;
+        class RobotShapeCache;
+    }
+}
+
+// collision shapes of a robot, these are never modified after construction
+// and thus can be shared by all robots with the same geometry
+class camun::simulator::RobotShapes
+{
+public:
+    explicit RobotShapes(const robot::Specs &specs);
+    ~RobotShapes();
+    RobotShapes(const RobotShapes&) = delete;
+    RobotShapes& operator=(const RobotShapes&) = delete;
+
+    // bullet only accepts non const shapes, they must not be modified nonetheless
+    btCompoundShape *body() const { return m_body; }
+    btCylinderShape *dribbler() const { return m_dribbler; }
+
+private:
+    btCompoundShape *m_body;
+    btCylinderShape *m_dribbler;
+    QList<btCollisionShape*> m_shapes;
+};
+
+// the shapes are owned by the robots using them and are freed with the last of them
+class camun::simulator::RobotShapeCache
+{
+public:
+    std::shared_ptr<const RobotShapes> shapes(const robot::Specs &specs);
+
+private:
+    // radius, height, angle, dribbler height and dribbler width
+    typedef std::tuple<float, float, float, float, float> Key;
+    std::map<Key, std::weak_ptr<const RobotShapes>> m_shapes;
+};
+
+#endif // ROBOTSHAPECACHE_H
@@ -67,7 +67,7 @@ SimBall::~SimBall()
     delete m_motionState;
 }
 
-void SimBall::begin()
+void SimBall::begin(btScalar timeStep)
 {
     // custom implementation of rolling friction
     const btVector3 p = m_body->getWorldTransform().getOrigin();
@@ -85,7 +85,7 @@ void SimBall::begin()
             const btScalar rollingDeceleration = hackFactor * 0.35;
             btVector3 force(velocity.x(), velocity.y(), 0.0f);
             force.safeNormalize();
-            m_body->applyCentralImpulse(-force * rollingDeceleration * SIMULATOR_SCALE * BALL_MASS * SUB_TIMESTEP);
+            m_body->applyCentralImpulse(-force * rollingDeceleration * SIMULATOR_SCALE * BALL_MASS * timeStep);
         }
     }
 
@@ -337,6 +337,17 @@ void SimBall::restoreState(const world::SimBall &ball)
     m_body->setAngularVelocity(angular);
 }
 
+SimBall::State SimBall::state() const
+{
+    return State{BodyState::save(m_body), m_move};
+}
+
+void SimBall::restoreState(const State &state)
+{
+    state.body.restore(m_body);
+    m_move = state.move;
+}
+
 bool SimBall::isInvalid() const
 {
     const btTransform transform = m_body->getWorldTransform();
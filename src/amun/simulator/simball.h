@@ -25,6 +25,7 @@
 #include "protobuf/sslsim.h"
 #include <btBulletDynamicsCommon.h>
 #include "simfield.h"
+#include "bodystate.h"
 #include <QObject>
 
 static const float BALL_RADIUS = 0.0215f;
@@ -50,11 +51,17 @@ public:
     SimBall(const SimBall&) = delete;
     SimBall& operator=(const SimBall&) = delete;
 
+    struct State
+    {
+        BodyState body;
+        sslsim::TeleportBall move;
+    };
+
 signals:
     void sendSSLSimError(const SSLSimError& error, ErrorSource s);
 
 public:
-    void begin();
+    void begin(btScalar timeStep);
     bool update(SSL_DetectionBall *ball, float stddev, float stddevArea, const btVector3 &cameraPosition,
                bool enableInvisibleBall, float visibilityThreshold, btVector3 positionOffset);
     void move(const sslsim::TeleportBall &ball);
@@ -64,6 +71,8 @@ public:
     btVector3 speed() const;
     void writeBallState(world::SimBall *ball) const;
     void restoreState(const world::SimBall &ball);
+    State state() const;
+    void restoreState(const State &state);
     btRigidBody *body() const { return m_body; }
     bool isInvalid() const;
 
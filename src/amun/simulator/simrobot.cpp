@@ -20,7 +20,7 @@
 
 #include "core/rng.h"
 #include "core/coordinates.h"
-#include "mesh.h"
+#include "robotshapecache.h"
 #include "protobuf/ssl_detection.pb.h"
 #include "simball.h"
 #include "simrobot.h"
@@ -38,10 +38,11 @@ float boundSpeed(float speed)
 }
 
 
-SimRobot::SimRobot(RNG *rng, const robot::Specs &specs, btDiscreteDynamicsWorld *world, const btVector3 &pos, float dir) :
+SimRobot::SimRobot(RNG *rng, const robot::Specs &specs, std::shared_ptr<const RobotShapes> shapes, btDiscreteDynamicsWorld *world, const btVector3 &pos, float dir) :
     m_rng(rng),
     m_specs(specs),
     m_world(world),
+    m_shapes(std::move(shapes)),
     m_charge(false),
     m_isCharged(false),
     m_inStandby(false),
@@ -52,22 +53,7 @@ SimRobot::SimRobot(RNG *rng, const robot::Specs &specs, btDiscreteDynamicsWorld
     error_sum_omega(0)
 {
 
-    btCompoundShape * wholeShape = new btCompoundShape;
-    btTransform robotShapeTransform;
-    robotShapeTransform.setIdentity();
-
-    // subtract collision margin from dimensions
-    Mesh mesh(m_specs.radius() - COLLISION_MARGIN / SIMULATOR_SCALE,
-              m_specs.height() - 2 * COLLISION_MARGIN / SIMULATOR_SCALE, m_specs.angle(), 0.04f, m_specs.dribbler_height() + 0.02f);
-    for (const QList<QVector3D> & hullPart : mesh.hull()) {
-        btConvexHullShape* hullPartShape = new btConvexHullShape;
-        m_shapes.append(hullPartShape);
-        for (const QVector3D& v : hullPart) {
-            hullPartShape->addPoint(btVector3(v.x(), v.y(), v.z()) * SIMULATOR_SCALE);
-        }
-        wholeShape->addChildShape(robotShapeTransform, hullPartShape);
-    }
-    m_shapes.append(wholeShape);
+    btCompoundShape * wholeShape = m_shapes->body();
 
     btTransform startWorldTransform;
     startWorldTransform.setIdentity();
@@ -88,8 +74,7 @@ SimRobot::SimRobot(RNG *rng, const robot::Specs &specs, btDiscreteDynamicsWorld
     m_body->setFriction(0.22f);
     m_world->addRigidBody(m_body);
 
-    btCylinderShape * dribblerShape = new btCylinderShapeX(btVector3(m_specs.dribbler_width() / 2.0f, 0.007f, 0.007f) * SIMULATOR_SCALE);
-    m_shapes.append(dribblerShape);
+    btCylinderShape * dribblerShape = m_shapes->dribbler();
     // WARNING: hack, instead of 0.02 should be the dribbler height
     // the ball seems to get instable if the dribbler is at correct height
     // possibly the ball gets 'sucked' onto the robot
@@ -137,7 +122,6 @@ SimRobot::~SimRobot()
     delete m_body;
     delete m_dribblerBody;
     delete m_motionState;
-    qDeleteAll(m_shapes);
 }
 
 void SimRobot::calculateDribblerMove(const btVector3 pos, const btQuaternion rot, const btVector3 linVel, float omega)
@@ -206,6 +190,13 @@ void SimRobot::setDribbleMode(bool perfectDribbler)
     m_perfectDribbler = perfectDribbler;
 }
 
+void SimRobot::setSleepingSpeed(float speed)
+{
+    // the robot and its dribbler form a single simulation island, which only sleeps as a whole
+    m_body->setSleepingThresholds(speed * SIMULATOR_SCALE, m_body->getAngularSleepingThreshold());
+    m_dribblerBody->setSleepingThresholds(speed * SIMULATOR_SCALE, m_dribblerBody->getAngularSleepingThreshold());
+}
+
 bool SimRobot::handleMoveCommand()
 {
     auto sendPartialCoordError = [this](const std::string& msg){
@@ -700,6 +691,32 @@ void SimRobot::restoreState(const world::SimRobot &robot)
     m_body->setAngularVelocity(angular);
 }
 
+SimRobot::State SimRobot::state() const
+{
+    return State{BodyState::save(m_body), BodyState::save(m_dribblerBody), m_move, m_sslCommand,
+                m_charge, m_isCharged, m_inStandby, m_shootTime, m_commandTime,
+                error_sum_v_s, error_sum_v_f, error_sum_omega, m_lastSendTime};
+}
+
+void SimRobot::restoreState(const State &state)
+{
+    // the dribbling constraints are rebuilt on the next tick if the robot still dribbles
+    stopDribbling();
+    state.body.restore(m_body);
+    state.dribblerBody.restore(m_dribblerBody);
+    m_move = state.move;
+    m_sslCommand = state.sslCommand;
+    m_charge = state.charge;
+    m_isCharged = state.isCharged;
+    m_inStandby = state.inStandby;
+    m_shootTime = state.shootTime;
+    m_commandTime = state.commandTime;
+    error_sum_v_s = state.errorSumVS;
+    error_sum_v_f = state.errorSumVF;
+    error_sum_omega = state.errorSumOmega;
+    m_lastSendTime = state.lastSendTime;
+}
+
 void SimRobot::move(const sslsim::TeleportRobot &robot)
 {
     m_move = robot;
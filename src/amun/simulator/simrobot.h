@@ -23,7 +23,9 @@
 
 #include "protobuf/robot.pb.h"
 #include "protobuf/sslsim.h"
+#include "bodystate.h"
 #include <QList>
+#include <memory>
 #include <Eigen/Dense>
 #include <Eigen/QR>
 #include <btBulletDynamicsCommon.h>
@@ -35,6 +37,7 @@ namespace camun {
     namespace simulator {
         class SimBall;
         class SimRobot;
+        class RobotShapes;
         enum class ErrorSource;
     }
 }
@@ -43,11 +46,30 @@ class camun::simulator::SimRobot: public QObject
 {
     Q_OBJECT
 public:
-    SimRobot(RNG *rng, const robot::Specs &specs, btDiscreteDynamicsWorld *world, const btVector3 &pos, float dir);
+    // the shapes must have been created for the same specs
+    SimRobot(RNG *rng, const robot::Specs &specs, std::shared_ptr<const RobotShapes> shapes, btDiscreteDynamicsWorld *world, const btVector3 &pos, float dir);
     ~SimRobot();
     SimRobot(const SimRobot&) = delete;
     SimRobot& operator=(const SimRobot&) = delete;
 
+    // everything that changes while simulating, the specs are not included
+    struct State
+    {
+        BodyState body;
+        BodyState dribblerBody;
+        sslsim::TeleportRobot move;
+        sslsim::RobotCommand sslCommand;
+        bool charge;
+        bool isCharged;
+        bool inStandby;
+        double shootTime;
+        double commandTime;
+        float errorSumVS;
+        float errorSumVF;
+        float errorSumOmega;
+        qint64 lastSendTime;
+    };
+
 signals:
     void sendSSLSimError(const SSLSimError& error, ErrorSource s);
 
@@ -59,12 +81,16 @@ public:
     void update(SSL_DetectionRobot *robot, float stddev_p, float stddev_phi, qint64 time, btVector3 positionOffset);
     void update(world::SimRobot *robot, SimBall *ball) const;
     void restoreState(const world::SimRobot &robot);
+    State state() const;
+    void restoreState(const State &state);
     void move(const sslsim::TeleportRobot &robot);
     bool isFlipped();
     btVector3 position() const;
     btVector3 dribblerCorner(bool left) const;
     qint64 getLastSendTime() const { return m_lastSendTime; }
     void setDribbleMode(bool perfectDribbler);
+    // in m/s
+    void setSleepingSpeed(float speed);
     void stopDribbling();
 
     const robot::Specs& specs() const { return m_specs; }
@@ -86,7 +112,7 @@ private:
     btRigidBody * m_body;
     btRigidBody * m_dribblerBody;
     btHingeConstraint *m_dribblerConstraint;
-    QList<btCollisionShape*> m_shapes;
+    std::shared_ptr<const RobotShapes> m_shapes;
     btMotionState * m_motionState;
     btVector3 m_dribblerCenter;
     std::unique_ptr<btPoint2PointConstraint> m_holdBallConstraint;
@@ -21,6 +21,7 @@
 #include "simulator.h"
 #include "core/rng.h"
 #include "core/timer.h"
+#include "core/tracing.h"
 #include "core/coordinates.h"
 #include "protobuf/ssl_wrapper.pb.h"
 #include "protobuf/geometry.h"
@@ -28,8 +29,11 @@
 #include "simfield.h"
 #include "simrobot.h"
 #include "erroraggregator.h"
+#include "robotshapecache.h"
+#include <QMetaMethod>
 #include <QTimer>
 #include <algorithm>
+#include <cmath>
 #include <QtDebug>
 #include <QVector>
 #include <cstdint>
@@ -63,24 +67,18 @@ using namespace camun::simulator;
  * => f_b = 1; f_f = 0.35; f_r = 0.22
  */
 
-struct camun::simulator::SimulatorData
+// exposes the remainder of the fixed sub steps, which is part of the simulation state
+class SimDynamicsWorld : public btDiscreteDynamicsWorld
+{
+public:
+    using btDiscreteDynamicsWorld::btDiscreteDynamicsWorld;
+    btScalar localTime() const { return m_localTime; }
+    void setLocalTime(btScalar localTime) { m_localTime = localTime; }
+};
+
+// settings which are changed by the realism config
+struct SimulatorRealism
 {
-    RNG rng;
-    btDefaultCollisionConfiguration *collision;
-    btCollisionDispatcher *dispatcher;
-    btBroadphaseInterface *overlappingPairCache;
-    btSequentialImpulseConstraintSolver *solver;
-    btDiscreteDynamicsWorld *dynamicsWorld;
-    world::Geometry geometry;
-    QVector<SSL_GeometryCameraCalibration> reportedCameraSetup;
-    QVector<btVector3> cameraPositions;
-    SimField *field;
-    SimBall *ball;
-    Simulator::RobotMap robotsBlue;
-    Simulator::RobotMap robotsYellow;
-    QMap<uint32_t, robot::Specs> specsBlue;
-    QMap<uint32_t, robot::Specs> specsYellow;
-    bool flip;
     float stddevBall;
     float stddevBallArea;
     float stddevRobot;
@@ -99,6 +97,59 @@ struct camun::simulator::SimulatorData
     uint64_t commandDelay;
 };
 
+struct camun::simulator::SimulatorData : public SimulatorRealism
+{
+    RNG rng;
+    btDefaultCollisionConfiguration *collision;
+    btCollisionDispatcher *dispatcher;
+    btBroadphaseInterface *overlappingPairCache;
+    btSequentialImpulseConstraintSolver *solver;
+    SimDynamicsWorld *dynamicsWorld;
+    world::Geometry geometry;
+    QVector<SSL_GeometryCameraCalibration> reportedCameraSetup;
+    QVector<btVector3> cameraPositions;
+    SimField *field;
+    SimBall *ball;
+    Simulator::RobotMap robotsBlue;
+    Simulator::RobotMap robotsYellow;
+    QMap<uint32_t, robot::Specs> specsBlue;
+    QMap<uint32_t, robot::Specs> specsYellow;
+    // robots with the same geometry share their collision shapes
+    RobotShapeCache shapeCache;
+    // from the performance profile
+    btScalar subTimestep;
+    int maxSubSteps;
+    float robotSleepingSpeed;
+    bool flip;
+};
+
+struct Simulator::Snapshot
+{
+    typedef QMap<unsigned int, SimRobot::State> RobotStates;
+
+    RNG rng;
+    std::mt19937 shuffleRng;
+    btScalar localTime;
+    SimBall::State ball;
+    RobotStates robotsBlue;
+    RobotStates robotsYellow;
+    QMap<uint32_t, robot::Specs> specsBlue;
+    QMap<uint32_t, robot::Specs> specsYellow;
+    SimulatorRealism realism;
+    bool flip;
+    bool charge;
+    QQueue<RadioCommand> radioCommands;
+    QQueue<VisionPacket> visionPackets;
+    qint64 time;
+    qint64 lastSentStatusTime;
+    qint64 visionDelay;
+    qint64 visionProcessingTime;
+    qint64 minRobotDetectionTime;
+    qint64 minBallDetectionTime;
+    qint64 lastBallSendTime;
+    std::map<qint64, unsigned> lastFrameNumber;
+};
+
 static void simulatorTickCallback(btDynamicsWorld *world, btScalar timeStep)
 {
     Simulator *sim = reinterpret_cast<Simulator *>(world->getWorldUserInfo());
@@ -131,15 +182,37 @@ Simulator::Simulator(const Timer *timer, const amun::SimulatorSetup &setup, bool
         connect(m_trigger, SIGNAL(timeout()), SLOT(process()));
     }
 
+    // a single timer for all delayed vision packets
+    m_visionTimer = new QTimer(this);
+    m_visionTimer->setTimerType(Qt::PreciseTimer);
+    m_visionTimer->setSingleShot(true);
+    connect(m_visionTimer, SIGNAL(timeout()), SLOT(sendDueVisionPackets()));
+
     // setup bullet
     m_data = new SimulatorData;
     m_data->collision = new btDefaultCollisionConfiguration();
     m_data->dispatcher = new btCollisionDispatcher(m_data->collision);
-    m_data->overlappingPairCache = new btDbvtBroadphase();
+    const amun::SimulatorPerformanceProfile &performance = setup.performance();
+    if (performance.broadphase() == amun::SimulatorPerformanceProfile::AXIS_SWEEP) {
+        // only a few objects move inside the closed field area, leave some space for robots teleported outside
+        const world::Geometry &geometry = setup.geometry();
+        const float halfSize = std::max(geometry.field_width(), geometry.field_height()) / 2.0f + geometry.boundary_width() + 1.0f;
+        const btVector3 worldMin = btVector3(-halfSize, -halfSize, -1.0f) * SIMULATOR_SCALE;
+        const btVector3 worldMax = btVector3(halfSize, halfSize, 10.0f) * SIMULATOR_SCALE;
+        m_data->overlappingPairCache = new btAxisSweep3(worldMin, worldMax, 1024);
+    } else {
+        m_data->overlappingPairCache = new btDbvtBroadphase();
+    }
     m_data->solver = new btSequentialImpulseConstraintSolver;
-    m_data->dynamicsWorld = new btDiscreteDynamicsWorld(m_data->dispatcher, m_data->overlappingPairCache, m_data->solver, m_data->collision);
+    m_data->dynamicsWorld = new SimDynamicsWorld(m_data->dispatcher, m_data->overlappingPairCache, m_data->solver, m_data->collision);
     m_data->dynamicsWorld->setGravity(btVector3(0.0f, 0.0f, -9.81f * SIMULATOR_SCALE));
     m_data->dynamicsWorld->setInternalTickCallback(simulatorTickCallback, this, true);
+    m_data->dynamicsWorld->getSolverInfo().m_numIterations = std::max(1u, performance.solver_iterations());
+    m_data->subTimestep = 1.0f / std::max(performance.sub_step_rate(), 1.0f);
+    // catch up at most 50 ms per call to process, just like with the default sub step rate
+    m_data->maxSubSteps = std::max(1, qRound(0.05f * performance.sub_step_rate()));
+    // negative values keep the bullet default, which matches the default profile up to rounding
+    m_data->robotSleepingSpeed = performance.has_robot_sleeping_speed() ? performance.robot_sleeping_speed() : -1.0f;
 
     m_data->geometry.CopyFrom(setup.geometry());
     for (const auto& camera : setup.camera_setup()) {
@@ -208,6 +281,7 @@ void Simulator::process()
     const qint64 start_time = Timer::systemTime();
 
     const qint64 current_time = m_timer->currentTime();
+    TraceSpan span("Simulator::process", current_time);
 
     // first: send vision packets in partial mode
     if (m_isPartial) {
@@ -268,31 +342,24 @@ void Simulator::process()
 
     // simulate to current strategy time
     double timeDelta = (current_time - m_time) * 1E-9;
-    m_data->dynamicsWorld->stepSimulation(timeDelta, 10, SUB_TIMESTEP);
+    m_data->dynamicsWorld->stepSimulation(timeDelta, m_data->maxSubSteps, m_data->subTimestep);
     m_time = current_time;
 
     // only send a vision packet every third frame = 15 ms - epsilon (=half frame)
     // gives a vision frequency of 66.67Hz
     if (m_lastSentStatusTime + 12500000 <= m_time) {
-        auto data = createVisionPacket();
-
-
+        VisionPacket data = createVisionPacket();
 
         if (m_isPartial) {
             std::get<2>(data) = m_time + m_visionDelay;
-            m_visionPackets.enqueue(data);
+            m_visionPackets.enqueue(std::move(data));
         } else {
-            m_visionPackets.enqueue(data);
-            // timeout is in milliseconds
-            int timeout = m_visionDelay * 1E-6 / m_timeScaling;
-
-            // send after timeout, default timer mode, may jitter a bit
-            QTimer *timer = new QTimer();
-            timer->setTimerType(Qt::PreciseTimer);
-            timer->setSingleShot(true);
-            connect(timer, SIGNAL(timeout()), SLOT(sendVisionPacket()));
-            timer->start(timeout);
-            m_visionTimers.enqueue(timer);
+            // send after the vision delay in real time, may jitter a bit
+            std::get<2>(data) = Timer::systemTime() + qint64(m_visionDelay / m_timeScaling);
+            m_visionPackets.enqueue(std::move(data));
+            if (!m_visionTimer->isActive()) {
+                scheduleVisionPacket();
+            }
         }
 
         m_lastSentStatusTime = m_time;
@@ -313,10 +380,14 @@ void Simulator::sendSSLSimErrorInternal(ErrorSource source)
 
 static void createRobot(Simulator::RobotMap &list, float x, float y, uint32_t id, const ErrorAggregator* agg, SimulatorData* data, const QMap<uint32_t, robot::Specs>& teamSpecs)
 {
-    SimRobot *robot = new SimRobot(&data->rng, teamSpecs[id], data->dynamicsWorld, btVector3(x, y, 0), 0.f);
+    const robot::Specs &specs = teamSpecs[id];
+    SimRobot *robot = new SimRobot(&data->rng, specs, data->shapeCache.shapes(specs), data->dynamicsWorld, btVector3(x, y, 0), 0.f);
     robot->setDribbleMode(data->dribblePerfect);
+    if (data->robotSleepingSpeed >= 0) {
+        robot->setSleepingSpeed(data->robotSleepingSpeed);
+    }
     robot->connect(robot, &SimRobot::sendSSLSimError, agg, &ErrorAggregator::aggregate);
-    list[id] = {robot, teamSpecs[id].generation()};
+    list[id] = {robot, specs.generation()};
 
 }
 
@@ -329,10 +400,14 @@ void Simulator::resetFlipped(Simulator::RobotMap &robots, float side)
     for (RobotMap::iterator it = robots.begin(); it != robots.end(); ++it) {
         SimRobot *robot = it.value().first;
         if (robot->isFlipped()) {
-            SimRobot *new_robot = new SimRobot(&m_data->rng, robot->specs(), m_data->dynamicsWorld, btVector3(x, side * y, 0), 0.0f);
+            SimRobot *new_robot = new SimRobot(&m_data->rng, robot->specs(), m_data->shapeCache.shapes(robot->specs()),
+                                               m_data->dynamicsWorld, btVector3(x, side * y, 0), 0.0f);
             delete robot;
             connect(new_robot, &SimRobot::sendSSLSimError, m_aggregator, &ErrorAggregator::aggregate); // TODO? use createRobot instead of this. However, doing so naively will break the iteration, so I left it for now.
             new_robot->setDribbleMode(m_data->dribblePerfect);
+            if (m_data->robotSleepingSpeed >= 0) {
+                new_robot->setSleepingSpeed(m_data->robotSleepingSpeed);
+            }
             it.value().first = new_robot;
         }
         y -= 0.3;
@@ -353,7 +428,7 @@ void Simulator::handleSimulatorTick(double timeStep)
     }
 
     // apply commands and forces to ball and robots
-    m_data->ball->begin();
+    m_data->ball->begin(timeStep);
     for(const auto& pair : m_data->robotsBlue) {
         pair.first->begin(m_data->ball, timeStep);
     }
@@ -403,7 +478,7 @@ static btVector3 positionOffsetForCamera(float offsetStrength, btVector3 cameraP
     return btVector3(cameraPos.x(), cameraPos.y(), 0).normalized() * offsetStrength;
 }
 
-std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket()
+Simulator::VisionPacket Simulator::createVisionPacket()
 {
     const std::size_t numCameras = m_data->reportedCameraSetup.size();
     world::SimulatorState simState;
@@ -488,7 +563,7 @@ std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket(
         }
     }
 
-    std::vector<SSL_WrapperPacket> packets;
+    QList<SSL_WrapperPacket> packets;
     packets.reserve(numCameras);
 
     // add a wrapper packet for all detections (also for empty ones).
@@ -532,45 +607,62 @@ std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket(
     geometry->mutable_models()->mutable_chip_fixed_loss()->set_damping_xy_first_hop(0.715);
     geometry->mutable_models()->mutable_chip_fixed_loss()->set_damping_xy_other_hops(1);
 
-    // serialize "vision packet"
-    QList<QByteArray> data;
-    for (std::size_t i = 0; i < packets.size(); ++i) {
-        QByteArray d;
-        d.resize(packets[i].ByteSize());
-        if (packets[i].SerializeToArray(d.data(), d.size())) {
-            data.push_back(d);
-        } else {
-            data.push_back(QByteArray());
+    // serialization is deferred until sending, in-process receivers can use the structs directly
+    return VisionPacket(packets, simState, 0);
+}
+
+void Simulator::sendVisionPacket()
+{
+    const VisionPacket currentVisionPackets = m_visionPackets.dequeue();
+    const qint64 receiveTime = m_timer->currentTime();
+    // send "vision packet" and assume instant receiving
+    // the receive time may be a bit jittered just like a real transmission
+    emit gotVisionPackets(std::get<0>(currentVisionPackets), receiveTime, "simulator");
+    if (isSignalConnected(QMetaMethod::fromSignal(&Simulator::gotPacket))) {
+        for (const SSL_WrapperPacket &packet : std::get<0>(currentVisionPackets)) {
+            QByteArray data;
+            data.resize(packet.ByteSize());
+            if (!packet.SerializeToArray(data.data(), data.size())) {
+                data = {};
+            }
+            emit gotPacket(data, receiveTime, "simulator");
         }
     }
 
-    QByteArray d;
-    d.resize(simState.ByteSize());
-    if (!simState.SerializeToArray(d.data(), d.size())) {
-        d = {};
+    const world::SimulatorState &simState = std::get<1>(currentVisionPackets);
+    emit sendRealState(simState);
+    if (isSignalConnected(QMetaMethod::fromSignal(&Simulator::sendRealData))) {
+        QByteArray data;
+        data.resize(simState.ByteSize());
+        if (!simState.SerializeToArray(data.data(), data.size())) {
+            data = {};
+        }
+        emit sendRealData(data);
     }
-    return {data,d, 0};
 }
 
-void Simulator::sendVisionPacket()
+void Simulator::sendDueVisionPackets()
 {
-    auto currentVisionPackets = m_visionPackets.dequeue();
-    for (const QByteArray &data : std::get<0>(currentVisionPackets)) {
-        emit gotPacket(data, m_timer->currentTime(), "simulator"); // send "vision packet" and assume instant receiving
-        // the receive time may be a bit jittered just like a real transmission
-
+    const qint64 now = Timer::systemTime();
+    while (!m_visionPackets.isEmpty() && std::get<2>(m_visionPackets.head()) <= now) {
+        sendVisionPacket();
     }
-    emit sendRealData(std::get<1>(currentVisionPackets));
-    if (!m_isPartial) {
-        QTimer *timer = m_visionTimers.dequeue();
-        timer->deleteLater();
+    scheduleVisionPacket();
+}
+
+void Simulator::scheduleVisionPacket()
+{
+    if (m_visionPackets.isEmpty()) {
+        return;
     }
+    const qint64 delay = std::get<2>(m_visionPackets.head()) - Timer::systemTime();
+    // round up, a timeout of 0 ms would fire again before the packet is due
+    m_visionTimer->start(std::max<qint64>(0, (delay + 999999) / 1000000));
 }
 
 void Simulator::resetVisionPackets()
 {
-    qDeleteAll(m_visionTimers);
-    m_visionTimers.clear();
+    m_visionTimer->stop();
     m_visionPackets.clear();
 }
 
@@ -582,6 +674,13 @@ void Simulator::handleRadioCommands(const SSLSimRobotControl &commands, bool isB
 
 void Simulator::setTeam(Simulator::RobotMap &list, float side, const robot::Team &team, QMap<uint32_t, robot::Specs>& teamSpecs)
 {
+    // the shapes are freed with the last robot using them, hold the ones of the new team
+    // while the old team is removed, so that an unchanged geometry does not rebuild them
+    QVector<std::shared_ptr<const RobotShapes>> newShapes;
+    for (const robot::Specs &specs : team.robot()) {
+        newShapes.append(m_data->shapeCache.shapes(specs));
+    }
+
     // remove old team
     deleteAll(list);
     list.clear();
@@ -902,6 +1001,117 @@ void Simulator::seedPRGN(uint32_t seed)
     m_data->rng.seed(seed);
 }
 
+static Simulator::Snapshot::RobotStates robotStates(const Simulator::RobotMap &robots)
+{
+    Simulator::Snapshot::RobotStates states;
+    for (auto it = robots.begin(); it != robots.end(); ++it) {
+        states[it.key()] = it.value().first->state();
+    }
+    return states;
+}
+
+std::shared_ptr<const Simulator::Snapshot> Simulator::snapshot() const
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->rng = m_data->rng;
+    snapshot->shuffleRng = rand_shuffle_src;
+    snapshot->localTime = m_data->dynamicsWorld->localTime();
+    snapshot->ball = m_data->ball->state();
+    snapshot->robotsBlue = robotStates(m_data->robotsBlue);
+    snapshot->robotsYellow = robotStates(m_data->robotsYellow);
+    snapshot->specsBlue = m_data->specsBlue;
+    snapshot->specsYellow = m_data->specsYellow;
+    snapshot->realism = *m_data;
+    snapshot->flip = m_data->flip;
+    snapshot->charge = m_charge;
+    snapshot->radioCommands = m_radioCommands;
+    if (m_isPartial) {
+        // pending packets of the timer based mode are dropped, just like on a scaling change
+        snapshot->visionPackets = m_visionPackets;
+    }
+    snapshot->time = m_time;
+    snapshot->lastSentStatusTime = m_lastSentStatusTime;
+    snapshot->visionDelay = m_visionDelay;
+    snapshot->visionProcessingTime = m_visionProcessingTime;
+    snapshot->minRobotDetectionTime = m_minRobotDetectionTime;
+    snapshot->minBallDetectionTime = m_minBallDetectionTime;
+    snapshot->lastBallSendTime = m_lastBallSendTime;
+    snapshot->lastFrameNumber = m_lastFrameNumber;
+    return snapshot;
+}
+
+static void restoreRobots(Simulator::RobotMap &list, const Simulator::Snapshot::RobotStates &states,
+                          const QMap<uint32_t, robot::Specs> &teamSpecs, const ErrorAggregator *agg, SimulatorData *data)
+{
+    // hold the shapes of the restored robots while the outdated ones are deleted
+    QVector<std::shared_ptr<const RobotShapes>> newShapes;
+    for (auto it = states.begin(); it != states.end(); ++it) {
+        if (teamSpecs.contains(it.key())) {
+            newShapes.append(data->shapeCache.shapes(teamSpecs[it.key()]));
+        }
+    }
+
+    // keep robots whose specs did not change, which avoids rebuilding their collision shapes
+    for (auto it = list.begin(); it != list.end(); ) {
+        SimRobot *robot = it.value().first;
+        if (states.contains(it.key()) && teamSpecs.contains(it.key())
+                && robot->specs().SerializeAsString() == teamSpecs[it.key()].SerializeAsString()) {
+            robot->setDribbleMode(data->dribblePerfect);
+            ++it;
+        } else {
+            delete robot;
+            it = list.erase(it);
+        }
+    }
+
+    for (auto it = states.begin(); it != states.end(); ++it) {
+        if (!list.contains(it.key())) {
+            createRobot(list, 0, 0, it.key(), agg, data, teamSpecs);
+        }
+        list[it.key()].first->restoreState(it.value());
+    }
+}
+
+void Simulator::restore(const Snapshot &snapshot)
+{
+    m_data->rng = snapshot.rng;
+    rand_shuffle_src = snapshot.shuffleRng;
+    static_cast<SimulatorRealism&>(*m_data) = snapshot.realism;
+    m_data->flip = snapshot.flip;
+    m_data->specsBlue = snapshot.specsBlue;
+    m_data->specsYellow = snapshot.specsYellow;
+    m_charge = snapshot.charge;
+
+    m_data->ball->restoreState(snapshot.ball);
+    restoreRobots(m_data->robotsBlue, snapshot.robotsBlue, m_data->specsBlue, m_aggregator, m_data);
+    restoreRobots(m_data->robotsYellow, snapshot.robotsYellow, m_data->specsYellow, m_aggregator, m_data);
+
+    // drop cached contacts and solver state, these depend on the history of the world
+    // and would otherwise make rollouts from the same snapshot diverge
+    SimDynamicsWorld *world = m_data->dynamicsWorld;
+    for (int i = 0; i < world->getNumCollisionObjects(); i++) {
+        btCollisionObject *object = world->getCollisionObjectArray()[i];
+        world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(object->getBroadphaseHandle(), world->getDispatcher());
+    }
+    world->getBroadphase()->resetPool(world->getDispatcher());
+    m_data->solver->reset();
+    world->setLocalTime(snapshot.localTime);
+
+    m_radioCommands = snapshot.radioCommands;
+    resetVisionPackets();
+    if (m_isPartial) {
+        m_visionPackets = snapshot.visionPackets;
+    }
+    m_time = snapshot.time;
+    m_lastSentStatusTime = snapshot.lastSentStatusTime;
+    m_visionDelay = snapshot.visionDelay;
+    m_visionProcessingTime = snapshot.visionProcessingTime;
+    m_minRobotDetectionTime = snapshot.minRobotDetectionTime;
+    m_minBallDetectionTime = snapshot.minBallDetectionTime;
+    m_lastBallSendTime = snapshot.lastBallSendTime;
+    m_lastFrameNumber = snapshot.lastFrameNumber;
+}
+
 static bool overlapCheck(const btVector3& p0, const float& r0, const btVector3& p1, const float& r1)
 {
     const float distance = (p1 - p0).length();
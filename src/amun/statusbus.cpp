@@ -0,0 +1,48 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "statusbus.h"
+#include "core/statusqueue.h"
+
+StatusBus::StatusBus(QObject *parent) :
+    QObject(parent)
+{ }
+
+StatusBus::~StatusBus() = default;
+
+void StatusBus::subscribe(const QString &name, QObject *context, Handler handler, Policy policy, int capacity)
+{
+    m_queues.push_back(std::make_shared<StatusQueue>(name, context, handler, policy, capacity));
+}
+
+QList<StatusBus::QueueMetrics> StatusBus::metrics(bool reset) const
+{
+    QList<QueueMetrics> result;
+    for (const auto &queue : m_queues) {
+        result.append(queue->metrics(reset));
+    }
+    return result;
+}
+
+void StatusBus::publish(const Status &status)
+{
+    for (const auto &queue : m_queues) {
+        queue->push(status);
+    }
+}
@@ -62,6 +62,8 @@ public:
     Strategy& operator=(const Strategy&) = delete;
     void resetIsReplay() { m_scriptState.isReplay = false; }
     void setEnabled(bool enable) { m_isEnabled = enable; }
+    // if set, a new status is only processed by calling tryProcess
+    void setManualTrigger(bool manual) { m_manualTrigger = manual; }
     void tryProcess();
 
     void compileIfNecessary(const QString &initFile);
@@ -125,6 +127,7 @@ private:
     bool m_autoReload;
     bool m_strategyFailed;
     bool m_isEnabled;
+    bool m_manualTrigger = false;
 
     std::unique_ptr<QUdpSocket> m_udpSenderSocket;
 
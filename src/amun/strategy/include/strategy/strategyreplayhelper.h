@@ -24,32 +24,39 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include <QObject>
+#include <memory>
 
 #include "protobuf/status.h"
 #include "protobuf/command.h"
 
 class Strategy;
 
+//! Feeds statuses to a strategy living in another thread, with at most framesInFlight
+//! statuses being queued or processed at a time. handleStatus only blocks once the window is full.
 class BlockingStrategyReplay : public QObject {
     Q_OBJECT
 public:
-    BlockingStrategyReplay(Strategy * strategy, int size = 5);
+    BlockingStrategyReplay(Strategy * strategy, int framesInFlight = 5);
+    ~BlockingStrategyReplay() override;
+
+    // blocks until the strategy has processed every status passed to handleStatus
+    void flush();
+    int framesInFlight() const;
+    quint64 processedFrames() const;
+    // time handleStatus spent waiting for the strategy, in nanoseconds
+    qint64 stallTime() const;
 
 signals:
     void gotStatus(const Status &status);
     void gotCommand(const Command &command);
-    void gotStatusForStrategy(const Status &status);
 
 public slots:
-    void strategyExecute();
+    // must always be called from the same thread
     void handleStatus(const Status &status);
 
 private:
-    const int cacheSize;
-    int cacheCounter = 0;
-
-    QMutex conditionMutex;
-    QWaitCondition waitCondition;
+    class Pipeline;
+    std::shared_ptr<Pipeline> m_pipeline;
 };
 
 class FeedbackStrategyReplay : public QObject {
@@ -57,6 +64,7 @@ class FeedbackStrategyReplay : public QObject {
 public:
     FeedbackStrategyReplay(Strategy * strategy);
 
+    // blocks until the strategy answered exactly this status
     Status executeWithFeedback(const Status &orig);
 
 signals:
@@ -66,9 +74,13 @@ private slots:
     void handleStrategyStatus(const Status &status);
 
 private:
-    Status lastStatus;
-    QMutex conditionMutex;
-    QWaitCondition waitCondition;
+    Status m_lastStatus;
+    bool m_hasStatus = false;
+    bool m_waiting = false;
+    // execution state time of the status passed to executeWithFeedback
+    qint64 m_expectedTime = 0;
+    QMutex m_conditionMutex;
+    QWaitCondition m_waitCondition;
 };
 
 #endif // STRATEGYREPLAYHELPER_H
@@ -0,0 +1,107 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "distancefield.h"
+#include <QByteArray>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <utility>
+
+// only distances up to this value are relevant for the path finding
+constexpr float CLAMP_DISTANCE = 1.0f;
+// extra rastered space around the field boundary
+constexpr float AREA_MARGIN = 0.05f;
+// multiple distance fields are used at the same time, e.g. for different robot radii
+constexpr std::size_t CACHE_SIZE = 4;
+
+StaticDistanceField::StaticDistanceField(const QVector<const Obstacles::StaticObstacle*> &obstacles, const Obstacles::Rect &area,
+                                         float resolution, float clampDistance) :
+    m_origin(area.bottomLeft - Vector(AREA_MARGIN, AREA_MARGIN)),
+    m_resolution(resolution),
+    m_inverseResolution(1.0f / resolution),
+    // the interpolated value is a convex combination of the four corner values,
+    // each of which is at most one cell diagonal away from the query point
+    m_errorBound(resolution * std::sqrt(2.0f))
+{
+    const Vector size = area.topRight - area.bottomLeft + Vector(2 * AREA_MARGIN, 2 * AREA_MARGIN);
+    m_width = std::max(2, int(std::ceil(size.x * m_inverseResolution)) + 1);
+    m_height = std::max(2, int(std::ceil(size.y * m_inverseResolution)) + 1);
+    m_maxX = m_origin.x + (m_width - 1) * resolution;
+    m_maxY = m_origin.y + (m_height - 1) * resolution;
+    m_data.assign(std::size_t(m_width) * m_height, clampDistance);
+
+    for (const Obstacles::StaticObstacle *o : obstacles) {
+        // cells further away than the clamp distance keep the clamp distance
+        BoundingBox box = o->boundingBox();
+        box.addExtraRadius(clampDistance);
+        const int minX = std::max(0, int(std::floor((box.left - m_origin.x) * m_inverseResolution)));
+        const int maxX = std::min(m_width - 1, int(std::ceil((box.right - m_origin.x) * m_inverseResolution)));
+        const int minY = std::max(0, int(std::floor((box.bottom - m_origin.y) * m_inverseResolution)));
+        const int maxY = std::min(m_height - 1, int(std::ceil((box.top - m_origin.y) * m_inverseResolution)));
+        for (int y = minY; y <= maxY; y++) {
+            float *row = m_data.data() + std::size_t(y) * m_width;
+            const float posY = m_origin.y + y * resolution;
+            for (int x = minX; x <= maxX; x++) {
+                const Vector pos(m_origin.x + x * resolution, posY);
+                row[x] = std::min(row[x], o->distance(pos));
+            }
+        }
+    }
+}
+
+static QByteArray obstacleSetKey(const QVector<const Obstacles::StaticObstacle*> &obstacles, const Obstacles::Rect &area, float resolution)
+{
+    pathfinding::WorldState state;
+    for (const Obstacles::StaticObstacle *o : obstacles) {
+        o->serialize(state.add_obstacles());
+    }
+    pathfinding::Obstacle boundary;
+    area.serialize(&boundary);
+    state.mutable_boundary()->CopyFrom(boundary.rectangle());
+    state.set_radius(resolution);
+    return QByteArray::fromStdString(state.SerializeAsString());
+}
+
+std::shared_ptr<const StaticDistanceField> StaticDistanceField::cached(const QVector<const Obstacles::StaticObstacle*> &obstacles,
+                                                                       const Obstacles::Rect &area, float resolution)
+{
+    static QMutex mutex;
+    // most recently used first
+    static std::list<std::pair<QByteArray, std::shared_ptr<const StaticDistanceField>>> cache;
+
+    const QByteArray key = obstacleSetKey(obstacles, area, resolution);
+
+    QMutexLocker locker(&mutex);
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if (it->first == key) {
+            cache.splice(cache.begin(), cache, it);
+            return cache.front().second;
+        }
+    }
+
+    auto field = std::make_shared<const StaticDistanceField>(obstacles, area, resolution, CLAMP_DISTANCE);
+    cache.emplace_front(key, field);
+    if (cache.size() > CACHE_SIZE) {
+        cache.pop_back();
+    }
+    return field;
+}
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "endinobstaclesampler.h"
+#include "parallelevaluation.h"
 #include "parameterization.h"
 #include "core/rng.h"
 
@@ -41,13 +42,7 @@ bool EndInObstacleSampler::compute(const TrajectoryInput &input)
     const Vector stopPoint = stop.endPosition();
 
     // TODO: sample closer if we are already close
-    const int ITERATIONS = 60;
-    for (int i = 0;i<ITERATIONS;i++) {
-        if (i == int(ITERATIONS / PARAMETER(EndInObstacleSampler, 1, 3, 10)) && !isValid) {
-            m_bestEndPointDistance = std::numeric_limits<float>::infinity();
-            // test just stopping now
-            testEndPoint(input, stopPoint);
-        }
+    auto generateTestPoint = [&]() {
         int randVal = m_rng->uniformInt() % 1024;
         Vector testPoint;
         const int RANDOM_END_RANGE = PARAMETER(EndInObstacleSampler, 1, 300, 700);
@@ -69,21 +64,76 @@ bool EndInObstacleSampler::compute(const TrajectoryInput &input)
             // sample random point in field
             testPoint = randomPointInField();
         }
-        testEndPoint(input, testPoint);
+        return testPoint;
+    };
+
+    const int ITERATIONS = 60;
+    const int stopPointIteration = int(ITERATIONS / PARAMETER(EndInObstacleSampler, 1, 3, 10));
+    const int batchSize = m_parallelEvaluation ? PARALLEL_BATCH_SIZE : 1;
+    std::vector<Vector> testPoints;
+    for (int i = 0;i<ITERATIONS;) {
+        if (i == stopPointIteration && !isValid) {
+            m_bestEndPointDistance = std::numeric_limits<float>::infinity();
+            // test just stopping now
+            testEndPoint(input, stopPoint);
+        }
+        // a batch must not span the stop point test
+        int batchEnd = std::min(ITERATIONS, i + batchSize);
+        if (i < stopPointIteration) {
+            batchEnd = std::min(batchEnd, stopPointIteration);
+        }
+        testPoints.clear();
+        for (;i<batchEnd;i++) {
+            testPoints.push_back(generateTestPoint());
+        }
+        testEndPoints(input, testPoints);
     }
     return isValid;
 }
 
 bool EndInObstacleSampler::testEndPoint(const TrajectoryInput &input, Vector endPoint)
 {
-    const float targetDistance = endPoint.distance(input.target.pos);
-    if (targetDistance > m_bestEndPointDistance - 0.01f) {
+    auto trajectory = evaluateEndPoint(input, endPoint, m_bestEndPointDistance);
+    if (!trajectory) {
         return false;
     }
+    setBestEndPoint(input, endPoint, std::move(trajectory.value()));
+    return true;
+}
+
+void EndInObstacleSampler::testEndPoints(const TrajectoryInput &input, const std::vector<Vector> &endPoints)
+{
+    if (!m_parallelEvaluation || endPoints.size() < 2) {
+        for (const Vector &endPoint : endPoints) {
+            testEndPoint(input, endPoint);
+        }
+        return;
+    }
+
+    const float batchBestDistance = m_bestEndPointDistance;
+    std::vector<std::optional<Trajectory>> trajectories(endPoints.size());
+    parallelEvaluate(endPoints.size(), [&](int i) {
+        trajectories[i] = evaluateEndPoint(input, endPoints[i], batchBestDistance);
+    });
+
+    // reduce in the order of the end points, independent of the thread timing
+    for (std::size_t i = 0;i<endPoints.size();i++) {
+        if (trajectories[i] && endPoints[i].distance(input.target.pos) <= m_bestEndPointDistance - 0.01f) {
+            setBestEndPoint(input, endPoints[i], std::move(trajectories[i].value()));
+        }
+    }
+}
+
+std::optional<Trajectory> EndInObstacleSampler::evaluateEndPoint(const TrajectoryInput &input, Vector endPoint, float bestDistance) const
+{
+    const float targetDistance = endPoint.distance(input.target.pos);
+    if (targetDistance > bestDistance - 0.01f) {
+        return {};
+    }
 
     // try to keep at least 3 cm distance to static obstacles
     if (m_world.minObstacleDistancePoint({{endPoint, Vector(0, 0)}, 10000}) < 0.03f) {
-        return false;
+        return {};
     }
 
     // no slowdown here, we are not even were we want to be
@@ -92,19 +142,22 @@ bool EndInObstacleSampler::testEndPoint(const TrajectoryInput &input, Vector end
                                                             input.maxSpeed, 0, EndSpeed::EXACT);
 
     if (!direct) {
-        return false;
+        return {};
     }
     if (m_world.isTrajectoryInObstacle(direct.value(), input.t0)) {
-        return false;
+        return {};
     }
+    return direct;
+}
 
-    m_bestEndPointDistance = targetDistance;
+void EndInObstacleSampler::setBestEndPoint(const TrajectoryInput &input, Vector endPoint, Trajectory trajectory)
+{
+    m_bestEndPointDistance = endPoint.distance(input.target.pos);
     isValid = true;
     m_bestEndPoint = endPoint;
 
     result.clear();
-    result.push_back(direct.value());
-    return true;
+    result.push_back(std::move(trajectory));
 }
 
 Vector EndInObstacleSampler::randomPointInField()
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include "core/vector.h"
+#include "obstacles.h"
+#include <QVector>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Raster of the minimum distance to a set of static obstacles.
+// Values are interpolated bilinearly, since all obstacle distance functions are
+// 1-Lipschitz the interpolation error is bounded by errorBound().
+// Distances larger than the clamp distance are stored as the clamp distance.
+class StaticDistanceField
+{
+public:
+    StaticDistanceField(const QVector<const Obstacles::StaticObstacle*> &obstacles, const Obstacles::Rect &area,
+                        float resolution, float clampDistance);
+    StaticDistanceField(const StaticDistanceField&) = delete;
+    StaticDistanceField& operator=(const StaticDistanceField&) = delete;
+
+    // returns a shared raster for the obstacle set, only builds it if no identical set was rastered recently
+    static std::shared_ptr<const StaticDistanceField> cached(const QVector<const Obstacles::StaticObstacle*> &obstacles,
+                                                             const Obstacles::Rect &area, float resolution);
+
+    bool contains(const Vector &v) const {
+        return v.x >= m_origin.x && v.y >= m_origin.y && v.x <= m_maxX && v.y <= m_maxY;
+    }
+    // only valid if contains(v) is true
+    float distance(const Vector &v) const {
+        const float fx = (v.x - m_origin.x) * m_inverseResolution;
+        const float fy = (v.y - m_origin.y) * m_inverseResolution;
+        const int ix = std::min(int(fx), m_width - 2);
+        const int iy = std::min(int(fy), m_height - 2);
+        const float tx = fx - ix;
+        const float ty = fy - iy;
+        const float *row = m_data.data() + iy * m_width + ix;
+        const float bottom = row[0] + (row[1] - row[0]) * tx;
+        const float top = row[m_width] + (row[m_width + 1] - row[m_width]) * tx;
+        return bottom + (top - bottom) * ty;
+    }
+    float errorBound() const { return m_errorBound; }
+    float resolution() const { return m_resolution; }
+
+private:
+    Vector m_origin;
+    float m_maxX;
+    float m_maxY;
+    float m_resolution;
+    float m_inverseResolution;
+    float m_errorBound;
+    int m_width;
+    int m_height;
+    std::vector<float> m_data;
+};
+
+#endif // DISTANCEFIELD_H
@@ -22,6 +22,8 @@
 #define ENDINOBSTACLESAMPLER_H
 
 #include "trajectorysampler.h"
+#include <optional>
+#include <vector>
 
 class EndInObstacleSampler : public TrajectorySampler
 {
@@ -30,9 +32,14 @@ public:
     bool compute(const TrajectoryInput &input) final override;
     const std::vector<Trajectory> &getResult() const final override { return result; }
     float getTargetDistance() const { return m_bestEndPointDistance; }
+    // evaluates the end points in batches on multiple threads
+    void setParallelEvaluation(bool parallel) { m_parallelEvaluation = parallel; }
 
 private:
     bool testEndPoint(const TrajectoryInput &input, Vector endPoint);
+    void testEndPoints(const TrajectoryInput &input, const std::vector<Vector> &endPoints);
+    std::optional<Trajectory> evaluateEndPoint(const TrajectoryInput &input, Vector endPoint, float bestDistance) const;
+    void setBestEndPoint(const TrajectoryInput &input, Vector endPoint, Trajectory trajectory);
     Vector randomPointInField();
 
 private:
@@ -40,6 +47,8 @@ private:
     float m_bestEndPointDistance = std::numeric_limits<float>::max();
 
     bool isValid;
+    bool m_parallelEvaluation = false;
+    static constexpr int PARALLEL_BATCH_SIZE = 20;
     std::vector<Trajectory> result;
 };
 
@@ -23,6 +23,7 @@
 
 #include "boundingbox.h"
 #include "linesegment.h"
+#include "sharedtrajectory.h"
 #include "trajectoryinput.h"
 #include "protobuf/pathfinding.pb.h"
 #include <QByteArray>
@@ -209,12 +210,8 @@ namespace Obstacles {
          * @param trajectory Must be comprised of at least two points, all equidistant in time
          * The first element must start at time zero
          */
-        FriendlyRobotObstacle(std::vector<TrajectoryPoint> *trajectory, float radius, int prio);
+        FriendlyRobotObstacle(SharedTrajectoryPtr trajectory, float radius, int prio);
         FriendlyRobotObstacle(const pathfinding::Obstacle &obstacle, const pathfinding::FriendlyRobotObstacle &robot);
-        FriendlyRobotObstacle(const FriendlyRobotObstacle &other);
-        FriendlyRobotObstacle(FriendlyRobotObstacle &&other);
-        FriendlyRobotObstacle &operator=(const FriendlyRobotObstacle &other);
-        FriendlyRobotObstacle &operator=(FriendlyRobotObstacle &&other);
 
         float zonedDistance(const TrajectoryPoint &point, float nearRadius) const override;
         BoundingBox boundingBox() const override { return bound; }
@@ -224,12 +221,8 @@ namespace Obstacles {
         bool operator==(const Obstacle &otherObst) const override;
 
     private:
-        std::vector<TrajectoryPoint> *trajectory;
-        float timeInterval;
+        SharedTrajectoryPtr trajectory;
         BoundingBox bound;
-
-        // used when reconstructing obstacles from file
-        std::vector<TrajectoryPoint> ownData;
     };
 
     struct OpponentRobotObstacle : public Obstacle {
@@ -0,0 +1,30 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef PARALLELEVALUATION_H
+#define PARALLELEVALUATION_H
+
+#include <functional>
+
+// Calls evaluate(0) to evaluate(count - 1) on a thread pool shared by all path finding instances.
+// The calling thread takes part in the evaluation and the function returns once all calls are finished.
+// The order of the calls is unspecified, so evaluate must be thread safe and should write its results by index.
+void parallelEvaluate(int count, const std::function<void(int)> &evaluate);
+
+#endif // PARALLELEVALUATION_H
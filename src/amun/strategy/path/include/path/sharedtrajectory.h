@@ -0,0 +1,81 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef SHAREDTRAJECTORY_H
+#define SHAREDTRAJECTORY_H
+
+#include "boundingbox.h"
+#include "trajectoryinput.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// immutable snapshot of a sampled robot trajectory
+// a planner publishes a new snapshot every time it replans, other planners can keep
+// using the old one as an obstacle without copying the points
+class SharedTrajectory {
+public:
+    // points must be equidistant in time, starting at time zero
+    explicit SharedTrajectory(std::vector<TrajectoryPoint> points = {});
+
+    const std::vector<TrajectoryPoint> &points() const { return m_points; }
+    std::size_t size() const { return m_points.size(); }
+    bool empty() const { return m_points.empty(); }
+
+    float timeInterval() const { return m_timeInterval; }
+    // bounding box of all positions, without any robot radius
+    const BoundingBox &bound() const { return m_bound; }
+    float maxDistanceSqFromStart() const { return m_maxDistanceSqFromStart; }
+
+    // the point sampled at the given time, clamped to the end of the trajectory
+    const TrajectoryPoint &at(float time) const;
+
+private:
+    std::vector<TrajectoryPoint> m_points;
+    float m_timeInterval;
+    BoundingBox m_bound;
+    float m_maxDistanceSqFromStart;
+};
+
+using SharedTrajectoryPtr = std::shared_ptr<const SharedTrajectory>;
+
+inline SharedTrajectory::SharedTrajectory(std::vector<TrajectoryPoint> points) :
+    m_points(std::move(points)),
+    m_timeInterval(m_points.size() > 1 ? m_points[1].time - m_points[0].time : 1),
+    m_bound(Vector(1000, 1000), Vector(1000, 1000)), // outside of the field
+    m_maxDistanceSqFromStart(0)
+{
+    if (m_points.empty()) {
+        return;
+    }
+    const Vector start = m_points[0].state.pos;
+    m_bound = BoundingBox(start, start);
+    for (const TrajectoryPoint &p : m_points) {
+        m_bound.mergePoint(p.state.pos);
+        m_maxDistanceSqFromStart = std::max(m_maxDistanceSqFromStart, p.state.pos.distanceSq(start));
+    }
+}
+
+inline const TrajectoryPoint &SharedTrajectory::at(float time) const
+{
+    const unsigned long index = std::min(static_cast<unsigned long>(m_points.size() - 1), static_cast<unsigned long>(time / m_timeInterval));
+    return m_points[index];
+}
+
+#endif // SHAREDTRAJECTORY_H
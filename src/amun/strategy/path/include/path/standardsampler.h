@@ -61,6 +61,8 @@ public:
     bool compute(const TrajectoryInput &input) final override;
     const std::vector<Trajectory> &getResult() const final override { return m_result; }
     void setDirectTrajectoryScore(float score) { m_directTrajectoryScore = score; }
+    // evaluates the samples in batches on multiple threads, checkSample is then not called for every sample
+    void setParallelEvaluation(bool parallel) { m_parallelEvaluation = parallel; }
     float getScore() const { return m_bestResultInfo.time; }
 
     static constexpr float OBSTACLE_AVOIDANCE_RADIUS = 0.1f;
@@ -87,6 +89,14 @@ protected:
         StandardTrajectorySample sample;
     };
     Vector randomSpeed(float maxSpeed);
+    // only fills result if the sample is better than the current best time
+    SampleScore evaluateSample(const TrajectoryInput &input, const StandardTrajectorySample &sample,
+                               float currentBestTime, std::vector<Trajectory> &result) const;
+    void checkSamples(const TrajectoryInput &input, const std::vector<StandardTrajectorySample> &samples);
+    int sampleBatchSize() const { return m_parallelEvaluation ? PARALLEL_BATCH_SIZE : 1; }
+    static float minimumTimeImprovement(const TrajectoryInput &input);
+
+    static constexpr int PARALLEL_BATCH_SIZE = 20;
 
 protected:
     // functions that need be implemented for an optimizable sampler
@@ -101,6 +111,7 @@ protected:
 protected:
     float m_directTrajectoryScore = std::numeric_limits<float>::max();
     StandardSamplerBestTrajectoryInfo m_bestResultInfo;
+    bool m_parallelEvaluation = false;
 
     std::vector<Trajectory> m_result;
 };
@@ -24,6 +24,7 @@
 #include "abstractpath.h"
 #include "endinobstaclesampler.h"
 #include "multiescapesampler.h"
+#include "sharedtrajectory.h"
 #include "standardsampler.h"
 #include "trajectoryinput.h"
 #include "core/vector.h"
@@ -39,8 +40,11 @@ public:
     void reset() override;
     std::vector<TrajectoryPoint> calculateTrajectory(Vector s0, Vector v0, Vector s1, Vector v1, float maxSpeed, float acceleration);
     // is guaranteed to be equally spaced in time
-    std::vector<TrajectoryPoint> *getCurrentTrajectory() { return &m_currentTrajectory; }
+    // the handle stays valid for the lifetime of the path, its content is replaced with every new trajectory
+    const SharedTrajectoryPtr *getCurrentTrajectory() const { return &m_currentTrajectory; }
     int maxIntersectingObstaclePrio() const;
+    // lowers the latency for a single robot by using multiple threads for the sample evaluation
+    void setParallelSampleEvaluation(bool parallel);
 
 private:
     // copy input so that the modification does not affect the getResultPath function
@@ -55,7 +59,8 @@ private:
     MultiEscapeSampler m_escapeObstacleSampler;
 
     // result trajectory (used by other robots as obstacle)
-    std::vector<TrajectoryPoint> m_currentTrajectory;
+    // never modified in place, obstacles created from an older trajectory keep their snapshot
+    SharedTrajectoryPtr m_currentTrajectory;
 
     ProtobufFileSaver *m_inputSaver;
     pathfinding::InputSourceType m_captureType;
@@ -22,10 +22,12 @@
 #define WORLDINFORMATION_H
 
 #include "core/vector.h"
+#include "distancefield.h"
 #include "obstacles.h"
 #include "alphatimetrajectory.h"
 #include "protobuf/pathfinding.pb.h"
 #include <QVector>
+#include <memory>
 
 class WorldInformation
 {
@@ -55,12 +57,17 @@ public:
     void addTriangle(float x1, float y1, float x2, float y2, float x3, float y3, float lineWidth, const char *name, int prio);
 
     void collectObstacles();
+    // rasters the static obstacles for faster distance queries, disabled with a resolution of zero
+    void setStaticDistanceFieldResolution(float resolution) { m_distanceFieldResolution = resolution; }
+    float staticDistanceFieldResolution() const { return m_distanceFieldResolution; }
+    // only valid after a call to collectObstacles, may be null
+    const StaticDistanceField *staticDistanceField() const { return m_distanceField.get(); }
     bool pointInPlayfield(const Vector &point, float radius) const;
 
     // moving obstacles
     void addMovingCircle(Vector startPos, Vector speed, Vector acc, float startTime, float endTime, float radius, int prio);
     void addMovingLine(Vector startPos1, Vector speed1, Vector acc1, Vector startPos2, Vector speed2, Vector acc2, float startTime, float endTime, float width, int prio);
-    void addFriendlyRobotTrajectoryObstacle(std::vector<TrajectoryPoint> *obstacle, int prio, float radius);
+    void addFriendlyRobotTrajectoryObstacle(const SharedTrajectoryPtr &obstacle, int prio, float radius);
     void addOpponentRobotObstacle(Vector startPos, Vector speed, int prio);
 
     // obstacle checking for points and trajectories
@@ -82,6 +89,10 @@ public:
     // collectobstacles must be called after this
     WorldInformation& operator=(const WorldInformation &world) = default;
 
+private:
+    // minimum distance to all static obstacles, exact if it is less than nearRadius
+    float staticObstacleDistance(const Vector &point, float nearRadius) const;
+
 private:
     std::vector<Obstacles::Obstacle*> m_obstacles;
     QVector<const Obstacles::StaticObstacle*> m_staticObstacles;
@@ -99,6 +110,9 @@ private:
 
     int m_outOfFieldPriority = 1;
 
+    float m_distanceFieldResolution = 0;
+    std::shared_ptr<const StaticDistanceField> m_distanceField;
+
     Obstacles::Rect m_boundary;
     float m_radius = -1.0f;
     int m_robotId = 0;
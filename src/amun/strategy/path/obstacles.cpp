@@ -534,110 +534,53 @@ bool Obstacles::MovingLine::operator==(const Obstacle &otherObst) const
 
 Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle() :
     Obstacle(0, 0),
+    trajectory(std::make_shared<SharedTrajectory>()),
     bound(Vector(0, 0), Vector(0, 0))
 { }
 
-Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle(std::vector<TrajectoryPoint> *trajectory, float radius, int prio) :
+Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle(SharedTrajectoryPtr trajectory, float radius, int prio) :
     Obstacle(prio, radius),
-    trajectory(trajectory),
-    bound(trajectory->at(0).state.pos, trajectory->at(1).state.pos)
+    trajectory(std::move(trajectory)),
+    bound(this->trajectory->bound())
 {
-    timeInterval = trajectory->at(1).time - trajectory->at(0).time;
-    for (std::size_t i = 2;i<trajectory->size();i++) {
-        bound.mergePoint(trajectory->at(i).state.pos);
-    }
     bound.addExtraRadius(radius);
 }
 
-Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle(const pathfinding::Obstacle &obstacle, const pathfinding::FriendlyRobotObstacle &robot) :
-    Obstacle(obstacle),
-    bound(Vector(1000, 1000), Vector(1000, 1000)) // outside of the field
+static SharedTrajectoryPtr deserializeTrajectory(const pathfinding::FriendlyRobotObstacle &robot)
 {
+    std::vector<TrajectoryPoint> points;
+    points.reserve(robot.robot_trajectory_size());
     for (const pathfinding::TrajectoryPoint &point : robot.robot_trajectory()) {
         const Vector pos = deserializeVector(point.pos());
         const Vector speed = deserializeVector(point.speed());
         const float time = point.time();
-        ownData.emplace_back(RobotState{pos, speed}, time);
-    }
-    trajectory = &ownData;
-    timeInterval = trajectory->size() > 1 ? trajectory->at(1).time - trajectory->at(0).time : 1;
-
-    // compute bound from trajectory
-    if (trajectory->size() > 1) {
-        bound = BoundingBox(trajectory->at(0).state.pos, trajectory->at(1).state.pos);
-        for (std::size_t i = 2;i<trajectory->size();i++) {
-            bound.mergePoint(trajectory->at(i).state.pos);
-        }
-        bound.addExtraRadius(radius);
+        points.emplace_back(RobotState{pos, speed}, time);
     }
+    return std::make_shared<SharedTrajectory>(std::move(points));
 }
 
-Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle(const Obstacles::FriendlyRobotObstacle &other) :
-    Obstacles::Obstacle(other),
-    trajectory(other.trajectory),
-    timeInterval(other.timeInterval),
-    bound(other.bound),
-    ownData(other.ownData)
-{
-    if (trajectory == &other.ownData) {
-        trajectory = &ownData;
-    }
-}
-
-Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle(Obstacles::FriendlyRobotObstacle &&other) :
-    Obstacles::Obstacle(other),
-    trajectory(std::move(other.trajectory)),
-    timeInterval(other.timeInterval),
-    bound(other.bound),
-    ownData(std::move(other.ownData))
-{
-    if (trajectory == &other.ownData) {
-        trajectory = &ownData;
-    }
-}
-
-Obstacles::FriendlyRobotObstacle &Obstacles::FriendlyRobotObstacle::operator=(const FriendlyRobotObstacle &other)
-{
-    prio = other.prio;
-    radius = other.radius;
-    trajectory = other.trajectory;
-    timeInterval = other.timeInterval;
-    bound = other.bound;
-    ownData = other.ownData;
-
-    if (trajectory == &other.ownData) {
-        trajectory = &ownData;
-    }
-    return *this;
-}
-
-Obstacles::FriendlyRobotObstacle &Obstacles::FriendlyRobotObstacle::operator=(FriendlyRobotObstacle &&other)
+Obstacles::FriendlyRobotObstacle::FriendlyRobotObstacle(const pathfinding::Obstacle &obstacle, const pathfinding::FriendlyRobotObstacle &robot) :
+    Obstacle(obstacle),
+    trajectory(deserializeTrajectory(robot)),
+    bound(trajectory->bound())
 {
-    prio = other.prio;
-    radius = other.radius;
-    trajectory = std::move(other.trajectory);
-    timeInterval = other.timeInterval;
-    bound = other.bound;
-    ownData = std::move(other.ownData);
-
-    if (trajectory == &other.ownData) {
-        trajectory = &ownData;
+    if (!trajectory->empty()) {
+        bound.addExtraRadius(radius);
     }
-    return *this;
 }
 
 float Obstacles::FriendlyRobotObstacle::zonedDistance(const TrajectoryPoint &point, float nearRadius) const
 {
-    const unsigned long index = std::min(static_cast<unsigned long>(trajectory->size()-1), static_cast<unsigned long>(point.time / timeInterval));
-    return computeZonedIntersection((*trajectory)[index].state.pos.distanceSq(point.state.pos), radius, nearRadius);
+    return computeZonedIntersection(trajectory->at(point.time).state.pos.distanceSq(point.state.pos), radius, nearRadius);
 }
 
 Vector Obstacles::FriendlyRobotObstacle::projectOut(Vector v, float extraDistance) const
 {
-    if (trajectory->back().state.speed.lengthSquared() > 0.05f) {
+    const TrajectoryPoint &stop = trajectory->points().back();
+    if (stop.state.speed.lengthSquared() > 0.05f) {
         return v;
     }
-    const Vector stopPos = trajectory->back().state.pos;
+    const Vector stopPos = stop.state.pos;
     const float dist = v.distance(stopPos);
     if (dist < 0.01f) {
         return stopPos + Vector(radius + extraDistance, 0);
@@ -651,7 +594,7 @@ Vector Obstacles::FriendlyRobotObstacle::projectOut(Vector v, float extraDistanc
 void Obstacles::FriendlyRobotObstacle::serializeChild(pathfinding::Obstacle *obstacle) const
 {
     const auto robot = obstacle->mutable_friendly_robot();
-    for (const TrajectoryPoint &p : *trajectory) {
+    for (const TrajectoryPoint &p : trajectory->points()) {
         auto point = robot->add_robot_trajectory();
         setVector(p.state.pos, point->mutable_pos());
         setVector(p.state.speed, point->mutable_speed());
@@ -664,7 +607,9 @@ bool Obstacles::FriendlyRobotObstacle::operator==(const Obstacle &otherObst) con
     const Obstacles::FriendlyRobotObstacle &other = dynamic_cast<const Obstacles::FriendlyRobotObstacle&>(otherObst);
 
     if (prio != other.prio || radius != other.radius || trajectory->size() != other.trajectory->size()) return false;
-    return std::equal(trajectory->begin(), trajectory->end(), other.trajectory->begin(), [](TrajectoryPoint a, TrajectoryPoint b) {
+    if (trajectory == other.trajectory) return true;
+    const auto &points = trajectory->points();
+    return std::equal(points.begin(), points.end(), other.trajectory->points().begin(), [](TrajectoryPoint a, TrajectoryPoint b) {
         return a.time == b.time && a.state.pos == b.state.pos && a.state.speed == b.state.speed;
     });
 }
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "parallelevaluation.h"
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+    struct EvaluationState {
+        const std::function<void(int)> &evaluate;
+        const int count;
+        std::atomic<int> next{0};
+        QSemaphore finished;
+
+        EvaluationState(const std::function<void(int)> &evaluate, int count) : evaluate(evaluate), count(count) {}
+
+        // returns the number of evaluated indices
+        int work() {
+            int evaluated = 0;
+            for (int i = next++; i < count; i = next++) {
+                evaluate(i);
+                evaluated++;
+            }
+            return evaluated;
+        }
+    };
+
+    class EvaluationRunnable : public QRunnable
+    {
+    public:
+        EvaluationRunnable(const std::shared_ptr<EvaluationState> &state) : m_state(state) {}
+        void run() override {
+            const int evaluated = m_state->work();
+            if (evaluated > 0) {
+                m_state->finished.release(evaluated);
+            }
+        }
+
+    private:
+        // a runnable may only start after parallelEvaluate returned, it then finds no work left
+        std::shared_ptr<EvaluationState> m_state;
+    };
+}
+
+static QThreadPool *evaluationPool()
+{
+    // separate from the global thread pool, the calling thread also does work
+    static QThreadPool *pool = [] {
+        QThreadPool *p = new QThreadPool;
+        p->setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+        return p;
+    }();
+    return pool;
+}
+
+void parallelEvaluate(int count, const std::function<void(int)> &evaluate)
+{
+    std::shared_ptr<EvaluationState> state = std::make_shared<EvaluationState>(evaluate, count);
+    QThreadPool *pool = evaluationPool();
+    const int helpers = std::min(count - 1, pool->maxThreadCount());
+    for (int i = 0;i<helpers;i++) {
+        // the runnables are deleted by the pool
+        pool->start(new EvaluationRunnable(state));
+    }
+    const int evaluated = state->work();
+    // only wait for the indices claimed by the helpers, not for helpers that are not even running yet
+    state->finished.acquire(std::max(0, count - evaluated));
+}
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "standardsampler.h"
+#include "parallelevaluation.h"
 #include "core/rng.h"
 #include "core/protobuffilereader.h"
 #include "core/protobuffilesaver.h"
@@ -63,7 +64,7 @@ void LiveStandardSampler::computeSamples(const TrajectoryInput &input, const Sta
     }
 
     // normal search
-    for (int i = 0;i<100;i++) {
+    auto generateSample = [&](int i) {
         // three sampling modes:
         // - totally random configuration
         // - around current best trajectory
@@ -116,7 +117,18 @@ void LiveStandardSampler::computeSamples(const TrajectoryInput &input, const Sta
             time = std::max(0.0001f, info.sample.getTime() + m_rng->uniformFloat(-0.1f, 0.1f));
         }
         time = std::max(0.0f, time);
-        checkSample(input, StandardTrajectorySample(time, angle, speed), m_bestResultInfo.time);
+        return StandardTrajectorySample(time, angle, speed);
+    };
+
+    const int SAMPLES = 100;
+    std::vector<StandardTrajectorySample> samples;
+    for (int i = 0;i<SAMPLES;) {
+        // samples of one batch are generated from the same best trajectory
+        samples.clear();
+        for (const int batchEnd = std::min(SAMPLES, i + sampleBatchSize());i<batchEnd;i++) {
+            samples.push_back(generateSample(i));
+        }
+        checkSamples(input, samples);
     }
 }
 
@@ -235,7 +247,7 @@ bool PrecomputedStandardSampler::trySplit(const std::vector<TrajectoryInput> &in
 void PrecomputedStandardSampler::computeSamples(const TrajectoryInput &input, const StandardSamplerBestTrajectoryInfo&)
 {
     // check points randomly around the last frames result to improve it
-    for (int i = 0;i<20;i++) {
+    auto generateSample = [&]() {
         float angle, time;
         Vector speed;
 
@@ -251,21 +263,33 @@ void PrecomputedStandardSampler::computeSamples(const TrajectoryInput &input, co
         angle = info.sample.getAngle() + m_rng->uniformFloat(-0.1f, 0.1f);
         time = std::max(0.0001f, info.sample.getTime() + m_rng->uniformFloat(-0.1f, 0.1f));
 
+        return StandardTrajectorySample(time, angle, speed);
+    };
 
-        checkSample(input, StandardTrajectorySample(time, angle, speed), m_bestResultInfo.time);
+    const int SAMPLES = 20;
+    std::vector<StandardTrajectorySample> samples;
+    for (int i = 0;i<SAMPLES;) {
+        samples.clear();
+        for (const int batchEnd = std::min(SAMPLES, i + sampleBatchSize());i<batchEnd;i++) {
+            samples.push_back(generateSample());
+        }
+        checkSamples(input, samples);
     }
 
     // check pre-computed points
     const float targetDistance = (input.target.pos - input.start.pos).length();
     for (const auto &segment : m_precomputation) {
         if (segment.minDistance <= targetDistance && segment.maxDistance >= targetDistance) {
+            samples.clear();
             for (const auto &sample : segment.samples) {
                 StandardTrajectorySample denormalized = sample.denormalize(input);
                 if (denormalized.getMidSpeed().lengthSquared() >= input.maxSpeedSquared) {
                     denormalized.setMidSpeed(denormalized.getMidSpeed().normalized() * input.maxSpeed);
                 }
-                checkSample(input, denormalized, m_bestResultInfo.time);
+                samples.push_back(denormalized);
             }
+            // the precomputed samples do not depend on each other, check them all at once
+            checkSamples(input, samples);
             break;
         }
     }
@@ -291,12 +315,62 @@ float StandardSampler::trajectoryScore(float time, float obstacleDistance)
     return biasedTrajectoryTime;
 }
 
+float StandardSampler::minimumTimeImprovement(const TrajectoryInput &input)
+{
+    // do not use this minimum time improvement for very low distances
+    return (input.target.pos - input.start.pos).lengthSquared() > 1 ? 0.05f : 0.0f;
+}
+
 StandardSampler::SampleScore StandardSampler::checkSample(const TrajectoryInput &input, const StandardTrajectorySample &sample, const float currentBestTime)
+{
+    std::vector<Trajectory> result;
+    const SampleScore score = evaluateSample(input, sample, currentBestTime, result);
+    if (!result.empty()) {
+        // trajectory is possible, better than previous trajectory
+        m_bestResultInfo.time = score.score;
+        m_bestResultInfo.valid = true;
+        m_bestResultInfo.sample = sample;
+        m_result = std::move(result);
+    }
+    return score;
+}
+
+void StandardSampler::checkSamples(const TrajectoryInput &input, const std::vector<StandardTrajectorySample> &samples)
+{
+    if (!m_parallelEvaluation || samples.size() < 2) {
+        for (const auto &sample : samples) {
+            checkSample(input, sample, m_bestResultInfo.time);
+        }
+        return;
+    }
+
+    // all samples are checked against the best result from before the batch
+    const float batchBestTime = m_bestResultInfo.time;
+    std::vector<std::vector<Trajectory>> results(samples.size());
+    std::vector<float> scores(samples.size());
+    parallelEvaluate(samples.size(), [&](int i) {
+        scores[i] = evaluateSample(input, samples[i], batchBestTime, results[i]).score;
+    });
+
+    // the reduction is done in sample order to stay independent of the thread timing
+    const float minImprovement = minimumTimeImprovement(input);
+    for (std::size_t i = 0;i<samples.size();i++) {
+        const float bestTime = std::min(m_directTrajectoryScore, m_bestResultInfo.time);
+        if (!results[i].empty() && scores[i] <= bestTime - minImprovement) {
+            m_bestResultInfo.time = scores[i];
+            m_bestResultInfo.valid = true;
+            m_bestResultInfo.sample = samples[i];
+            m_result = std::move(results[i]);
+        }
+    }
+}
+
+StandardSampler::SampleScore StandardSampler::evaluateSample(const TrajectoryInput &input, const StandardTrajectorySample &sample,
+                                                             float currentBestTime, std::vector<Trajectory> &result) const
 {
     const float bestTime = std::min(m_directTrajectoryScore, currentBestTime);
 
-    // do not use this minimum time improvement for very low distances
-    const float MINIMUM_TIME_IMPROVEMENT = (input.target.pos - input.start.pos).lengthSquared() > 1 ? 0.05f : 0.0f;
+    const float MINIMUM_TIME_IMPROVEMENT = minimumTimeImprovement(input);
 
     // construct second part from mid point data
     if (sample.getTime() < 0) {
@@ -346,14 +420,7 @@ StandardSampler::SampleScore StandardSampler::checkSample(const TrajectoryInput
         return {ScoreType::EXACT, biasedTrajectoryTime};
     }
 
-    // trajectory is possible, better than previous trajectory
-    m_bestResultInfo.time = biasedTrajectoryTime;
-    m_bestResultInfo.valid = true;
-    m_bestResultInfo.sample = sample;
-
-    m_result.clear();
-    m_result.push_back(firstPart);
-    m_result.push_back(secondPart);
+    result = {firstPart, secondPart};
     return {ScoreType::EXACT, biasedTrajectoryTime};
 }
 
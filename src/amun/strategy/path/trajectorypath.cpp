@@ -29,6 +29,7 @@ TrajectoryPath::TrajectoryPath(uint32_t rng_seed, ProtobufFileSaver *inputSaver,
     m_standardSampler(m_rng, m_world, m_debug),
     m_endInObstacleSampler(m_rng, m_world, m_debug),
     m_escapeObstacleSampler(m_rng, m_world, m_debug),
+    m_currentTrajectory(std::make_shared<SharedTrajectory>()),
     m_inputSaver(inputSaver),
     m_captureType(captureType)
 { }
@@ -38,6 +39,12 @@ void TrajectoryPath::reset()
     // TODO: reset internal state
 }
 
+void TrajectoryPath::setParallelSampleEvaluation(bool parallel)
+{
+    m_standardSampler.setParallelEvaluation(parallel);
+    m_endInObstacleSampler.setParallelEvaluation(parallel);
+}
+
 std::vector<TrajectoryPoint> TrajectoryPath::calculateTrajectory(Vector s0, Vector v0, Vector s1, Vector v1, float maxSpeed, float acceleration)
 {
     // sanity checks
@@ -216,7 +223,8 @@ std::vector<Trajectory> TrajectoryPath::findPath(TrajectoryInput input)
 std::vector<TrajectoryPoint> TrajectoryPath::getResultPath(const std::vector<Trajectory> &profiles, const TrajectoryInput &input)
 {
     if (profiles.size() == 0) {
-        m_currentTrajectory = {{input.start, 0}, {RobotState{input.start.pos, Vector(0, 0)}, 0.01f}};
+        m_currentTrajectory = std::make_shared<SharedTrajectory>(std::vector<TrajectoryPoint>{
+                    {input.start, 0}, {RobotState{input.start.pos, Vector(0, 0)}, 0.01f}});
 
         const TrajectoryPoint p1{input.start, 0};
         const TrajectoryPoint p2{RobotState{input.start.pos, Vector(0, 0)}, 0};
@@ -237,12 +245,13 @@ std::vector<TrajectoryPoint> TrajectoryPath::getResultPath(const std::vector<Tra
     }
 
 
-    m_currentTrajectory.clear();
     std::vector<TrajectoryPoint> result;
 
     float startOffset = 0;
     float totalTime = 0;
     const int SAMPLES_PER_TRAJECTORY = 40;
+    std::vector<TrajectoryPoint> obstaclePoints;
+    obstaclePoints.reserve(SAMPLES_PER_TRAJECTORY * profiles.size() + 1);
     const float samplingInterval = toEndTime / (SAMPLES_PER_TRAJECTORY * profiles.size());
     for (unsigned int i = 0; i < profiles.size(); i++) {
         const Trajectory &trajectory = profiles[i];
@@ -254,7 +263,7 @@ std::vector<TrajectoryPoint> TrajectoryPath::getResultPath(const std::vector<Tra
         it.next(startOffset);
         const int baseSamples = std::floor((partTime - startOffset) / samplingInterval);
         const int allSamples = baseSamples + (i == profiles.size() - 1 ? 1 : 0);
-        std::generate_n(std::back_inserter(m_currentTrajectory), allSamples, [&]() { return it.next(samplingInterval); });
+        std::generate_n(std::back_inserter(obstaclePoints), allSamples, [&]() { return it.next(samplingInterval); });
         startOffset += allSamples * samplingInterval - partTime;
 
         // use the smaller, more efficient trajectory points for transfer and usage to the strategy
@@ -272,5 +281,6 @@ std::vector<TrajectoryPoint> TrajectoryPath::getResultPath(const std::vector<Tra
 
         totalTime += partTime;
     }
+    m_currentTrajectory = std::make_shared<SharedTrajectory>(std::move(obstaclePoints));
     return result;
 }
@@ -93,6 +93,12 @@ void WorldInformation::collectObstacles()
     for (auto &o : m_movingLines) { m_movingObstacles.push_back(&o); }
     for (auto &o : m_friendlyRobotObstacles) { m_movingObstacles.push_back(&o); }
     for (auto &o : m_opponentRobotObstacles) { m_movingObstacles.push_back(&o); }
+
+    if (m_distanceFieldResolution > 0 && !m_staticObstacles.isEmpty()) {
+        m_distanceField = StaticDistanceField::cached(m_staticObstacles, m_boundary, m_distanceFieldResolution);
+    } else {
+        m_distanceField.reset();
+    }
 }
 
 bool WorldInformation::pointInPlayfield(const Vector &point, float radius) const
@@ -120,22 +126,19 @@ void WorldInformation::addMovingLine(Vector startPos1, Vector speed1, Vector acc
                                startPos2, speed2, acc2, startTime, endTime);
 }
 
-void WorldInformation::addFriendlyRobotTrajectoryObstacle(std::vector<TrajectoryPoint> *obstacle, int prio, float radius)
+void WorldInformation::addFriendlyRobotTrajectoryObstacle(const SharedTrajectoryPtr &obstacle, int prio, float radius)
 {
     // the path finding of the other robot could not find a path
-    if (obstacle->size() == 0) {
+    if (!obstacle || obstacle->empty()) {
         return;
     }
-    float maxDistSq = 0;
-    for (const TrajectoryPoint &p : *obstacle) {
-        maxDistSq = std::max(maxDistSq, p.state.pos.distanceSq((*obstacle)[0].state.pos));
-    }
+    const float maxDistSq = obstacle->maxDistanceSqFromStart();
     if (maxDistSq < 0.03f * 0.03f) {
-        addCircle(obstacle->at(0).state.pos.x, obstacle->at(0).state.pos.y, radius + std::sqrt(maxDistSq), nullptr, prio);
+        const Vector start = obstacle->points()[0].state.pos;
+        addCircle(start.x, start.y, radius + std::sqrt(maxDistSq), nullptr, prio);
         return;
     }
-    const Obstacles::FriendlyRobotObstacle o(obstacle, radius + m_radius, prio);
-    m_friendlyRobotObstacles.push_back(o);
+    m_friendlyRobotObstacles.emplace_back(obstacle, radius + m_radius, prio);
 }
 
 void WorldInformation::addOpponentRobotObstacle(Vector startPos, Vector speed, int prio)
@@ -181,9 +184,28 @@ bool WorldInformation::isInStaticObstacle(Vector point) const
     if (!pointInPlayfield(point, m_radius)) {
         return true;
     }
+    if (m_distanceField) {
+        return staticObstacleDistance(point, 0) <= 0;
+    }
     return std::any_of(m_staticObstacles.cbegin(), m_staticObstacles.cend(), [point](auto o) { return o->distance(point) <= 0; });
 }
 
+float WorldInformation::staticObstacleDistance(const Vector &point, float nearRadius) const
+{
+    if (m_distanceField && m_distanceField->contains(point)) {
+        const float approximate = m_distanceField->distance(point);
+        if (approximate - m_distanceField->errorBound() >= nearRadius) {
+            return approximate;
+        }
+    }
+    // fall back to the exact computation close to the obstacles
+    float minDistance = std::numeric_limits<float>::max();
+    for (const auto o : m_staticObstacles) {
+        minDistance = std::min(minDistance, o->zonedDistance(point, nearRadius));
+    }
+    return minDistance;
+}
+
 float WorldInformation::minObstacleDistancePoint(const TrajectoryPoint &point) const
 {
     float minDistance = std::numeric_limits<float>::max();
@@ -236,7 +258,20 @@ std::pair<float, float> WorldInformation::minObstacleDistance(const Trajectory &
 
     trajectoryBox.addExtraRadius(safetyMargin);
 
-    for (auto obstacle : m_obstacles) {
+    // with a distance field, all static obstacles are checked at once
+    if (m_distanceField) {
+        for (const auto &point : trajectoryPoints) {
+            const float dist = staticObstacleDistance(point.state.pos, safetyMargin);
+            if (dist < 0) {
+                return {dist, dist};
+            } else if (dist < safetyMargin) {
+                totalMinDistance = std::min(dist, totalMinDistance);
+            }
+        }
+    }
+    const auto &obstacles = m_distanceField ? m_movingObstacles : m_obstacles;
+
+    for (auto obstacle : obstacles) {
         if (obstacle->boundingBox().intersects(trajectoryBox)) {
             for (const auto &point : trajectoryPoints) {
                 const float dist = obstacle->zonedDistance(point, safetyMargin);
@@ -24,6 +24,7 @@
 #include "strategy/script/debughelper.h"
 #include "strategy/script/compilerregistry.h"
 #include "core/timer.h"
+#include "core/tracing.h"
 #include "config/config.h"
 #include "protobuf/geometry.h"
 #include "protobuf/ssl_game_controller_team.pb.h"
@@ -210,7 +211,9 @@ void Strategy::handleStatus(const Status &status)
             // Instead of processing each tracking packet, only the most recent one
             // will be used.
             // guarantees that the tracking packet used by the strategy is at most 10 ms old
-            m_idleTimer->start();
+            if (!m_manualTrigger) {
+                m_idleTimer->start();
+            }
         }
     } else {
         if ((status->has_blue_running() && status->blue_running() && m_type == StrategyType::BLUE)
@@ -489,6 +492,7 @@ void Strategy::process()
     Q_ASSERT(m_scriptState.currentStatus->world_state().IsInitialized()
             || m_scriptState.currentStatus->execution_state().IsInitialized());
 
+    TraceSpan span("Strategy::process", m_scriptState.currentStatus->world_state().time());
     double pathPlanning = 0;
     qint64 startTime = Timer::systemTime();
 
@@ -20,61 +20,149 @@
 
 #include "strategyreplayhelper.h"
 #include "strategy.h"
+#include "core/statusqueue.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
 
 // BlockingStrategyReplay
-BlockingStrategyReplay::BlockingStrategyReplay(Strategy * strategy, int size) :
-    cacheSize(size)
+class BlockingStrategyReplay::Pipeline
+{
+public:
+    Pipeline(Strategy *strategy, int framesInFlight) :
+        strategy(strategy),
+        window(std::max(framesInFlight, 1)),
+        inFlight(0),
+        processed(0),
+        stallTime(0)
+    { }
+
+    Strategy * const strategy;
+    const int window;
+    // drained in the strategy thread, never holds more than window statuses
+    std::shared_ptr<StatusQueue> queue;
+    std::atomic<int> inFlight;
+    std::atomic<quint64> processed;
+    std::atomic<qint64> stallTime;
+};
+
+static void backoff(int &round)
 {
-    connect(strategy, SIGNAL(startReadingStatus()), this, SLOT(strategyExecute()), Qt::DirectConnection);
+    // the strategy usually needs a few milliseconds per frame, so stop spinning quickly
+    if (round < 16) {
+        QThread::yieldCurrentThread();
+    } else {
+        QThread::usleep(50);
+    }
+    round++;
+}
+
+BlockingStrategyReplay::BlockingStrategyReplay(Strategy * strategy, int framesInFlight) :
+    m_pipeline(std::make_shared<Pipeline>(strategy, framesInFlight))
+{
+    // the queue may outlive this object until a pending drain request is handled
+    std::weak_ptr<Pipeline> weak = m_pipeline;
+    m_pipeline->queue = std::make_shared<StatusQueue>("replay", strategy, [strategy, weak](const Status &status) {
+        strategy->handleStatus(status);
+        if (auto pipeline = weak.lock()) {
+            pipeline->processed.fetch_add(1, std::memory_order_relaxed);
+            pipeline->inFlight.fetch_sub(1, std::memory_order_release);
+        }
+    }, StatusQueue::Policy::Lossless, m_pipeline->window);
     connect(strategy, SIGNAL(sendStatus(Status)), this, SIGNAL(gotStatus(Status)));
-    connect(this, SIGNAL(gotStatusForStrategy(Status)), strategy, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotCommand(Command)), strategy, SLOT(handleCommand(Command)));
 }
 
-void BlockingStrategyReplay::strategyExecute()
+BlockingStrategyReplay::~BlockingStrategyReplay() = default;
+
+void BlockingStrategyReplay::handleStatus(const Status &status)
 {
-    conditionMutex.lock();
-    cacheCounter--;
-    if (cacheCounter < cacheSize) {
-        conditionMutex.unlock();
-        waitCondition.wakeOne();
-    } else {
-        conditionMutex.unlock();
+    Pipeline &pipeline = *m_pipeline;
+    if (pipeline.strategy->thread() == QThread::currentThread()) {
+        // waiting for the strategy would dead lock, there is nothing to overlap with anyway
+        pipeline.strategy->handleStatus(status);
+        pipeline.processed.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
+
+    if (pipeline.inFlight.load(std::memory_order_acquire) >= pipeline.window) {
+        QElapsedTimer timer;
+        timer.start();
+        int round = 0;
+        while (pipeline.inFlight.load(std::memory_order_acquire) >= pipeline.window) {
+            backoff(round);
+        }
+        pipeline.stallTime.fetch_add(timer.nsecsElapsed(), std::memory_order_relaxed);
+    }
+
+    pipeline.inFlight.fetch_add(1, std::memory_order_relaxed);
+    pipeline.queue->push(status);
 }
 
-void BlockingStrategyReplay::handleStatus(const Status &status)
+void BlockingStrategyReplay::flush()
 {
-    conditionMutex.lock();
-    if (cacheCounter >= cacheSize) {
-        waitCondition.wait(&conditionMutex);
+    int round = 0;
+    while (m_pipeline->inFlight.load(std::memory_order_acquire) > 0) {
+        backoff(round);
     }
-    cacheCounter++;
-    conditionMutex.unlock();
-    emit gotStatusForStrategy(status);
+}
+
+int BlockingStrategyReplay::framesInFlight() const
+{
+    return m_pipeline->window;
+}
+
+quint64 BlockingStrategyReplay::processedFrames() const
+{
+    return m_pipeline->processed.load(std::memory_order_relaxed);
+}
+
+qint64 BlockingStrategyReplay::stallTime() const
+{
+    return m_pipeline->stallTime.load(std::memory_order_relaxed);
 }
 
 // FeedbackStrategyReplay
 FeedbackStrategyReplay::FeedbackStrategyReplay(Strategy * strategy)
 {
     connect(this, SIGNAL(gotStatus(Status)), strategy, SLOT(handleStatus(Status)));
-    connect(strategy, SIGNAL(gotStatus(Status)), this, SLOT(handleStrategyStatus(Status)));
+    // the caller of executeWithFeedback blocks this thread, thus the answer must be handled in the strategy thread
+    connect(strategy, SIGNAL(sendStatus(Status)), this, SLOT(handleStrategyStatus(Status)), Qt::DirectConnection);
 }
 
 Status FeedbackStrategyReplay::executeWithFeedback(const Status &orig)
 {
-    conditionMutex.lock();
+    QMutexLocker locker(&m_conditionMutex);
+    // the strategy answers with the world state it was executed on
+    m_expectedTime = orig->has_execution_state() ? orig->execution_state().time() : orig->world_state().time();
+    m_waiting = true;
+    m_hasStatus = false;
     emit gotStatus(orig);
-    waitCondition.wait(&conditionMutex);
-    Status status(new amun::Status(*lastStatus));
-    conditionMutex.unlock();
+    while (!m_hasStatus) {
+        m_waitCondition.wait(&m_conditionMutex);
+    }
+    m_waiting = false;
+    // hand over the strategy status instead of copying it
+    Status status = std::move(m_lastStatus);
+    m_lastStatus.clear();
     return status;
 }
 
 void FeedbackStrategyReplay::handleStrategyStatus(const Status &status)
 {
-    conditionMutex.lock();
-    lastStatus->CopyFrom(*status);
-    conditionMutex.unlock();
-    waitCondition.wakeOne();
+    // ignore load states, debug output and late answers to previous inputs
+    if (!status->has_execution_state()) {
+        return;
+    }
+    m_conditionMutex.lock();
+    const bool isAnswer = m_waiting && !m_hasStatus && status->execution_state().time() == m_expectedTime;
+    if (isAnswer) {
+        m_lastStatus = status;
+        m_hasStatus = true;
+    }
+    m_conditionMutex.unlock();
+    if (isAnswer) {
+        m_waitCondition.wakeOne();
+    }
 }
@@ -389,11 +389,21 @@ static void trajectorySetOutOfFieldObstaclePriority(const FunctionCallbackInfo<V
     static_cast<QTPath*>(Local<External>::Cast(args.Data())->Value())->trajectoryPath()->world().setOutOfFieldObstaclePriority(static_cast<int>(prio));
 }
 
+static void trajectorySetParallelSampleEvaluation(const FunctionCallbackInfo<Value> &args)
+{
+    Isolate * isolate = args.GetIsolate();
+    if (args.Length() != 1 || !args[0]->IsBoolean()) {
+        isolate->ThrowException(Exception::Error(v8string(isolate, "Invalid arguments")));
+        return;
+    }
+    static_cast<QTPath*>(Local<External>::Cast(args.Data())->Value())->trajectoryPath()->setParallelSampleEvaluation(args[0]->BooleanValue(isolate));
+}
+
 static void trajectoryGetLastTrajectoryAsRobotObstacle(const FunctionCallbackInfo<Value> &args)
 {
     Isolate * isolate = args.GetIsolate();
     auto trajectory = static_cast<QTPath*>(Local<External>::Cast(args.Data())->Value())->trajectoryPath()->getCurrentTrajectory();
-    args.GetReturnValue().Set(External::New(isolate, trajectory));
+    args.GetReturnValue().Set(External::New(isolate, const_cast<SharedTrajectoryPtr*>(trajectory)));
 }
 
 static void trajectoryAddRobotTrajectoryObstacle(const FunctionCallbackInfo<Value> &args)
@@ -403,12 +413,12 @@ static void trajectoryAddRobotTrajectoryObstacle(const FunctionCallbackInfo<Valu
         isolate->ThrowException(Exception::Error(v8string(isolate, "Invalid arguments")));
         return;
     }
-    std::vector<TrajectoryPoint> *obstacle = static_cast<std::vector<TrajectoryPoint>*>(Local<External>::Cast(args[0])->Value());
+    const SharedTrajectoryPtr *obstacle = static_cast<const SharedTrajectoryPtr*>(Local<External>::Cast(args[0])->Value());
     float prio, radius;
     if (!verifyNumber(isolate, args[1], prio) || !verifyNumber(isolate, args[2], radius)) {
         return;
     }
-    static_cast<QTPath*>(Local<External>::Cast(args.Data())->Value())->trajectoryPath()->world().addFriendlyRobotTrajectoryObstacle(obstacle, prio, radius);
+    static_cast<QTPath*>(Local<External>::Cast(args.Data())->Value())->trajectoryPath()->world().addFriendlyRobotTrajectoryObstacle(*obstacle, prio, radius);
 }
 
 static void trajectoryAddOpponentRobotObstacle(const FunctionCallbackInfo<Value> &args)
@@ -506,6 +516,7 @@ static QList<CallbackInfo> trajectoryPathCallbacks = {
     { "addMovingCircle",    trajectoryAddMovingCircle},
     { "addMovingLine",      trajectoryAddMovingLine},
     { "setOutOfFieldPrio",  trajectorySetOutOfFieldObstaclePriority},
+    { "setParallelSampleEvaluation", trajectorySetParallelSampleEvaluation},
     { "getTrajectoryAsObstacle", trajectoryGetLastTrajectoryAsRobotObstacle},
     { "addRobotTrajectoryObstacle", trajectoryAddRobotTrajectoryObstacle},
     { "maxIntersectingObstaclePrio", trajectoryMaxIntersectingObstaclePrio},
@@ -19,12 +19,16 @@
  ***************************************************************************/
 
 #include "amun/amunclient.h"
+#include "amun/lockstepsimulation.h"
 #include "testtools/connector.h"
+#include "core/allocationprofiler.h"
+#include "core/tracing.h"
 
 #include <clocale>
 #include <QCoreApplication>
 #include <QCommandLineParser>
 #include <QProcessEnvironment>
+#include <memory>
 
 int main(int argc, char* argv[])
 {
@@ -56,6 +60,10 @@ int main(int argc, char* argv[])
     QCommandLineOption realismConfig("realism", "Simulator realism configuration (short file name without the .txt)", "realism");
     QCommandLineOption silent("silent", "Do not print any messages");
     QCommandLineOption forceStart({"f", "force-start"}, "Force start the game immediately (Kickoff will be used otherwise)");
+    QCommandLineOption lockstep("lockstep", "Run simulator, processor and strategies in lockstep as fast as possible. The results are reproducible for a given seed, --simulation-speed is ignored");
+    QCommandLineOption seed("seed", "Simulator seed for --lockstep, defaults to 1", "seed", "1");
+    QCommandLineOption latencyTrace("trace", "Write latency trace spans of the last ticks to the specified file (Chrome trace format)", "file");
+    QCommandLineOption allocationProfile("alloc-profile", "Sample heap allocations and write them to the specified file (pprof format)", "file");
     parser.addOption(strategyColorConfig);
     parser.addOption(debugOption);
     parser.addOption(simulatorConfig);
@@ -72,6 +80,10 @@ int main(int argc, char* argv[])
     parser.addOption(realismConfig);
     parser.addOption(silent);
     parser.addOption(forceStart);
+    parser.addOption(lockstep);
+    parser.addOption(seed);
+    parser.addOption(latencyTrace);
+    parser.addOption(allocationProfile);
 
     // parse command line, handles --version
     parser.process(app);
@@ -97,16 +109,36 @@ int main(int argc, char* argv[])
     int simulationRunningTime = parser.value(simulationTime).toInt();
     int numRobots = parser.value(numberOfRobots).toInt();
 
+    Tracing::setEnabled(parser.isSet(latencyTrace));
+    AllocationProfiler::setEnabled(parser.isSet(allocationProfile));
+
     Connector connector;
 
     // compile the strategy beforehand to avoid using old compiles
     connector.compileStrategy(app, initScript);
 
-    AmunClient amun;
-    amun.start(true);
-
-    connector.connect(&connector, &Connector::sendCommand, &amun, &AmunClient::sendCommand);
-    connector.connect(&amun, &AmunClient::gotStatus, &connector, &Connector::handleStatus);
+    std::unique_ptr<AmunClient> amun;
+    std::unique_ptr<LockstepSimulation> lockstepSimulation;
+    if (parser.isSet(lockstep)) {
+        bool validSeed;
+        const uint32_t simulatorSeed = parser.value(seed).toUInt(&validSeed);
+        if (!validSeed) {
+            std::cerr <<"The seed must be a non-negative integer!"<<std::endl;
+            exit(1);
+        }
+        if (parser.isSet(autorefInitScript)) {
+            std::cerr <<"Warning: the game controller used by the autoref runs in real time, the results may not be reproducible"<<std::endl;
+        }
+        lockstepSimulation.reset(new LockstepSimulation(simulatorSeed));
+        connector.connect(&connector, &Connector::sendCommand, lockstepSimulation.get(), &LockstepSimulation::sendCommand);
+        connector.connect(lockstepSimulation.get(), &LockstepSimulation::gotStatus, &connector, &Connector::handleStatus);
+    } else {
+        amun.reset(new AmunClient);
+        amun->start(true);
+
+        connector.connect(&connector, &Connector::sendCommand, amun.get(), &AmunClient::sendCommand);
+        connector.connect(amun.get(), &AmunClient::gotStatus, &connector, &Connector::handleStatus);
+    }
 
     if (parser.isSet(recordLog)) {
         bool record = true;
@@ -164,6 +196,16 @@ int main(int argc, char* argv[])
     }
 
     connector.start();
+    if (lockstepSimulation) {
+        lockstepSimulation->start();
+    }
 
-    return app.exec();
+    const int exitCode = app.exec();
+    if (parser.isSet(latencyTrace) && !Tracing::writeChromeTrace(parser.value(latencyTrace))) {
+        std::cerr <<"Could not write latency trace to "<<parser.value(latencyTrace).toStdString()<<std::endl;
+    }
+    if (parser.isSet(allocationProfile) && !AllocationProfiler::writePprofProfile(parser.value(allocationProfile))) {
+        std::cerr <<"Could not write allocation profile to "<<parser.value(allocationProfile).toStdString()<<std::endl;
+    }
+    return exitCode;
 }
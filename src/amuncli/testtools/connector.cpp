@@ -77,6 +77,8 @@ void Connector::compileStrategy(QCoreApplication &app, QString initScript)
 
 void Connector::delayedExit(int exitCode)
 {
+    // ignore everything after the exit condition, the simulation may run a few more ticks
+    m_exitRequested = true;
     QTimer::singleShot(0, qApp, [exitCode, this]{performExit(exitCode);});
 }
 
@@ -295,6 +297,10 @@ void Connector::reportEvents()
 
 void Connector::handleStatus(const Status &status)
 {
+    if (m_exitRequested) {
+        return;
+    }
+
     emit backlogStatus(status);
 
     m_logfile.writeStatus(status);
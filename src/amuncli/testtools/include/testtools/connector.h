@@ -104,6 +104,7 @@ private:
     bool m_isInCompileMode = false;
     bool m_isSilent = false;
     bool m_forceStart = false;
+    bool m_exitRequested = false;
 
     QString m_simulatorConfigurationFile;
     qint64 m_simulationRunningTime = std::numeric_limits<qint64>::max();
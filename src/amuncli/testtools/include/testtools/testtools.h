@@ -22,10 +22,13 @@
 #define TESTTOOLS_H
 
 #include <QString>
+#include <QStringList>
 #include "protobuf/status.h"
 
 namespace TestTools {
     std::pair<int, bool> toExitCode(const QString &str);
+    // the log lines without html, exit codes are not included
+    QStringList logLines(const amun::DebugValues &debug, int &outExitCode);
     void dumpLog(const amun::DebugValues &debug, int &outExitCode);
     QString stripHTML(const QString &logText);
     void dumpProtobuf(const google::protobuf::Message &message);
@@ -39,8 +39,9 @@ std::pair<int, bool> TestTools::toExitCode(const QString &str)
     return std::make_pair(-1, false);
 }
 
-void TestTools::dumpLog(const amun::DebugValues &debug, int &outExitCode)
+QStringList TestTools::logLines(const amun::DebugValues &debug, int &outExitCode)
 {
+    QStringList lines;
     for (const amun::StatusLog &entry: debug.log()) {
         QString text = stripHTML(QString::fromStdString(entry.text()));
         std::pair<int, bool> exitCodeOpt = toExitCode(text);
@@ -48,9 +49,17 @@ void TestTools::dumpLog(const amun::DebugValues &debug, int &outExitCode)
             // don't print exit codes
             outExitCode = exitCodeOpt.first;
         } else {
-            std::cout << text.toStdString() << std::endl;
+            lines.append(text.split("\n"));
         }
     }
+    return lines;
+}
+
+void TestTools::dumpLog(const amun::DebugValues &debug, int &outExitCode)
+{
+    for (const QString &line : logLines(debug, outExitCode)) {
+        std::cout << line.toStdString() << std::endl;
+    }
 }
 
 void TestTools::dumpProtobuf(const google::protobuf::Message &message)
@@ -0,0 +1,225 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "amun/batchsimulation.h"
+#include "core/configuration.h"
+#include "core/timer.h"
+#include "internalreferee/internalreferee.h"
+#include "seshat/logfilewriter.h"
+#include "testtools/connector.h"
+#include "testtools/testtools.h"
+
+#include <clocale>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+
+static void addStrategyLoad(amun::CommandStrategy *strategy, const QString &initScript, const QString &entryPoint)
+{
+    auto *load = strategy->mutable_load();
+    load->set_filename(initScript.toStdString());
+    if (!entryPoint.isEmpty()) {
+        load->set_entry_point(entryPoint.toStdString());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Batch-Simulator-CLI");
+    app.setOrganizationName("ER-Force");
+
+    std::setlocale(LC_NUMERIC, "C");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs many simulated games in parallel without an event loop");
+    parser.addHelpOption();
+    parser.addPositionalArgument("strategy_file", "Strategy init script");
+    parser.addPositionalArgument("entrypoint", "Entrypoint");
+
+    QCommandLineOption strategyColorConfig({"c", "strategy-color"}, "Color(s) of the strategy to run, either yellow, blue or both, defaults to yellow", "color", "yellow");
+    QCommandLineOption instancesOption({"i", "instances"}, "Number of simulated games. Defaults to one", "instances", "1");
+    QCommandLineOption threadsOption({"j", "threads"}, "Number of worker threads. Defaults to the number of cores", "threads", "0");
+    QCommandLineOption seedOption("seed", "Simulator seed of the first instance, the following instances use consecutive seeds. Defaults to 1", "seed", "1");
+    QCommandLineOption simulationTime({"t", "simulation-time"}, "Number of seconds to simulate per instance. Defaults to 60", "seconds", "60");
+    QCommandLineOption simulatorConfig({"s", "simulator-config"}, "Which simulator config to use (field size etc.), loaded from the config directory", "file");
+    QCommandLineOption numberOfRobots({"n", "num-robots"}, "Number of robots to load per team. Defaults to zero", "num-robots", "0");
+    QCommandLineOption robotGenerationFile("robot-generation", "Robot generation to create the robots of", "generation");
+    QCommandLineOption realismConfig("realism", "Simulator realism configuration (short file name without the .txt)", "realism");
+    QCommandLineOption recordDirectory({"r", "record-directory"}, "Record every game to a log file in the given directory", "directory");
+    QCommandLineOption forceStart({"f", "force-start"}, "Force start the games immediately");
+    QCommandLineOption debugOption({"v", "verbose"}, "Print the strategy log output");
+    parser.addOption(strategyColorConfig);
+    parser.addOption(instancesOption);
+    parser.addOption(threadsOption);
+    parser.addOption(seedOption);
+    parser.addOption(simulationTime);
+    parser.addOption(simulatorConfig);
+    parser.addOption(numberOfRobots);
+    parser.addOption(robotGenerationFile);
+    parser.addOption(realismConfig);
+    parser.addOption(recordDirectory);
+    parser.addOption(forceStart);
+    parser.addOption(debugOption);
+
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 2) {
+        parser.showHelp(1);
+    }
+
+    const QStringList args = parser.positionalArguments();
+    const QString initScript = QDir(".").absoluteFilePath(args.at(0));
+    const QString entryPoint = args.at(1);
+    const QString strategyColor = parser.value(strategyColorConfig);
+    if (strategyColor != "yellow" && strategyColor != "blue" && strategyColor != "both") {
+        std::cerr <<"Invalid strategy color configuration "<<strategyColor.toStdString()<<std::endl;
+        return 1;
+    }
+
+    BatchSimulationConfig config;
+    config.instances = parser.value(instancesOption).toInt();
+    config.threads = parser.value(threadsOption).toInt();
+    config.firstSeed = parser.value(seedOption).toUInt();
+    config.duration = parser.value(simulationTime).toDouble() * 1E9;
+    if (config.instances <= 0 || config.duration <= 0) {
+        std::cerr <<"The number of instances and the simulation time must be positive"<<std::endl;
+        return 1;
+    }
+
+    simulatorSetupSetDefault(config.simulatorSetup);
+    if (parser.isSet(simulatorConfig)
+            && !loadConfiguration("simulator/" + parser.value(simulatorConfig), &config.simulatorSetup, false)) {
+        return 1;
+    }
+
+    // same setup as amun-cli, see Connector::start
+    Command command(new amun::Command);
+    command->mutable_simulator()->set_enable(true);
+    command->mutable_referee()->set_active(true);
+    command->mutable_transceiver()->set_enable(true);
+    command->mutable_transceiver()->set_charge(true);
+    if (strategyColor != "yellow") {
+        addStrategyLoad(command->mutable_strategy_blue(), initScript, entryPoint);
+    }
+    if (strategyColor != "blue") {
+        addStrategyLoad(command->mutable_strategy_yellow(), initScript, entryPoint);
+    }
+
+    const int numRobots = parser.value(numberOfRobots).toInt();
+    if (numRobots > 0) {
+        if (!parser.isSet(robotGenerationFile)) {
+            std::cerr <<"Option robot-generation must be specified with a non-zero robot count"<<std::endl;
+            return 1;
+        }
+        robot::Generation generation;
+        if (!loadConfiguration("robots/" + parser.value(robotGenerationFile), &generation, true)) {
+            return 1;
+        }
+        for (int i = 0;i<numRobots;i++) {
+            robot::Specs *yellow = command->mutable_set_team_yellow()->add_robot();
+            yellow->CopyFrom(generation.default_());
+            yellow->set_id(i);
+            robot::Specs *blue = command->mutable_set_team_blue()->add_robot();
+            blue->CopyFrom(generation.default_());
+            blue->set_id(i > 15 ? i : (15 - i));
+        }
+    }
+    if (parser.isSet(realismConfig)
+            && !loadConfiguration("simulator-realism/" + parser.value(realismConfig), command->mutable_simulator()->mutable_realism_config(), true)) {
+        return 1;
+    }
+    config.commands.append(command);
+
+    if (parser.isSet(forceStart)) {
+        InternalReferee referee;
+        QObject::connect(&referee, &InternalReferee::sendCommand, [&config](const Command &command) {
+            config.commands.append(command);
+        });
+        referee.changeCommand(SSL_Referee::FORCE_START);
+    }
+
+    // compile the strategy beforehand, the instances only load the result
+    Connector connector;
+    connector.compileStrategy(app, initScript);
+
+    std::vector<std::unique_ptr<LogFileWriter>> logWriters;
+    if (parser.isSet(recordDirectory)) {
+        const QDir directory(parser.value(recordDirectory));
+        if (!directory.exists() && !QDir(".").mkpath(directory.path())) {
+            std::cerr <<"Could not create the record directory"<<std::endl;
+            return 1;
+        }
+        for (int i = 0;i<config.instances;i++) {
+            logWriters.emplace_back(new LogFileWriter);
+            if (!logWriters.back()->open(directory.filePath(QString("instance-%1.log").arg(i)))) {
+                std::cerr <<"Could not open the log file for instance "<<i<<std::endl;
+                return 1;
+            }
+        }
+    }
+
+    const bool debug = parser.isSet(debugOption);
+    // the instances run in parallel, their output must not interleave
+    QMutex outputMutex;
+    BatchSimulation simulation(config);
+    simulation.setStatusHandler([&logWriters, &outputMutex, firstSeed = config.firstSeed, debug](int instance, const Status &status) {
+        if (!logWriters.empty()) {
+            logWriters[instance]->writeStatus(status);
+        }
+        if (debug) {
+            const QString prefix = QString("[%1 seed %2] ").arg(instance).arg(firstSeed + instance);
+            std::string output;
+            for (const auto &debugValues : status->debug()) {
+                if (debugValues.source() == amun::StrategyBlue || debugValues.source() == amun::StrategyYellow) {
+                    int exitCode = 0;
+                    for (const QString &line : TestTools::logLines(debugValues, exitCode)) {
+                        output += (prefix + line).toStdString() + "\n";
+                    }
+                }
+            }
+            if (!output.empty()) {
+                QMutexLocker locker(&outputMutex);
+                std::cout << output << std::flush;
+            }
+        }
+    });
+
+    const qint64 startTime = Timer::systemTime();
+    const QList<BatchSimulationResult> results = simulation.run();
+    const double wallTime = (Timer::systemTime() - startTime) * 1E-9;
+
+    bool anyFailed = false;
+    double simulatedTime = 0;
+    for (const BatchSimulationResult &result : results) {
+        std::cout <<"instance "<<result.instance<<" (seed "<<result.seed<<"): "
+                  <<result.simulatedTime * 1E-9<<" s, score blue "<<result.scoreBlue<<" : "<<result.scoreYellow<<" yellow"
+                  <<(result.strategyFailed ? ", strategy failed" : "")<<std::endl;
+        anyFailed |= result.strategyFailed;
+        simulatedTime += result.simulatedTime * 1E-9;
+    }
+    std::cout <<"Simulated "<<simulatedTime<<" s in "<<wallTime<<" s ("<<simulatedTime / wallTime<<"x real time)"<<std::endl;
+
+    return anyFailed ? 1 : 0;
+}
@@ -0,0 +1,258 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "allocationprofiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef Q_OS_LINUX
+#include <dlfcn.h>
+#endif
+
+// These replacements are only linked into the binaries that profile their allocations,
+// everything else keeps the allocation functions of the standard library.
+// malloc is wrapped where the next implementation can be found with dlsym(RTLD_NEXT),
+// a static jemalloc or the sanitizers bring their own malloc
+#if defined(Q_OS_LINUX) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__) && !defined(ALLOCATIONHOOKS_NO_MALLOC)
+#define ALLOCATIONPROFILER_WRAP_MALLOC
+#endif
+
+bool AllocationProfiler::wrapsMalloc()
+{
+#ifdef ALLOCATIONPROFILER_WRAP_MALLOC
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef ALLOCATIONPROFILER_WRAP_MALLOC
+namespace {
+    typedef void *(*MallocFunction)(size_t);
+    typedef void *(*CallocFunction)(size_t, size_t);
+    typedef void *(*ReallocFunction)(void *, size_t);
+    typedef void (*FreeFunction)(void *);
+
+    std::atomic<MallocFunction> nextMalloc{nullptr};
+    std::atomic<CallocFunction> nextCalloc{nullptr};
+    std::atomic<ReallocFunction> nextRealloc{nullptr};
+    std::atomic<FreeFunction> nextFree{nullptr};
+    thread_local bool t_resolving = false;
+
+    // dlsym allocates while the next functions are not known yet,
+    // these allocations are served from a static buffer and never freed
+    alignas(16) char bootstrapBuffer[4096];
+    std::atomic<size_t> bootstrapUsed{0};
+
+    void *bootstrapAllocate(size_t size)
+    {
+        size = (size + 15) & ~size_t(15);
+        const size_t offset = bootstrapUsed.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size > sizeof(bootstrapBuffer)) {
+            return nullptr;
+        }
+        return bootstrapBuffer + offset;
+    }
+
+    bool isBootstrapAllocation(const void *ptr)
+    {
+        return ptr >= bootstrapBuffer && ptr < bootstrapBuffer + sizeof(bootstrapBuffer);
+    }
+
+    // returns false while the current thread is resolving the functions
+    bool resolveNextFunctions()
+    {
+        if (nextFree.load(std::memory_order_acquire)) {
+            return true;
+        }
+        if (t_resolving) {
+            return false;
+        }
+        t_resolving = true;
+        nextMalloc.store(reinterpret_cast<MallocFunction>(dlsym(RTLD_NEXT, "malloc")), std::memory_order_relaxed);
+        nextCalloc.store(reinterpret_cast<CallocFunction>(dlsym(RTLD_NEXT, "calloc")), std::memory_order_relaxed);
+        nextRealloc.store(reinterpret_cast<ReallocFunction>(dlsym(RTLD_NEXT, "realloc")), std::memory_order_relaxed);
+        nextFree.store(reinterpret_cast<FreeFunction>(dlsym(RTLD_NEXT, "free")), std::memory_order_release);
+        t_resolving = false;
+        return true;
+    }
+
+    void *rawAllocate(size_t size)
+    {
+        if (!resolveNextFunctions()) {
+            return bootstrapAllocate(size);
+        }
+        return nextMalloc.load(std::memory_order_relaxed)(size);
+    }
+
+    void rawFree(void *ptr)
+    {
+        if (isBootstrapAllocation(ptr) || !resolveNextFunctions()) {
+            return;
+        }
+        nextFree.load(std::memory_order_relaxed)(ptr);
+    }
+}
+
+// These wrappers catch the allocations made with malloc, most notably the storage of
+// Qt containers, and forward them to the next malloc implementation.
+// posix_memalign and friends are not wrapped, their memory passes through free unnoticed.
+extern "C" void *malloc(size_t size)
+{
+    void *ptr = rawAllocate(size);
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordAllocation(ptr, size);
+    }
+    return ptr;
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    void *ptr;
+    if (!resolveNextFunctions()) {
+        // the buffer is zero initialized and never reused
+        ptr = (size == 0 || count <= sizeof(bootstrapBuffer) / size) ? bootstrapAllocate(count * size) : nullptr;
+    } else {
+        ptr = nextCalloc.load(std::memory_order_relaxed)(count, size);
+    }
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordAllocation(ptr, count * size);
+    }
+    return ptr;
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    if (isBootstrapAllocation(ptr)) {
+        void *result = malloc(size);
+        if (result) {
+            const size_t available = bootstrapBuffer + sizeof(bootstrapBuffer) - static_cast<char*>(ptr);
+            std::memcpy(result, ptr, std::min(size, available));
+        }
+        return result;
+    }
+    if (!resolveNextFunctions()) {
+        return nullptr;
+    }
+    // the old block has to leave the live samples before another thread can get its address,
+    // if realloc fails the block is still alive but no longer tracked
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordFree(ptr);
+    }
+    void *result = nextRealloc.load(std::memory_order_relaxed)(ptr, size);
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordAllocation(result, size);
+    }
+    return result;
+}
+
+extern "C" void free(void *ptr)
+{
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordFree(ptr);
+    }
+    rawFree(ptr);
+}
+#else
+namespace {
+    void *rawAllocate(size_t size)
+    {
+        return std::malloc(size);
+    }
+
+    void rawFree(void *ptr)
+    {
+        std::free(ptr);
+    }
+}
+#endif
+
+// Replacements of the global allocation functions, which count the allocation only once
+// even if malloc is wrapped as well. The aligned variants are left to the standard library.
+// Not inlining them keeps the compiler from matching std::free against operator new.
+Q_NEVER_INLINE void *operator new(std::size_t size)
+{
+    void *ptr;
+    while ((ptr = rawAllocate(size != 0 ? size : 1)) == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordAllocation(ptr, size);
+    }
+    return ptr;
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+Q_NEVER_INLINE void operator delete(void *ptr) noexcept
+{
+    if (AllocationProfiler::isEnabled()) {
+        AllocationProfiler::recordFree(ptr);
+    }
+    rawFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
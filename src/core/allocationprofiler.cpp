@@ -0,0 +1,592 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "allocationprofiler.h"
+#include <QDateTime>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#endif
+
+std::atomic<bool> AllocationProfiler::s_enabled(false);
+
+namespace {
+    const qint64 DEFAULT_SAMPLE_INTERVAL = 512 * 1024;
+    const int MAX_FRAMES = 32;
+    // sampled allocations that are still alive, found by their address
+    const size_t LIVE_SLOTS = 1 << 16;
+    const size_t LIVE_PROBES = 8;
+
+    struct ThreadStats {
+        int id;
+        // only written by the owning thread
+        std::atomic<quint64> allocations{0};
+        std::atomic<quint64> bytes{0};
+        qint64 bytesUntilSample = 0;
+        quint64 randomState = 0;
+    };
+
+    struct Site {
+        // weighted with the number of allocations each sample stands for
+        double allocatedObjects = 0;
+        double allocatedBytes = 0;
+        double liveObjects = 0;
+        double liveBytes = 0;
+        double lifetime = 0;
+    };
+
+    // allocations with the same stack in the same thread
+    struct SiteKey {
+        int thread;
+        std::vector<quintptr> stack;
+
+        bool operator<(const SiteKey &other) const
+        {
+            return thread != other.thread ? thread < other.thread : stack < other.stack;
+        }
+    };
+
+    struct LiveSample {
+        std::atomic<void*> ptr{nullptr};
+        Site *site;
+        qint64 start;
+        double weight;
+        double bytes;
+    };
+
+    struct Registry {
+        QMutex mutex;
+        // threads never unregister, their stats are part of the totals
+        std::vector<std::unique_ptr<ThreadStats>> threads;
+        // by thread id, the name is updated whenever the thread takes a sample
+        std::map<int, QByteArray> threadNames;
+        std::map<SiteKey, Site> sites;
+        std::unique_ptr<LiveSample[]> liveSamples{new LiveSample[LIVE_SLOTS]};
+        std::atomic<int> liveSampleCount{0};
+        std::atomic<qint64> sampleInterval{DEFAULT_SAMPLE_INTERVAL};
+        qint64 enabledSince = 0;
+    };
+
+    // allocations made by the profiler itself are not recorded
+    thread_local bool t_inProfiler = false;
+    thread_local ThreadStats *t_stats = nullptr;
+
+    void resetLiveSamples(Registry &r)
+    {
+        for (size_t i = 0; i < LIVE_SLOTS; i++) {
+            r.liveSamples[i].ptr.store(nullptr, std::memory_order_relaxed);
+        }
+        r.liveSampleCount.store(0, std::memory_order_relaxed);
+    }
+
+    Registry &registry()
+    {
+        // never destroyed, operator delete may still be called after static destructors ran
+        alignas(Registry) static char storage[sizeof(Registry)];
+        static Registry *r = new (storage) Registry;
+        return *r;
+    }
+
+    qint64 now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // xorshift64*, uniformly distributed in (0, 1]
+    double nextRandom(ThreadStats &stats)
+    {
+        stats.randomState ^= stats.randomState >> 12;
+        stats.randomState ^= stats.randomState << 25;
+        stats.randomState ^= stats.randomState >> 27;
+        const quint64 value = stats.randomState * 0x2545F4914F6CDD1DULL;
+        return ((value >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+
+    // the distance between samples is exponentially distributed, which makes
+    // the probability to sample an allocation only depend on its size
+    qint64 nextSampleDistance(ThreadStats &stats)
+    {
+        const double interval = registry().sampleInterval.load(std::memory_order_relaxed);
+        return static_cast<qint64>(-std::log(nextRandom(stats)) * interval) + 1;
+    }
+
+    ThreadStats &threadStats()
+    {
+        if (!t_stats) {
+            t_inProfiler = true;
+            std::unique_ptr<ThreadStats> stats(new ThreadStats);
+            Registry &r = registry();
+            {
+                QMutexLocker locker(&r.mutex);
+                stats->id = static_cast<int>(r.threads.size()) + 1;
+                t_stats = stats.get();
+                r.threads.push_back(std::move(stats));
+            }
+            t_stats->randomState = 0x9E3779B97F4A7C15ULL * static_cast<quint64>(t_stats->id);
+            t_stats->bytesUntilSample = nextSampleDistance(*t_stats);
+            t_inProfiler = false;
+        }
+        return *t_stats;
+    }
+
+    size_t liveSlot(const void *ptr)
+    {
+        // allocations are at least 16 byte aligned
+        const quintptr value = reinterpret_cast<quintptr>(ptr) >> 4;
+        return (value ^ (value >> 16)) * 0x9E3779B97F4A7C15ULL % LIVE_SLOTS;
+    }
+
+    int captureStack(quintptr *frames)
+    {
+#ifdef Q_OS_UNIX
+        void *addresses[MAX_FRAMES];
+        const int count = backtrace(addresses, MAX_FRAMES);
+        for (int i = 0; i < count; i++) {
+            frames[i] = reinterpret_cast<quintptr>(addresses[i]);
+        }
+        return count;
+#else
+        Q_UNUSED(frames);
+        return 0;
+#endif
+    }
+
+    QByteArray currentThreadName(int id)
+    {
+#ifdef Q_OS_UNIX
+        // QThread sets the name of the system thread to its object name,
+        // note that it is truncated to 15 characters on linux
+        char name[64];
+        if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0] != '\0') {
+            return QByteArray(name);
+        }
+#endif
+        return QByteArray("Thread ") + QByteArray::number(id);
+    }
+
+    void takeSample(ThreadStats &stats, void *ptr, std::size_t size)
+    {
+        Registry &r = registry();
+        const double interval = r.sampleInterval.load(std::memory_order_relaxed);
+        // number of allocations of this size that one sample stands for
+        const double weight = 1 / (1 - std::exp(-(static_cast<double>(size) + 1) / interval));
+
+        quintptr frames[MAX_FRAMES];
+        const int frameCount = captureStack(frames);
+        SiteKey key{stats.id, std::vector<quintptr>(frames, frames + frameCount)};
+        const QByteArray threadName = currentThreadName(stats.id);
+
+        QMutexLocker locker(&r.mutex);
+        r.threadNames[stats.id] = threadName;
+        Site &site = r.sites[key];
+        site.allocatedObjects += weight;
+        site.allocatedBytes += weight * size;
+        site.liveObjects += weight;
+        site.liveBytes += weight * size;
+
+        const size_t slot = liveSlot(ptr);
+        for (size_t i = 0; i < LIVE_PROBES; i++) {
+            LiveSample &sample = r.liveSamples[(slot + i) % LIVE_SLOTS];
+            if (sample.ptr.load(std::memory_order_relaxed) == nullptr) {
+                sample.site = &site;
+                sample.start = now();
+                sample.weight = weight;
+                sample.bytes = weight * size;
+                sample.ptr.store(ptr, std::memory_order_relaxed);
+                r.liveSampleCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        // no free slot close to the address, the allocation is counted as never freed
+    }
+
+    class ProtoWriter
+    {
+    public:
+        void varint(int field, quint64 value)
+        {
+            tag(field, 0);
+            appendVarint(value);
+        }
+
+        void bytes(int field, const QByteArray &value)
+        {
+            tag(field, 2);
+            appendVarint(value.size());
+            m_data.append(value);
+        }
+
+        void packed(int field, const std::vector<quint64> &values)
+        {
+            ProtoWriter content;
+            for (quint64 value : values) {
+                content.appendVarint(value);
+            }
+            bytes(field, content.data());
+        }
+
+        const QByteArray &data() const { return m_data; }
+
+    private:
+        void tag(int field, int wireType)
+        {
+            appendVarint((static_cast<quint64>(field) << 3) | wireType);
+        }
+
+        void appendVarint(quint64 value)
+        {
+            while (value >= 0x80) {
+                m_data.append(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            m_data.append(static_cast<char>(value));
+        }
+
+        QByteArray m_data;
+    };
+
+    class StringTable
+    {
+    public:
+        StringTable() { index(QByteArray()); }
+
+        quint64 index(const QByteArray &str)
+        {
+            auto it = m_indices.find(str);
+            if (it != m_indices.end()) {
+                return it->second;
+            }
+            const quint64 result = m_strings.size();
+            m_indices.emplace(str, result);
+            m_strings.push_back(str);
+            return result;
+        }
+
+        const std::vector<QByteArray> &strings() const { return m_strings; }
+
+    private:
+        std::map<QByteArray, quint64> m_indices;
+        std::vector<QByteArray> m_strings;
+    };
+
+    struct Mapping {
+        quint64 id;
+        quintptr start;
+        quintptr limit;
+        quint64 offset;
+        QByteArray filename;
+    };
+
+    // executable segments of the loaded binaries, allows pprof to symbolize the addresses
+    std::vector<Mapping> readMappings()
+    {
+        std::vector<Mapping> mappings;
+#ifdef Q_OS_LINUX
+        QFile maps("/proc/self/maps");
+        if (!maps.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return mappings;
+        }
+        // start-limit permissions offset device inode filename
+        for (const QByteArray &line : maps.readAll().split('\n')) {
+            const QList<QByteArray> parts = line.simplified().split(' ');
+            if (parts.size() < 6 || parts[1].size() < 3 || parts[1][2] != 'x') {
+                continue;
+            }
+            const QList<QByteArray> range = parts[0].split('-');
+            if (range.size() != 2) {
+                continue;
+            }
+            Mapping mapping;
+            mapping.id = mappings.size() + 1;
+            mapping.start = range[0].toULongLong(nullptr, 16);
+            mapping.limit = range[1].toULongLong(nullptr, 16);
+            mapping.offset = parts[2].toULongLong(nullptr, 16);
+            mapping.filename = parts[5];
+            mappings.push_back(mapping);
+        }
+#endif
+        return mappings;
+    }
+
+    QByteArray functionName(quintptr address)
+    {
+#ifdef Q_OS_UNIX
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void*>(address), &info) == 0 || !info.dli_sname) {
+            return QByteArray();
+        }
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            const QByteArray name(demangled);
+            std::free(demangled);
+            return name;
+        }
+        return QByteArray(info.dli_sname);
+#else
+        Q_UNUSED(address);
+        return QByteArray();
+#endif
+    }
+}
+
+void AllocationProfiler::setEnabled(bool enabled)
+{
+    if (enabled && !isEnabled()) {
+        Registry &r = registry();
+        QMutexLocker locker(&r.mutex);
+        r.enabledSince = now();
+        // frees were not tracked while disabled, the addresses may belong to other allocations by now
+        resetLiveSamples(r);
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void AllocationProfiler::setSampleInterval(qint64 bytes)
+{
+    registry().sampleInterval.store(std::max<qint64>(bytes, 1), std::memory_order_relaxed);
+}
+
+AllocationProfiler::Totals AllocationProfiler::totals()
+{
+    Totals result;
+    Registry &r = registry();
+    QMutexLocker locker(&r.mutex);
+    for (const auto &stats : r.threads) {
+        result.allocations += stats->allocations.load(std::memory_order_relaxed);
+        result.bytes += stats->bytes.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void AllocationProfiler::recordAllocation(void *ptr, std::size_t size)
+{
+    if (t_inProfiler || !ptr) {
+        return;
+    }
+    ThreadStats &stats = threadStats();
+    // no other thread writes these, avoid the cost of an atomic increment
+    stats.allocations.store(stats.allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    stats.bytes.store(stats.bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+
+    stats.bytesUntilSample -= static_cast<qint64>(size);
+    if (stats.bytesUntilSample > 0) {
+        return;
+    }
+
+    t_inProfiler = true;
+    stats.bytesUntilSample = nextSampleDistance(stats);
+    takeSample(stats, ptr, size);
+    t_inProfiler = false;
+}
+
+void AllocationProfiler::recordFree(void *ptr)
+{
+    Registry &r = registry();
+    if (t_inProfiler || !ptr || r.liveSampleCount.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    const size_t slot = liveSlot(ptr);
+    for (size_t i = 0; i < LIVE_PROBES; i++) {
+        LiveSample &sample = r.liveSamples[(slot + i) % LIVE_SLOTS];
+        // the slot of ptr can only change while ptr is allocated, so the unlocked check is safe
+        if (sample.ptr.load(std::memory_order_relaxed) != ptr) {
+            continue;
+        }
+
+        QMutexLocker locker(&r.mutex);
+        if (sample.ptr.load(std::memory_order_relaxed) == ptr) {
+            sample.site->liveObjects -= sample.weight;
+            sample.site->liveBytes -= sample.bytes;
+            sample.site->lifetime += sample.weight * (now() - sample.start);
+            sample.ptr.store(nullptr, std::memory_order_relaxed);
+            r.liveSampleCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+}
+
+QByteArray AllocationProfiler::pprofProfile()
+{
+    // see https://github.com/google/pprof/blob/main/proto/profile.proto for the field numbers
+    const bool wasInProfiler = t_inProfiler;
+    t_inProfiler = true;
+
+    Registry &r = registry();
+    std::map<SiteKey, Site> sites;
+    std::map<int, QByteArray> threadNames;
+    qint64 enabledSince;
+    {
+        QMutexLocker locker(&r.mutex);
+        sites = r.sites;
+        threadNames = r.threadNames;
+        enabledSince = r.enabledSince;
+    }
+
+    StringTable strings;
+    ProtoWriter profile;
+
+    const char *sampleTypes[][2] = {
+        {"alloc_objects", "count"},
+        {"alloc_space", "bytes"},
+        {"inuse_objects", "count"},
+        {"inuse_space", "bytes"},
+        // sum over all freed allocations, divide by the freed objects for the mean lifetime
+        {"lifetime", "nanoseconds"},
+    };
+    for (const auto &type : sampleTypes) {
+        ProtoWriter valueType;
+        valueType.varint(1, strings.index(type[0]));
+        valueType.varint(2, strings.index(type[1]));
+        profile.bytes(1, valueType.data());
+    }
+
+    const std::vector<Mapping> mappings = readMappings();
+    std::map<quintptr, quint64> locationIds;
+    std::map<QByteArray, quint64> functionIds;
+    ProtoWriter locations;
+    ProtoWriter functions;
+    const quint64 threadKey = strings.index("thread");
+
+    for (const auto &[key, site] : sites) {
+        std::vector<quint64> stack;
+        for (quintptr frame : key.stack) {
+            // return addresses point behind the call
+            const quintptr address = frame - 1;
+            auto it = locationIds.find(address);
+            if (it == locationIds.end()) {
+                const quint64 id = locationIds.size() + 1;
+                it = locationIds.emplace(address, id).first;
+
+                ProtoWriter location;
+                location.varint(1, id);
+                for (const Mapping &mapping : mappings) {
+                    if (mapping.start <= address && address < mapping.limit) {
+                        location.varint(2, mapping.id);
+                        break;
+                    }
+                }
+                location.varint(3, address);
+                const QByteArray name = functionName(address);
+                if (!name.isEmpty()) {
+                    auto function = functionIds.find(name);
+                    if (function == functionIds.end()) {
+                        function = functionIds.emplace(name, functionIds.size() + 1).first;
+                        ProtoWriter functionProto;
+                        functionProto.varint(1, function->second);
+                        functionProto.varint(2, strings.index(name));
+                        functionProto.varint(3, strings.index(name));
+                        functions.bytes(5, functionProto.data());
+                    }
+                    ProtoWriter line;
+                    line.varint(1, function->second);
+                    location.bytes(4, line.data());
+                }
+                locations.bytes(4, location.data());
+            }
+            stack.push_back(it->second);
+        }
+
+        ProtoWriter sample;
+        sample.packed(1, stack);
+        sample.packed(2, {
+            static_cast<quint64>(std::llround(site.allocatedObjects)),
+            static_cast<quint64>(std::llround(site.allocatedBytes)),
+            static_cast<quint64>(std::llround(std::max(site.liveObjects, 0.0))),
+            static_cast<quint64>(std::llround(std::max(site.liveBytes, 0.0))),
+            static_cast<quint64>(std::llround(site.lifetime))
+        });
+        ProtoWriter label;
+        label.varint(1, threadKey);
+        const auto name = threadNames.find(key.thread);
+        label.varint(2, strings.index(name != threadNames.end() ? name->second : QByteArray::number(key.thread)));
+        sample.bytes(3, label.data());
+        profile.bytes(2, sample.data());
+    }
+
+    for (const Mapping &mapping : mappings) {
+        ProtoWriter mappingProto;
+        mappingProto.varint(1, mapping.id);
+        mappingProto.varint(2, mapping.start);
+        mappingProto.varint(3, mapping.limit);
+        mappingProto.varint(4, mapping.offset);
+        mappingProto.varint(5, strings.index(mapping.filename));
+        profile.bytes(3, mappingProto.data());
+    }
+    QByteArray result = profile.data() + locations.data() + functions.data();
+
+    ProtoWriter trailer;
+    // hide the profiler and operator new itself
+    trailer.varint(7, strings.index("operator new.*"));
+    trailer.varint(9, static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000 * 1000);
+    trailer.varint(10, enabledSince != 0 ? static_cast<quint64>(now() - enabledSince) : 0);
+    ProtoWriter periodType;
+    periodType.varint(1, strings.index("space"));
+    periodType.varint(2, strings.index("bytes"));
+    trailer.bytes(11, periodType.data());
+    trailer.varint(12, r.sampleInterval.load(std::memory_order_relaxed));
+    trailer.varint(14, strings.index("alloc_space"));
+    // every string has been interned at this point, so the table is complete
+    for (const QByteArray &str : strings.strings()) {
+        trailer.bytes(6, str);
+    }
+    result.append(trailer.data());
+
+    t_inProfiler = wasInProfiler;
+    return result;
+}
+
+bool AllocationProfiler::writePprofProfile(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray profile = pprofProfile();
+    return file.write(profile) == profile.size();
+}
+
+void AllocationProfiler::clear()
+{
+    const bool wasInProfiler = t_inProfiler;
+    t_inProfiler = true;
+    Registry &r = registry();
+    {
+        QMutexLocker locker(&r.mutex);
+        resetLiveSamples(r);
+        r.sites.clear();
+    }
+    t_inProfiler = wasInProfiler;
+}
@@ -0,0 +1,69 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef ALLOCATIONPROFILER_H
+#define ALLOCATIONPROFILER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <cstddef>
+
+// Counts the heap allocations made through operator new and, on linux, malloc per thread
+// and samples the call stacks of roughly one allocation per sample interval bytes.
+// The samples are aggregated per call site and thread, including the lifetime of
+// freed allocations, and can be exported as a pprof profile (https://github.com/google/pprof).
+// On other platforms the malloc'd storage of Qt containers is not seen.
+// The allocation function replacements live in the allocationhooks object library, which has
+// to be added to the sources of a binary, the profiler sees nothing in binaries without it.
+// While disabled, the replacements only check an atomic flag.
+class AllocationProfiler
+{
+public:
+    struct Totals {
+        quint64 allocations = 0;
+        quint64 bytes = 0;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    // average number of allocated bytes between two samples, defaults to 512 KiB
+    static void setSampleInterval(qint64 bytes);
+
+    // allocations of all threads while the profiler was enabled, never reset
+    static Totals totals();
+
+    // sampled allocations of all threads, including ones that already finished
+    static QByteArray pprofProfile();
+    static bool writePprofProfile(const QString &filename);
+    // drops all samples, but keeps the totals
+    static void clear();
+
+    // called by the operator new and delete replacements
+    static void recordAllocation(void *ptr, std::size_t size);
+    static void recordFree(void *ptr);
+    // whether malloc is replaced as well, defined with the replacements
+    static bool wrapsMalloc();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+#endif // ALLOCATIONPROFILER_H
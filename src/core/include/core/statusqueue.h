@@ -0,0 +1,115 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef STATUSQUEUE_H
+#define STATUSQUEUE_H
+
+#include "protobuf/status.h"
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+//! Bounded lock-free queue of status messages which is drained on the thread of its context object.
+//! A single queued invocation is posted per batch instead of one event per status.
+//! Multi-producer multi-consumer, see
+//! http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//! consumers are needed as well, since DropOldest evicts from the pushing thread.
+//! Must be owned by a std::shared_ptr, pending drain requests only keep a weak reference.
+class StatusQueue : public std::enable_shared_from_this<StatusQueue>
+{
+public:
+    enum class Policy {
+        // discard the oldest queued status if the queue is full
+        DropOldest,
+        // never discard anything, a full ring spills into an unbounded overflow list
+        Lossless
+    };
+
+    struct Metrics {
+        QString name;
+        int depth;
+        int capacity;
+        quint64 delivered;
+        quint64 dropped;
+        // latency between pushing and handling, in nanoseconds
+        qint64 meanLatency;
+        qint64 maxLatency;
+    };
+
+    typedef std::function<void(const Status &)> Handler;
+
+public:
+    // the capacity is rounded up to the next power of two
+    StatusQueue(const QString &name, QObject *context, Handler handler, Policy policy, int capacity);
+    StatusQueue(const StatusQueue&) = delete;
+    StatusQueue& operator=(const StatusQueue&) = delete;
+
+    // thread safe
+    void push(const Status &status);
+    // called in the thread of the context by the drain request, handles everything queued until then
+    void drain();
+    Metrics metrics(bool reset);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Status status;
+        qint64 time;
+    };
+
+    struct Entry {
+        Status status;
+        qint64 time;
+    };
+
+    bool tryPush(const Status &status, qint64 time);
+    bool tryPop(Entry &entry);
+    void handle(const Entry &entry);
+    void notify();
+
+private:
+    const QString m_name;
+    const QPointer<QObject> m_context;
+    const Handler m_handler;
+    const Policy m_policy;
+
+    std::unique_ptr<Cell[]> m_cells;
+    const size_t m_mask;
+    // keep producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;
+    alignas(64) std::atomic<bool> m_notified;
+
+    // only used by Lossless queues once the ring is full
+    QMutex m_overflowMutex;
+    std::deque<Entry> m_overflow;
+    std::atomic<int> m_overflowSize;
+
+    std::atomic<quint64> m_delivered;
+    std::atomic<quint64> m_dropped;
+    std::atomic<qint64> m_totalLatency;
+    std::atomic<qint64> m_maxLatency;
+};
+
+#endif // STATUSQUEUE_H
@@ -35,6 +35,7 @@ public:
     void setScaling(double scaling);
     void reset();
     qint64 currentTime() const;
+    qint64 timeAt(qint64 systemTime) const;
     void setTime(qint64 time, double scaling);
 
 signals:
@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// Records timed spans into a ring buffer per thread, which can be exported in the
+// Chrome trace event format (chrome://tracing, https://ui.perfetto.dev).
+// Recording is disabled by default, a disabled span only costs a relaxed atomic load.
+class Tracing
+{
+public:
+    static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    // monotonic clock in nanoseconds, unrelated to Timer::systemTime
+    static qint64 now();
+
+    // name must be a string literal, tick identifies the frame the work belongs to (0 if none)
+    static void record(const char *name, qint64 start, qint64 end, qint64 tick);
+
+    // spans of all threads, including ones that already finished
+    static QByteArray chromeTrace();
+    static bool writeChromeTrace(const QString &filename);
+    static void clear();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name, qint64 tick = 0) :
+        m_name(name),
+        m_tick(tick),
+        m_start(Tracing::isEnabled() ? Tracing::now() : 0)
+    { }
+
+    ~TraceSpan()
+    {
+        if (m_start != 0) {
+            Tracing::record(m_name, m_start, Tracing::now(), m_tick);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // for spans whose tick is only known after they started
+    void setTick(qint64 tick) { m_tick = tick; }
+
+private:
+    const char *m_name;
+    qint64 m_tick;
+    const qint64 m_start;
+};
+
+#endif // TRACING_H
@@ -0,0 +1,210 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "statusqueue.h"
+#include "tracing.h"
+#include <QMetaObject>
+#include <QMutexLocker>
+
+static size_t roundUpToPowerOfTwo(int value)
+{
+    size_t result = 2;
+    while (result < static_cast<size_t>(value)) {
+        result *= 2;
+    }
+    return result;
+}
+
+StatusQueue::StatusQueue(const QString &name, QObject *context, Handler handler, Policy policy, int capacity) :
+    m_name(name),
+    m_context(context),
+    m_handler(handler),
+    m_policy(policy),
+    m_cells(new Cell[roundUpToPowerOfTwo(capacity)]),
+    m_mask(roundUpToPowerOfTwo(capacity) - 1),
+    m_enqueuePos(0),
+    m_dequeuePos(0),
+    m_notified(false),
+    m_overflowSize(0),
+    m_delivered(0),
+    m_dropped(0),
+    m_totalLatency(0),
+    m_maxLatency(0)
+{
+    for (size_t i = 0; i <= m_mask; i++) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        m_cells[i].time = 0;
+    }
+}
+
+bool StatusQueue::tryPush(const Status &status, qint64 time)
+{
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = m_cells[pos & m_mask];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.status = status;
+                cell.time = time;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // full
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool StatusQueue::tryPop(Entry &entry)
+{
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = m_cells[pos & m_mask];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                entry.status = cell.status;
+                entry.time = cell.time;
+                // release the reference held by the ring right away
+                cell.status.clear();
+                cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // empty
+            return false;
+        } else {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void StatusQueue::push(const Status &status)
+{
+    const qint64 time = Tracing::now();
+    if (m_policy == Policy::DropOldest) {
+        Entry oldest;
+        while (!tryPush(status, time)) {
+            if (tryPop(oldest)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    } else if (m_overflowSize.load(std::memory_order_acquire) > 0 || !tryPush(status, time)) {
+        // once statuses spill over, keep appending to the overflow list to preserve their order
+        QMutexLocker locker(&m_overflowMutex);
+        m_overflow.push_back({status, time});
+        m_overflowSize.store(static_cast<int>(m_overflow.size()), std::memory_order_release);
+    }
+    notify();
+}
+
+void StatusQueue::notify()
+{
+    // post at most one drain request, it handles everything queued until then
+    if (m_notified.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    QObject *context = m_context.data();
+    if (!context) {
+        return;
+    }
+    // the bus may be destroyed before the request is handled
+    std::weak_ptr<StatusQueue> weak = shared_from_this();
+    QMetaObject::invokeMethod(context, [weak]() {
+        if (auto queue = weak.lock()) {
+            queue->drain();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void StatusQueue::handle(const Entry &entry)
+{
+    const qint64 now = Tracing::now();
+    const qint64 latency = now - entry.time;
+    if (Tracing::isEnabled()) {
+        // shows the wakeup delay of the subscriber thread
+        const qint64 tick = entry.status->has_world_state() ? entry.status->world_state().time() : 0;
+        Tracing::record("StatusQueue::queued", entry.time, now, tick);
+    }
+    m_totalLatency.fetch_add(latency, std::memory_order_relaxed);
+    qint64 maxLatency = m_maxLatency.load(std::memory_order_relaxed);
+    while (latency > maxLatency
+           && !m_maxLatency.compare_exchange_weak(maxLatency, latency, std::memory_order_relaxed)) {
+    }
+    m_delivered.fetch_add(1, std::memory_order_relaxed);
+    m_handler(entry.status);
+}
+
+void StatusQueue::drain()
+{
+    // reset before popping, a status pushed afterwards triggers another drain
+    m_notified.exchange(false, std::memory_order_acq_rel);
+
+    Entry entry;
+    for (;;) {
+        while (tryPop(entry)) {
+            handle(entry);
+        }
+        if (m_overflowSize.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+        // the ring is empty now, everything in the overflow list is newer
+        std::deque<Entry> overflow;
+        {
+            QMutexLocker locker(&m_overflowMutex);
+            overflow.swap(m_overflow);
+            m_overflowSize.store(0, std::memory_order_release);
+        }
+        for (const Entry &e : overflow) {
+            handle(e);
+        }
+    }
+}
+
+StatusQueue::Metrics StatusQueue::metrics(bool reset)
+{
+    Metrics metrics;
+    metrics.name = m_name;
+    const size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+    const size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+    metrics.depth = static_cast<int>(enqueued >= dequeued ? enqueued - dequeued : 0)
+            + m_overflowSize.load(std::memory_order_relaxed);
+    metrics.capacity = static_cast<int>(m_mask + 1);
+    if (reset) {
+        metrics.delivered = m_delivered.exchange(0, std::memory_order_relaxed);
+        metrics.dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        metrics.maxLatency = m_maxLatency.exchange(0, std::memory_order_relaxed);
+        metrics.meanLatency = m_totalLatency.exchange(0, std::memory_order_relaxed);
+    } else {
+        metrics.delivered = m_delivered.load(std::memory_order_relaxed);
+        metrics.dropped = m_dropped.load(std::memory_order_relaxed);
+        metrics.maxLatency = m_maxLatency.load(std::memory_order_relaxed);
+        metrics.meanLatency = m_totalLatency.load(std::memory_order_relaxed);
+    }
+    if (metrics.delivered > 0) {
+        metrics.meanLatency /= static_cast<qint64>(metrics.delivered);
+    }
+    return metrics;
+}
@@ -72,8 +72,17 @@ void Timer::reset()
  */
 qint64 Timer::currentTime() const
 {
-    const qint64 sys = systemTime();
-    return m_offset + (qint64)((sys - m_start) * m_scaling);
+    return timeAt(systemTime());
+}
+
+/*!
+ * \brief Convert a system time to internal time
+ * \param systemTime Time as returned by \ref systemTime, e.g. a kernel receive timestamp
+ * \return The internal time in nanoseconds
+ */
+qint64 Timer::timeAt(qint64 systemTime) const
+{
+    return m_offset + (qint64)((systemTime - m_start) * m_scaling);
 }
 
 /*!
@@ -0,0 +1,178 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "tracing.h"
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+std::atomic<bool> Tracing::s_enabled(false);
+
+namespace {
+    struct Span {
+        const char *name;
+        qint64 start;
+        qint64 end;
+        qint64 tick;
+    };
+
+    // enough for a few seconds of tracing at several spans per tick
+    const int SPANS_PER_THREAD = 16384;
+
+    struct ThreadBuffer {
+        QString name;
+        int id;
+        // only contended while exporting
+        QMutex mutex;
+        std::vector<Span> spans;
+        size_t written = 0;
+    };
+
+    struct Registry {
+        QMutex mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry &registry()
+    {
+        static Registry r;
+        return r;
+    }
+
+    ThreadBuffer &threadBuffer()
+    {
+        // the registry keeps the buffer alive after the thread has finished
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            buffer->spans.resize(SPANS_PER_THREAD);
+            Registry &r = registry();
+            QMutexLocker locker(&r.mutex);
+            buffer->id = static_cast<int>(r.buffers.size()) + 1;
+            const QThread *thread = QThread::currentThread();
+            buffer->name = (thread && !thread->objectName().isEmpty())
+                    ? thread->objectName() : QString("Thread %1").arg(buffer->id);
+            r.buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void appendEscaped(QByteArray &out, const QByteArray &str)
+    {
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                out.append('\\');
+                out.append(c);
+            } else if (static_cast<unsigned char>(c) >= 0x20) {
+                out.append(c);
+            }
+        }
+    }
+}
+
+qint64 Tracing::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracing::record(const char *name, qint64 start, qint64 end, qint64 tick)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    QMutexLocker locker(&buffer.mutex);
+    buffer.spans[buffer.written % SPANS_PER_THREAD] = {name, start, end, tick};
+    buffer.written++;
+}
+
+QByteArray Tracing::chromeTrace()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        Registry &r = registry();
+        QMutexLocker locker(&r.mutex);
+        buffers = r.buffers;
+    }
+
+    QByteArray out("{\"traceEvents\":[");
+    bool first = true;
+    auto separate = [&out, &first]() {
+        if (!first) {
+            out.append(",\n");
+        }
+        first = false;
+    };
+
+    for (const auto &buffer : buffers) {
+        separate();
+        out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        out.append(QByteArray::number(buffer->id));
+        out.append(",\"args\":{\"name\":\"");
+        appendEscaped(out, buffer->name.toUtf8());
+        out.append("\"}}");
+
+        QMutexLocker locker(&buffer->mutex);
+        const size_t count = std::min(buffer->written, static_cast<size_t>(SPANS_PER_THREAD));
+        for (size_t i = buffer->written - count; i < buffer->written; i++) {
+            const Span &span = buffer->spans[i % SPANS_PER_THREAD];
+            separate();
+            // timestamps are in microseconds
+            out.append("{\"name\":\"");
+            appendEscaped(out, span.name);
+            out.append("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+            out.append(QByteArray::number(buffer->id));
+            out.append(",\"ts\":");
+            out.append(QByteArray::number(span.start / 1000.0, 'f', 3));
+            out.append(",\"dur\":");
+            out.append(QByteArray::number((span.end - span.start) / 1000.0, 'f', 3));
+            if (span.tick != 0) {
+                out.append(",\"args\":{\"tick\":");
+                out.append(QByteArray::number(span.tick));
+                out.append("}");
+            }
+            out.append("}");
+        }
+    }
+    out.append("],\"displayTimeUnit\":\"ms\"}\n");
+    return out;
+}
+
+bool Tracing::writeChromeTrace(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray trace = chromeTrace();
+    return file.write(trace) == trace.size();
+}
+
+void Tracing::clear()
+{
+    Registry &r = registry();
+    QMutexLocker locker(&r.mutex);
+    for (const auto &buffer : r.buffers) {
+        QMutexLocker bufferLocker(&buffer->mutex);
+        buffer->written = 0;
+    }
+}
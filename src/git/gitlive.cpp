@@ -30,6 +30,7 @@
 #include "git2/errors.h"
 #include "git2/apply.h"
 #include "git2/index.h"
+#include "git2/patch.h"
 
 
 #include <iostream>
@@ -38,8 +39,11 @@
 #include <cassert>
 #include <cstring>
 
+#include <map>
 #include <vector>
 
+#include <QDateTime>
+#include <QFileInfo>
 #include <QMutexLocker>
 
 #define GIT_RAII(pointer, cleanup) std::unique_ptr<std::remove_reference<decltype(*pointer)>::type, void(*)(decltype(pointer))> raii_##pointer{pointer, cleanup}
@@ -80,7 +84,7 @@ struct Git_tree_raii {
         if (commit) {
             git_commit_free(commit);
         }
-        if (repo) {
+        if (repo && owns_repo) {
             git_repository_free(repo);
         }
     }
@@ -89,6 +93,8 @@ struct Git_tree_raii {
 
     std::string errorMsg;
     git_repository* repo = nullptr;
+    // false if repo is a persistent handle from open_repository
+    bool owns_repo = true;
     git_oid oid;
     git_commit* commit = nullptr;
     git_tree* tree = nullptr;
@@ -98,17 +104,74 @@ struct Git_tree_raii {
 
 QMutex mutex{QMutex::Recursive};
 
-/* Populates Git_tree_raii with repo and oid,
- * assummes mutex to be locked and libgit running */
-static void populate_oid(Git_tree_raii& in, const char* path, const char* tree_ish) {
-    int exitcode;
+/* The diff text of a single file, together with everything it was computed from.
+ * Files in the working directory are identified by their mtime and size,
+ * so that their content does not have to be read and diffed again */
+struct CachedFileDiff {
+    git_oid old_id;
+    git_delta_t status;
+    qint64 mtime;
+    qint64 size;
+    // when the file was read for the diff, in ms since epoch
+    qint64 created;
+    bool has_hunks = false;
+    std::string text;
+    std::string errorMsgs;
+};
 
-    exitcode = git_repository_open_ext(&in.repo, path, 0, NULL);
+struct Repository_handle {
+    Repository_handle() = default;
+    ~Repository_handle() {
+        if (repo) {
+            git_repository_free(repo);
+        }
+    }
+    Repository_handle(const Repository_handle&) = delete;
+    Repository_handle& operator=(const Repository_handle&) = delete;
+
+    git_repository* repo = nullptr;
+    // keyed by the path relative to the working directory
+    std::map<std::string, CachedFileDiff> file_diffs;
+};
+
+/* Repositories are opened once per path and kept until the program exits,
+ * only to be used with the mutex locked */
+static std::map<std::string, std::unique_ptr<Repository_handle>> open_repositories;
+
+/* Returns the persistent handle for the repository containing path,
+ * assummes mutex to be locked */
+static Repository_handle* open_repository(const char* path, std::string& errorMsg) {
+    auto it = open_repositories.find(path);
+    if (it != open_repositories.end()) {
+        return it->second.get();
+    }
+
+    // the open repositories must outlive every libgit2 user, therefore keep one reference forever
+    static const bool libgit2_initialized = git_libgit2_init() > 0;
+    if (!libgit2_initialized) {
+        errorMsg = "error in git_libgit2_init";
+        return nullptr;
+    }
+
+    std::unique_ptr<Repository_handle> handle{new Repository_handle};
+    int exitcode = git_repository_open_ext(&handle->repo, path, 0, NULL);
     if (exitcode) {
-        in.repo = nullptr;
-        in.errorMsg = "error in git_repository_open_ext " + std::to_string(exitcode);
-        return;
+        handle->repo = nullptr;
+        errorMsg = "error in git_repository_open_ext " + std::to_string(exitcode);
+        return nullptr;
     }
+    Repository_handle* result = handle.get();
+    open_repositories.emplace(path, std::move(handle));
+    return result;
+}
+
+/* Populates Git_tree_raii with the oid of tree_ish in an already opened repo,
+ * assummes mutex to be locked and libgit running */
+static void resolve_oid(Git_tree_raii& in, git_repository* repo, const char* tree_ish) {
+    int exitcode;
+
+    in.repo = repo;
+    in.owns_repo = false;
 
     git_object *tmp;
     exitcode = git_revparse_single(&tmp, in.repo, tree_ish);
@@ -143,8 +206,8 @@ static void fill_tree(Git_tree_raii& in) {
     }
 }
 
-static void populate_tree(Git_tree_raii& in, const char* path, const char* tree_ish) {
-    populate_oid(in, path, tree_ish);
+static void populate_tree(Git_tree_raii& in, git_repository* repo, const char* tree_ish) {
+    resolve_oid(in, repo, tree_ish);
     if (in.errorMsg.size() != 0) {
         return;
     }
@@ -181,166 +244,134 @@ std::string gitconfig::getLiveCommitHash(const char* path) {
 }
 */
 
-struct HunkDiff {
-    char* hunk_header = nullptr;
-    size_t hunk_header_len = 0;
-    std::string text;
-
-    ~HunkDiff() {
-        free(hunk_header);
-    }
-
-    explicit HunkDiff(const char* line, size_t len) {
-        hunk_header = static_cast<char*>(malloc(sizeof(char) * len));
-        strncpy(hunk_header, line, len);
-        hunk_header_len = len;
-    }
-
-    HunkDiff(const HunkDiff&) = delete;
-    HunkDiff(HunkDiff&& other) : text(std::move(other.text)) {
-        this->hunk_header = other.hunk_header;
-        this->hunk_header_len = other.hunk_header_len;
-        other.hunk_header = nullptr;
-        other.hunk_header_len = 0;
-    }
-    HunkDiff& operator=(const HunkDiff&) = delete;
-};
-
-struct FileDiff {
-    char* file_header = nullptr;
-    size_t file_header_len = 0;
-    std::vector<HunkDiff> hunks;
-    std::string errorMsgs;
-
-    ~FileDiff() {
-        free(file_header);
-    }
-
-    explicit FileDiff(const char* line, size_t len) {
-        file_header = static_cast<char*>(malloc(sizeof(char) * len));
-        strncpy(file_header, line, len);
-        file_header_len = len;
-    }
-
-    FileDiff(const FileDiff&) = delete;
-    FileDiff(FileDiff&& other) : hunks(std::move(other.hunks)), errorMsgs(std::move(other.errorMsgs)) {
-        this->file_header = other.file_header;
-        this->file_header_len = other.file_header_len;
-        other.file_header = nullptr;
-        other.file_header_len = 0;
-    }
-    FileDiff& operator=(const FileDiff&) = delete;
-};
-
-static int print_to_vector_file_diff(const git_diff_delta *, const git_diff_hunk *, const git_diff_line *l, void* payload) {
-    std::vector<FileDiff>* out = static_cast<std::vector<FileDiff>*>(payload);
+/* Appends the patch of a single file to a CachedFileDiff.
+ * The file header is only part of the output if at least one hunk follows */
+static int print_to_file_diff(const git_diff_delta *, const git_diff_hunk *, const git_diff_line *l, void* payload) {
+    CachedFileDiff* out = static_cast<CachedFileDiff*>(payload);
     switch(l->origin) {
         case GIT_DIFF_LINE_FILE_HDR:
-            out->emplace_back(l->content, l->content_len);
+            out->text.append(l->content, l->content_len);
             break;
         case GIT_DIFF_LINE_HUNK_HDR:
-            out->back().hunks.emplace_back(l->content, l->content_len);
+            out->has_hunks = true;
+            out->text.append(l->content, l->content_len);
             break;
         case GIT_DIFF_LINE_CONTEXT:
         case GIT_DIFF_LINE_ADDITION:
         case GIT_DIFF_LINE_DELETION:
-            out->back().hunks.back().text.push_back(l->origin);
-            out->back().hunks.back().text.append(l->content, l->content_len);
+            out->text.push_back(l->origin);
+            out->text.append(l->content, l->content_len);
             break;
         default:
-            out->back().errorMsgs.append("Error in ");
-            out->back().errorMsgs.append(__func__);
-            out->back().errorMsgs.append(" : unknown l->origin: ");
-            out->back().errorMsgs.push_back(l->origin);
-            out->back().errorMsgs.push_back('\n');
-            out->back().errorMsgs.append(l->content, l->content_len);
+            out->errorMsgs.append("Error in ");
+            out->errorMsgs.append(__func__);
+            out->errorMsgs.append(" : unknown l->origin: ");
+            out->errorMsgs.push_back(l->origin);
+            out->errorMsgs.push_back('\n');
+            out->errorMsgs.append(l->content, l->content_len);
             break;
     }
     return 0;
 }
 
-static std::string convert_file_diffs_to_string(std::vector<FileDiff>&& data) {
+/* Files modified this shortly before they were diffed may change again
+ * without a visible mtime change (racy clean, see git's racy-git documentation) */
+static const qint64 RACY_CLEAN_WINDOW_MS = 2000;
+
+/* Prints all file patches of diff in a single pass.
+ * If cache is given, the new side of the diff has to be the working directory of repo.
+ * Files whose old blob, mtime and size did not change since the last call reuse their
+ * previously printed patch, all other files are diffed again and replace the cache */
+static std::string print_diff(git_diff* diff, git_repository* repo, std::map<std::string, CachedFileDiff>* cache, std::string& errorMsg) {
     std::string out;
     std::string errors;
-    for(auto it = data.begin(); it != data.end(); ++it) {
-        if (it->errorMsgs.size() != 0) {
-            errors += it->errorMsgs;
+    std::map<std::string, CachedFileDiff> used_diffs;
+    const std::string workdir = cache && git_repository_workdir(repo) ? git_repository_workdir(repo) : "";
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    const std::size_t num_deltas = git_diff_num_deltas(diff);
+    for (std::size_t i = 0; i < num_deltas; ++i) {
+        const git_diff_delta* delta = git_diff_get_delta(diff, i);
+        const std::string path = delta->new_file.path;
+
+        CachedFileDiff file_diff;
+        file_diff.old_id = delta->old_file.id;
+        file_diff.status = delta->status;
+        file_diff.mtime = -1;
+        file_diff.size = -1;
+        file_diff.created = now;
+        if (cache) {
+            const QFileInfo info(QString::fromStdString(workdir + path));
+            if (info.exists()) {
+                file_diff.mtime = info.lastModified().toMSecsSinceEpoch();
+                file_diff.size = info.size();
+            }
         }
-        if (it->hunks.size() == 0) continue;
-        out.append(it->file_header, it->file_header_len);
-        for(auto hit = it->hunks.begin(); hit != it->hunks.end(); ++hit) {
-            out.append(hit->hunk_header, hit->hunk_header_len);
-            out += std::move(hit->text);
-        }
-    }
-    if (errors.size() != 0) {
-        return out + "\n Errors: " + errors;
-    }
-    return out;
-}
-
-/*
-std::string gitconfig::getLiveCommitDiff(const char* path) {
-    int exitcode;
-
-    QMutexLocker lock{&mutex};
-    git_libgit2_init();
-    std::unique_ptr<void, void(*)(void*)> raii_libgit2{nullptr, [](void* ptr) {git_libgit2_shutdown();}};
 
-    Git_tree_raii data;
-    populate_tree(data, path, "HEAD");
-    if (data.errorMsg.size() != 0) {
-        return data.errorMsg;
-    }
-    populate_gitdiffconfig(data, path);
-
-    git_diff* diff;
-    exitcode = git_diff_tree_to_workdir(&diff, data.repo, data.tree, &data.diffopt);
-    if (exitcode) {
-        return "error in git_diff_tree_to_workdir" + std::to_string(exitcode);
-    }
-    GIT_RAII(diff, git_diff_free);
-
-    std::string out;
+        bool reuse = false;
+        std::map<std::string, CachedFileDiff>::iterator cached;
+        if (cache && file_diff.mtime != -1) {
+            cached = cache->find(path);
+            reuse = cached != cache->end() && cached->second.status == file_diff.status
+                    && git_oid_equal(&cached->second.old_id, &file_diff.old_id)
+                    && cached->second.mtime == file_diff.mtime && cached->second.size == file_diff.size
+                    && cached->second.created - cached->second.mtime >= RACY_CLEAN_WINDOW_MS;
+        }
 
-    std::vector<FileDiff> otherout;
+        if (reuse) {
+            file_diff = std::move(cached->second);
+        } else {
+            git_patch* patch;
+            int exitcode = git_patch_from_diff(&patch, diff, i);
+            if (exitcode) {
+                errorMsg = create_libgit_error_msg(exitcode, "error in git_patch_from_diff");
+                return out;
+            }
+            // unchanged files do not have a patch
+            if (patch) {
+                GIT_RAII(patch, git_patch_free);
+                exitcode = git_patch_print(patch, print_to_file_diff, &file_diff);
+                if (exitcode) {
+                    errorMsg = create_libgit_error_msg(exitcode, "error in git_patch_print");
+                    return out;
+                }
+            }
+        }
 
-    exitcode = git_diff_print(diff, GIT_DIFF_FORMAT_PATCH, print_to_std_string, &out);
-    if (exitcode) {
-        return "error in git_diff_print" + std::to_string(exitcode);
+        errors += file_diff.errorMsgs;
+        if (file_diff.has_hunks) {
+            out += file_diff.text;
+        }
+        if (cache) {
+            used_diffs.emplace(path, std::move(file_diff));
+        }
     }
-
-    exitcode = git_diff_print(diff, GIT_DIFF_FORMAT_PATCH, print_to_vector_file_diff, &otherout);
-    if (exitcode) {
-        return "error in git_diff_print" + std::to_string(exitcode);
+    if (cache) {
+        // drop files which no longer differ, they would never be reused anyway
+        *cache = std::move(used_diffs);
     }
 
-    std::string newout = convert_file_diffs_to_string(std::move(otherout));
-
-    if (newout != out) {
-        return "error: Linux based difference where we should not expect any";
+    if (errors.size() != 0) {
+        return out + "\n Errors: " + errors;
     }
-
-    return newout;
-
-
-//    return out;
+    return out;
 }
 
-*/
-
 gitconfig::TreeDescriptor gitconfig::getLiveCommit(const char* path) {
     int exitcode;
 
     QMutexLocker lock{&mutex};
-    git_libgit2_init();
-    std::unique_ptr<void, void(*)(void*)> raii_libgit2{nullptr, [](void* ptr) {git_libgit2_shutdown();}};
 
     gitconfig::TreeDescriptor out;
 
+    Repository_handle* handle = open_repository(path, out.error);
+    if (!handle) {
+        return out;
+    }
+
     Git_tree_raii master_data, head_data;
-    populate_oid(master_data, path, "master@{u}");
-    populate_oid(head_data, path, "HEAD");
+    resolve_oid(master_data, handle->repo, "master@{u}");
+    resolve_oid(head_data, handle->repo, "HEAD");
     if (master_data.errorMsg.size() != 0 && head_data.errorMsg.size() != 0) {
         out.error = master_data.errorMsg;
         return out;
@@ -362,14 +393,11 @@ gitconfig::TreeDescriptor gitconfig::getLiveCommit(const char* path) {
     }
     GIT_RAII(diff, git_diff_free);
 
-    std::vector<FileDiff> diffout;
-    exitcode = git_diff_print(diff, GIT_DIFF_FORMAT_PATCH, print_to_vector_file_diff, &diffout);
-    if (exitcode) {
-        out.error = "error in git_diff_print" + std::to_string(exitcode);
+    out.diff = print_diff(diff, handle->repo, &handle->file_diffs, out.error);
+    if (out.error.size() != 0) {
+        out.diff.clear();
         return out;
     }
-
-    out.diff = convert_file_diffs_to_string(std::move(diffout));
     out.hash = getLiveCommitHashFromTree(active_data);
     out.min_hash = getLiveCommitHashFromTree(head_data);
 
@@ -396,12 +424,15 @@ std::string gitconfig::calculateDiff(const char* repository, const char* orig_ha
     int exitcode;
 
     QMutexLocker lock{&mutex};
-    git_libgit2_init();
-    std::unique_ptr<void, void(*)(void*)> raii_libgit2{nullptr, [](void* ptr) {git_libgit2_shutdown();}};
 
+    std::string errorMsg;
+    Repository_handle* handle = open_repository(repository, errorMsg);
+    if (!handle) {
+        return "error in setting up the old hash: " + errorMsg;
+    }
 
     Git_tree_raii data;
-    populate_tree(data, repository, orig_hash);
+    populate_tree(data, handle->repo, orig_hash);
     if (data.errorMsg.size() != 0) {
         return "error in setting up the old hash: " + data.errorMsg;
     }
@@ -424,7 +455,7 @@ std::string gitconfig::calculateDiff(const char* repository, const char* orig_ha
 
 
     Git_tree_raii data_to_diff_to;
-    populate_tree(data_to_diff_to, repository, diff_hash);
+    populate_tree(data_to_diff_to, handle->repo, diff_hash);
     if (data_to_diff_to.errorMsg.size() != 0) {
         return "error in setting up the new hash: " + data.errorMsg;
     }
@@ -438,11 +469,10 @@ std::string gitconfig::calculateDiff(const char* repository, const char* orig_ha
     }
     GIT_RAII(new_diff, git_diff_free);
 
-    std::vector<FileDiff> file_diff;
-    exitcode = git_diff_print(new_diff, GIT_DIFF_FORMAT_PATCH, print_to_vector_file_diff, &file_diff);
-    if (exitcode) {
-        return create_libgit_error_msg(exitcode, "error in git_diff_print");
+    // the new side is an in-memory index, so nothing can be reused between calls
+    std::string result = print_diff(new_diff, data_to_diff_to.repo, nullptr, errorMsg);
+    if (errorMsg.size() != 0) {
+        return errorMsg;
     }
-
-    return convert_file_diffs_to_string(std::move(file_diff));
+    return result;
 }
@@ -69,6 +69,9 @@ namespace gitconfig {
      *
      * This function expected `path` to be absolute and canonical
      * without '.' or '..'. It also expects to be ending in a /.
+     *
+     * The repository stays open between calls and the diff of files
+     * whose mtime and size did not change is reused from the previous call.
      */
     TreeDescriptor getLiveCommit(const char* path);
 
@@ -22,6 +22,7 @@
 #include <QCommandLineParser>
 #include <clocale>
 
+#include "seshat/logfilecatalog.h"
 #include "seshat/logfilereader.h"
 #include "seshat/seqlogfilereader.h"
 
@@ -36,9 +37,29 @@ int main(int argc, char* argv[]) {
     parser.setApplicationDescription("Tool to read the log UIDs from ER-Force log files");
     parser.addHelpOption();
     parser.addVersionOption();
-    parser.addPositionalArgument("logfiles", "Log files to read", "files...");
+    parser.addPositionalArgument("logfiles", "Log files to read, or log directories with --build-catalog", "files...");
+    QCommandLineOption buildCatalogOption({"b", "build-catalog"},
+            "Update the log uid catalog used to find logs, defaults to the log locations configured in ra");
+    parser.addOption(buildCatalogOption);
+    QCommandLineOption catalogFileOption({"c", "catalog"}, "Catalog file", "file", LogFileCatalog::defaultCatalogFile());
+    parser.addOption(catalogFileOption);
     parser.process(app);
 
+    if (parser.isSet(buildCatalogOption)) {
+        QStringList directories = parser.positionalArguments();
+        if (directories.isEmpty()) {
+            directories = LogFileCatalog::configuredDirectories();
+        }
+        LogFileCatalog catalog(parser.value(catalogFileOption));
+        catalog.update(directories);
+        if (!catalog.save()) {
+            std::cerr << "Error writing the catalog " << parser.value(catalogFileOption).toStdString() << std::endl;
+            return 1;
+        }
+        std::cout << "Catalog contains " << catalog.fileCount() << " log files" << std::endl;
+        return 0;
+    }
+
     for (const QString filename : parser.positionalArguments()) {
         SeqLogFileReader logfile;
         if (!logfile.open(filename)){
@@ -29,11 +29,13 @@
 #include "widgets/debuggerconsole.h"
 #include "widgets/refereestatuswidget.h"
 #include "savedirectorydialog.h"
+#include "statusaggregator.h"
 #include "logcutter/logcutter.h"
 #include "logopener.h"
 #include "loglabel.h"
 #include "logfileselectiondialog.h"
 #include "core/configuration.h"
+#include "core/tracing.h"
 #include <QFile>
 #include <QFileDialog>
 #include <QLabel>
@@ -63,6 +65,7 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     qRegisterMetaType<SSL_Referee::Command>("SSL_Referee::Command");
     qRegisterMetaType<SSL_Referee::Stage>("SSL_Referee::Stage");
     qRegisterMetaType<Status>("Status");
+    qRegisterMetaType<QList<Status>>("QList<Status>");
 
     ui->setupUi(this);
 
@@ -200,6 +203,8 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     connect(ui->actionUseLocation, SIGNAL(toggled(bool)), m_logOpener, SLOT(useLogfileLocation(bool)));
     connect(ui->actionChangeLocation, SIGNAL(triggered()), SLOT(showDirectoryDialog()));
     connect(ui->exportVision, &QAction::triggered, this, &MainWindow::exportVisionLog);
+    connect(ui->actionRecordLatencyTrace, &QAction::toggled, this, [](bool enable) { Tracing::setEnabled(enable); });
+    connect(ui->actionExportLatencyTrace, &QAction::triggered, this, &MainWindow::exportLatencyTrace);
     connect(ui->getLogUid, &QAction::triggered, this, &MainWindow::requestLogUid);
     connect(ui->openLogUidString, &QAction::triggered, this, &MainWindow::requestUidInsertWindow);
 
@@ -212,15 +217,20 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     connect(ui->actionTogglePause, SIGNAL(triggered()), ui->logManager, SIGNAL(togglePaused()));
 
     // setup data distribution
+    // widgets which only display the latest state are updated once per display frame
+    m_statusAggregator = new StatusAggregator(this);
+    connect(this, &MainWindow::gotStatus, m_statusAggregator, &StatusAggregator::handleStatus);
+    connect(m_statusAggregator, SIGNAL(gotStatusSnapshot(Status)), ui->visualization, SLOT(handleStatus(Status)));
+    connect(m_statusAggregator, SIGNAL(gotStatusSnapshot(Status)), ui->debugTree, SLOT(handleStatus(Status)));
+    connect(m_statusAggregator, SIGNAL(gotStatusSnapshot(Status)), ui->refereeinfo, SLOT(handleStatus(Status)));
+    connect(m_statusAggregator, SIGNAL(gotStatusSnapshot(Status)), m_refereeStatus, SLOT(handleStatus(Status)));
+    // the plotter needs every status, but gets them in batches
+    connect(m_statusAggregator, &StatusAggregator::gotStatusBatch, m_plotter, &Plotter::handleStatuses);
+
     connect(this, SIGNAL(gotStatus(Status)), ui->field, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), m_plotter, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->visualization, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->debugTree, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotStatus(Status)), m_internalReferee, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotStatus(Status)), ui->referee, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->refereeinfo, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotStatus(Status)), ui->timing, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), m_refereeStatus, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotStatus(Status)), ui->log, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotStatus(Status)), ui->options, SLOT(handleStatus(Status)));
     connect(this, SIGNAL(gotStatus(Status)), ui->blueDebugger, SLOT(handleStatus(Status)));
@@ -896,6 +906,15 @@ void MainWindow::exportVisionLog()
     }
 }
 
+void MainWindow::exportLatencyTrace()
+{
+    QString filename = QFileDialog::getSaveFileName(this, "Save file location", "", "Chrome trace files (*.json)");
+
+    if (!filename.isEmpty() && !Tracing::writeChromeTrace(filename)) {
+        QMessageBox::critical(this, "Latency trace export error", "Could not write " + filename);
+    }
+}
+
 void MainWindow::requestLogUid()
 {
     Command command{new amun::Command};
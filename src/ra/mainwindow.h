@@ -42,6 +42,7 @@ class InternalReferee;
 class LogFileWriter;
 class Plotter;
 class RefereeStatusWidget;
+class StatusAggregator;
 class QActionGroup;
 class QLabel;
 class QModelIndex;
@@ -111,6 +112,7 @@ private slots:
     void udpateSpeedActionsEnabled();
     void useLogfileLocation(bool enable);
     void exportVisionLog();
+    void exportLatencyTrace();
     void requestLogUid();
     void searchUid(QString uid);
     void requestUidInsertWindow();
@@ -130,6 +132,7 @@ private:
     Ui::MainWindow *ui;
     AmunClient m_amun;
     Plotter *m_plotter;
+    StatusAggregator *m_statusAggregator;
     RefereeStatusWidget *m_refereeStatus;
     InputManager *m_inputManager;
     InternalReferee *m_internalReferee;
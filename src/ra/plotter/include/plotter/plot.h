@@ -22,6 +22,7 @@
 #define PLOT_H
 
 #include <QColor>
+#include <QMutex>
 #include <QString>
 #include <QVector>
 #include <QVariant>
@@ -33,6 +34,8 @@ public:
     explicit Plot(const QString &name, QObject *parent = 0);
 
 public:
+    // the data is written by the plot extractor thread and read by the gui thread,
+    // all access to the ringbuffer is guarded by the mutex
     void addPoint(float time, float value);
     void plot(const QColor &color) const;
     void mergeFrom(const Plot *p);
@@ -40,10 +43,14 @@ public:
     static int bufferSize() { return BUFFER_SIZE; }
 
     const QString& name() const { return m_name; }
-    float time() const { return m_time; }
+    float time() const;
 
 private:
-    QString m_name;
+    void addPointLocked(float time, float value);
+
+private:
+    const QString m_name;
+    mutable QMutex m_mutex;
     // used as ringbuffer
     QVector<float> m_data;
     int m_pos;
@@ -28,8 +28,11 @@
 #include <QList>
 #include <QStandardItemModel>
 
+class QThread;
+
 class LeafFilterProxyModel;
 class Plot;
+class PlotExtractor;
 class GuiTimer;
 class QMenu;
 namespace Ui {
@@ -52,12 +55,17 @@ public slots:
     void handleUiResponse(const amun::UiResponse& response, qint64 time);
     void setScaling(float min, float max, float timespan);
     void handleStatus(const Status &status, bool backlogStatus = false);
+    void handleStatuses(const QList<Status> &statuses);
     void clearData();
 
 signals:
     void addPlot(const Plot *plot);
     void removePlot(const Plot *plot);
     void spacePressed();
+    // forwarded to the plot extractor thread
+    void extractStatuses(const QList<Status> &statuses);
+    void extractorFreezeChanged(bool freeze);
+    void extractorDataCleared();
 
 protected:
     void closeEvent(QCloseEvent *event) override;
@@ -70,6 +78,8 @@ private slots:
     void clearSelection();
     void itemChanged(QStandardItem *item);
     void invalidatePlots();
+    void plotCreated(Plot *plot);
+    void statusHandled(float time);
 
 private:
     bool eventFilter(QObject *obj, QEvent *event) override;
@@ -78,9 +88,6 @@ private:
     void loadSelection();
     QStandardItem* getItem(const QString &name);
     void addRootItem(const QString &name, const QString &displayName);
-    void parseMessage(const google::protobuf::Message &message, const QString &parent, float time);
-    void addPoint(const std::string &name, const QString &parent, float time, float value, QVector<QStandardItem *> &childLookup, int descriptorIndex);
-    void tryAddLength(const std::string &name, const QString &parent, float time, float value1, float value2, QVector<QStandardItem *> &childLookup, int descriptorIndex);
 
 private:
     enum ItemRole {
@@ -88,15 +95,15 @@ private:
     };
 
     Ui::Plotter *ui;
-    qint64 m_startTime;
-    qint64 m_time;
+    QThread *m_extractorThread;
+    PlotExtractor *m_extractor;
+    float m_time;
     double m_timeLimit;
     bool m_freeze;
     GuiTimer *m_guiTimer;
     QHash<QString, QStandardItem*> m_items;
-    QHash<QString, QVector<QStandardItem *>> m_itemLookup;
-    QHash<QStandardItem*, Plot*> m_plots;
-    QHash<QStandardItem*, Plot*> m_frozenPlots;
+    // the plots are owned and filled by the plot extractor
+    QHash<QStandardItem*, const Plot*> m_plots;
     QSet<QString> m_selection;
     QStandardItemModel m_model;
     LeafFilterProxyModel *m_proxy;
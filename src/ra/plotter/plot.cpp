@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "plot.h"
+#include <QMutexLocker>
 #include <QOpenGLWidget>
 #include <limits>
 
@@ -35,6 +36,18 @@ Plot::Plot(const QString &name, QObject *parent) :
 }
 
 void Plot::addPoint(float time, float value)
+{
+    QMutexLocker locker(&m_mutex);
+    addPointLocked(time, value);
+}
+
+float Plot::time() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_time;
+}
+
+void Plot::addPointLocked(float time, float value)
 {
     if (m_pos == m_data.size()) { // wrap around
         m_pos = 0;
@@ -76,6 +89,8 @@ void Plot::addPoint(float time, float value)
 
 void Plot::plot(const QColor &color) const
 {
+    // the vertex array is read directly from the ringbuffer
+    QMutexLocker locker(&m_mutex);
     glLineWidth(3.0f);
     glColor3f(color.redF(), color.greenF(), color.blueF());
     glVertexPointer(2, GL_FLOAT, 0, m_data.data());
@@ -89,18 +104,21 @@ void Plot::plot(const QColor &color) const
 
 void Plot::mergeFrom(const Plot *p)
 {
+    QMutexLocker locker(&m_mutex);
+    QMutexLocker otherLocker(&p->m_mutex);
     // start after the latest value, until the last value
     for (int i = p->m_pos; i < p->m_count; i += 2) {
-        addPoint(p->m_data[i], p->m_data[i+1]);
+        addPointLocked(p->m_data[i], p->m_data[i+1]);
     }
     // remaining value until the latest value
     for (int i = 0; i < p->m_pos; i += 2) {
-        addPoint(p->m_data[i], p->m_data[i+1]);
+        addPointLocked(p->m_data[i], p->m_data[i+1]);
     }
 }
 
 void Plot::clearData()
 {
+    QMutexLocker locker(&m_mutex);
     m_pos = 0;
     m_count = 0;
 }
@@ -0,0 +1,408 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "plotextractor.h"
+#include "plot.h"
+#include "google/protobuf/descriptor.h"
+#include "protobuf/status.pb.h"
+#include <cmath>
+#include <QStringBuilder>
+
+enum class SpecialFieldNames: int {
+    none = 0,
+    v_f = 1,
+    v_s = 2,
+    v_x = 3,
+    v_y = 4,
+    v_d_x = 5,
+    v_d_y = 6,
+    v_ctrl_out_f = 7,
+    v_ctrl_out_s = 8,
+    area = 9,
+    max = 10
+};
+
+static const std::unordered_map<std::string, SpecialFieldNames> fieldNameMap = {
+    std::make_pair("v_f", SpecialFieldNames::v_f),
+    std::make_pair("v_s", SpecialFieldNames::v_s),
+    std::make_pair("v_x", SpecialFieldNames::v_x),
+    std::make_pair("v_y", SpecialFieldNames::v_y),
+    std::make_pair("v_desired_x", SpecialFieldNames::v_d_x),
+    std::make_pair("v_desired_y", SpecialFieldNames::v_d_y),
+    std::make_pair("v_ctrl_out_f", SpecialFieldNames::v_ctrl_out_f),
+    std::make_pair("v_ctrl_out_s", SpecialFieldNames::v_ctrl_out_s),
+    std::make_pair("area", SpecialFieldNames::area),
+};
+
+// the lengths of the speed vectors are stored after the message fields
+static const int EXTRA_FIELDS = 4;
+
+// kinds of parents that are created for every robot
+enum class ParentKind: quint64 {
+    Robot = 1,
+    RobotRaw = 2,
+    RobotWithoutRadio = 3,
+    RobotTruth = 4,
+    RadioResponse = 5,
+    RadioResponseSpeed = 6,
+    RadioCommand = 7,
+    RadioCommandOutput0 = 8,
+    RadioCommandOutput1 = 9,
+    RadioCommandOutput2 = 10
+};
+
+static quint64 parentKey(ParentKind kind, bool isBlue, quint32 id, quint32 generation = 0)
+{
+    return (static_cast<quint64>(kind) << 56) | (static_cast<quint64>(generation & 0xFFFFFF) << 32)
+            | (static_cast<quint64>(isBlue) << 31) | (id & 0x7FFFFFFF);
+}
+
+static QString radioName(quint32 generation, bool isBlue, quint32 id)
+{
+    return QString(QStringLiteral("%1-%2-%3")).arg(generation).arg(isBlue ? "blue" : "yellow").arg(id);
+}
+
+PlotExtractor::PlotExtractor() :
+    m_startTime(0),
+    m_freeze(false)
+{ }
+
+PlotExtractor::~PlotExtractor() = default;
+
+const PlotExtractor::FieldPlan &PlotExtractor::fieldPlan(const google::protobuf::Descriptor *descriptor)
+{
+    auto it = m_fieldPlans.find(descriptor);
+    if (it != m_fieldPlans.end()) {
+        return it->second;
+    }
+
+    // only non repeated float and bool fields can be plotted
+    FieldPlan plan;
+    for (int i = 0; i < descriptor->field_count(); i++) {
+        const google::protobuf::FieldDescriptor *field = descriptor->field(i);
+        if (field->is_repeated()) {
+            continue;
+        }
+        if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_FLOAT) {
+            auto special = fieldNameMap.find(field->name());
+            const SpecialFieldNames fn = (special != fieldNameMap.end()) ? special->second : SpecialFieldNames::none;
+            plan.push_back({field, false, static_cast<int>(fn)});
+        } else if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_BOOL) {
+            plan.push_back({field, true, static_cast<int>(SpecialFieldNames::none)});
+        }
+    }
+    return m_fieldPlans.emplace(descriptor, std::move(plan)).first->second;
+}
+
+PlotExtractor::Parent *PlotExtractor::parent(const QString &name)
+{
+    Parent *&p = m_namedParents[name];
+    if (p == nullptr) {
+        m_parents.emplace_back(new Parent{name, nullptr, {}});
+        p = m_parents.back().get();
+    }
+    return p;
+}
+
+template<typename NameFunction>
+PlotExtractor::Parent *PlotExtractor::parent(quint64 key, NameFunction name)
+{
+    // the name is only built once for every robot
+    Parent *&p = m_keyedParents[key];
+    if (p == nullptr) {
+        p = parent(name());
+    }
+    return p;
+}
+
+PlotExtractor::Series *PlotExtractor::series(const QString &fullName)
+{
+    Series *&s = m_namedSeries[fullName];
+    if (s == nullptr) {
+        m_series.emplace_back(new Series{std::unique_ptr<Plot>(new Plot(fullName)), nullptr});
+        s = m_series.back().get();
+        emit plotCreated(s->plot.get());
+    }
+    return s;
+}
+
+void PlotExtractor::handleStatuses(const QList<Status> &statuses)
+{
+    if (statuses.isEmpty()) {
+        return;
+    }
+    float time = 0;
+    for (const Status &status : statuses) {
+        time = extractStatus(status);
+    }
+    emit statusHandled(time);
+}
+
+float PlotExtractor::extractStatus(const Status &status)
+{
+    // normalize time to be able to store it in floats
+    if (m_startTime == 0) {
+        m_startTime = status->time();
+    }
+
+    const float time = normalizeTime(status->time());
+
+    // handle each message
+    if (status->has_world_state()) {
+        const world::State &worldState = status->world_state();
+        float time = normalizeTime(worldState.time());
+
+        if (worldState.reality_size() > 0) {
+            const auto &reality = worldState.reality(worldState.reality_size()-1);
+            float realityTime = reality.has_time() ? normalizeTime(reality.time()) : time;
+            if (reality.has_ball()) {
+                parseMessage(reality.ball(), parent(QStringLiteral("Ball.truth")), realityTime);
+            }
+            for (const auto &robot : reality.yellow_robots()) {
+                Parent *p = parent(parentKey(ParentKind::RobotTruth, false, robot.id()), [&robot] {
+                    return QString(QStringLiteral("Yellow.%1.truth")).arg(robot.id());
+                });
+                parseMessage(robot, p, realityTime);
+            }
+            for (const auto &robot : reality.blue_robots()) {
+                Parent *p = parent(parentKey(ParentKind::RobotTruth, true, robot.id()), [&robot] {
+                    return QString(QStringLiteral("Blue.%1.truth")).arg(robot.id());
+                });
+                parseMessage(robot, p, realityTime);
+            }
+        }
+
+        if (worldState.has_ball()) {
+            parseMessage(worldState.ball(), parent(QStringLiteral("Ball")), time);
+
+            Parent *rawParent = parent(QStringLiteral("Ball.raw"));
+            for (const world::BallPosition &p : worldState.ball().raw()) {
+                parseMessage(p, rawParent, normalizeTime(p.time()));
+            }
+        }
+
+        for (int team = 0; team < 2; team++) {
+            const bool isBlue = (team == 1);
+            const QString teamName = isBlue ? QStringLiteral("Blue") : QStringLiteral("Yellow");
+            const auto &robots = isBlue ? worldState.blue() : worldState.yellow();
+            for (const world::Robot &robot : robots) {
+                Parent *p = parent(parentKey(ParentKind::Robot, isBlue, robot.id()), [&] {
+                    return QString(QStringLiteral("%1.%2")).arg(teamName).arg(robot.id());
+                });
+                parseMessage(robot, p, time);
+
+                Parent *rawParent = parent(parentKey(ParentKind::RobotRaw, isBlue, robot.id()), [&] {
+                    return QString(QStringLiteral("%1.%2.raw")).arg(teamName).arg(robot.id());
+                });
+                for (const world::RobotPosition &raw : robot.raw()) {
+                    parseMessage(raw, rawParent, normalizeTime(raw.time()));
+                }
+            }
+
+            const auto &simpleRobots = isBlue ? worldState.simple_tracking_blue() : worldState.simple_tracking_yellow();
+            for (const world::Robot &robot : simpleRobots) {
+                Parent *p = parent(parentKey(ParentKind::RobotWithoutRadio, isBlue, robot.id()), [&] {
+                    return QString(QStringLiteral("%1.%2.without radio commands")).arg(teamName).arg(robot.id());
+                });
+                parseMessage(robot, p, time);
+            }
+        }
+
+        for (const robot::RadioResponse &response : worldState.radio_response()) {
+            const float responseTime = normalizeTime(response.time());
+            const bool isBlue = response.is_blue();
+            Parent *p = parent(parentKey(ParentKind::RadioResponse, isBlue, response.id(), response.generation()), [&]() -> QString {
+                return QStringLiteral("RadioResponse.") % radioName(response.generation(), isBlue, response.id());
+            });
+            parseMessage(response, p, responseTime);
+            Parent *speedParent = parent(parentKey(ParentKind::RadioResponseSpeed, isBlue, response.id(), response.generation()), [&]() -> QString {
+                return QStringLiteral("RadioResponse.") % radioName(response.generation(), isBlue, response.id())
+                        % QStringLiteral(".estimatedSpeed");
+            });
+            parseMessage(response.estimated_speed(), speedParent, responseTime);
+        }
+    }
+
+    for (const robot::RadioCommand &command : status->radio_command()) {
+        const robot::Command &cmd = command.command();
+        const bool isBlue = command.is_blue();
+        auto commandParent = [&](ParentKind kind, const QString &suffix) {
+            return parent(parentKey(kind, isBlue, command.id(), command.generation()), [&]() -> QString {
+                return QStringLiteral("RadioCommand.") % radioName(command.generation(), isBlue, command.id()) % suffix;
+            });
+        };
+        parseMessage(cmd, commandParent(ParentKind::RadioCommand, QString()), time);
+        parseMessage(cmd.output0(), commandParent(ParentKind::RadioCommandOutput0, QStringLiteral(".output0")), time);
+        parseMessage(cmd.output1(), commandParent(ParentKind::RadioCommandOutput1, QStringLiteral(".output1")), time);
+        parseMessage(cmd.output2(), commandParent(ParentKind::RadioCommandOutput2, QStringLiteral(".output2")), time);
+    }
+
+    if (status->has_timing()) {
+        parseMessage(status->timing(), parent(QStringLiteral("Timing")), time);
+    }
+
+    for (const amun::DebugValues &debug : status->debug()) {
+        // ignore controller as it can create plots via RadioCommand.%1.debug
+        if (debug.source() == amun::Controller) {
+            continue;
+        }
+        float debugTime = (debug.has_time()) ? normalizeTime(debug.time()) : time;
+        QString parentName;
+        switch (debug.source()) {
+        case amun::StrategyBlue:
+            parentName = QStringLiteral("BlueStrategy");
+            break;
+        case amun::StrategyYellow:
+            parentName = QStringLiteral("YellowStrategy");
+            break;
+        case amun::ReplayBlue:
+            parentName = QStringLiteral("BlueReplay");
+            break;
+        case amun::ReplayYellow:
+            parentName = QStringLiteral("YellowReplay");
+            break;
+        case amun::Autoref:
+            parentName = QStringLiteral("Autoref");
+            break;
+        case amun::Tracking:
+            parentName = QStringLiteral("Tracking");
+            break;
+        default:
+            parentName = QStringLiteral("Unknown");
+        }
+        // strategies can add plots with arbitrary names
+        for (const amun::PlotValue &value : debug.plot()) {
+            const QString fullName = parentName % QStringLiteral(".") % QString::fromStdString(value.name());
+            addPoint(series(fullName), debugTime, value.value());
+        }
+    }
+
+    return time;
+}
+
+void PlotExtractor::parseMessage(const google::protobuf::Message &message, Parent *parent, float time)
+{
+    const google::protobuf::Descriptor *desc = message.GetDescriptor();
+    const google::protobuf::Reflection *refl = message.GetReflection();
+    const FieldPlan &plan = fieldPlan(desc);
+
+    if (parent->descriptor != desc) {
+        // the series are still found by name, thus the lookup can just be rebuilt
+        parent->descriptor = desc;
+        parent->series = QVector<Series*>(static_cast<int>(plan.size()) + EXTRA_FIELDS, nullptr);
+    }
+
+    float specialFields[static_cast<int>(SpecialFieldNames::max)];
+    for (int i = 0; i < static_cast<int>(SpecialFieldNames::max); ++i) {
+        specialFields[i] = NAN;
+    }
+
+    for (std::size_t i = 0; i < plan.size(); i++) {
+        const PlannedField &planned = plan[i];
+        if (!refl->HasField(message, planned.field)) {
+            continue;
+        }
+        float value;
+        if (planned.isBool) {
+            value = refl->GetBool(message, planned.field) ? 1 : 0;
+        } else {
+            value = refl->GetFloat(message, planned.field);
+            specialFields[planned.special] = value;
+        }
+        addPoint(parent, static_cast<int>(i), planned.field->name(), time, value);
+    }
+
+    // precompute strings
+    static const std::string staticVLocal("v_local");
+    static const std::string staticVDesired("v_desired");
+    static const std::string staticVCtrlOut("v_ctrl_out");
+    static const std::string staticVGlobal("v_global");
+
+    struct Length {
+        const std::string &name;
+        SpecialFieldNames first;
+        SpecialFieldNames second;
+    };
+    const Length lengths[EXTRA_FIELDS] = {
+        {staticVLocal, SpecialFieldNames::v_f, SpecialFieldNames::v_s},
+        {staticVDesired, SpecialFieldNames::v_d_x, SpecialFieldNames::v_d_y},
+        {staticVCtrlOut, SpecialFieldNames::v_ctrl_out_f, SpecialFieldNames::v_ctrl_out_f},
+        {staticVGlobal, SpecialFieldNames::v_x, SpecialFieldNames::v_y}
+    };
+
+    // add length of speed vectors if both values are set
+    for (int k = 0; k < EXTRA_FIELDS; k++) {
+        const float value1 = specialFields[static_cast<int>(lengths[k].first)];
+        const float value2 = specialFields[static_cast<int>(lengths[k].second)];
+        if (!std::isnan(value1) && !std::isnan(value2)) {
+            const float value = std::sqrt(value1 * value1 + value2 * value2);
+            addPoint(parent, static_cast<int>(plan.size()) + k, lengths[k].name, time, value);
+        }
+    }
+}
+
+void PlotExtractor::addPoint(Parent *parent, int index, const std::string &name, float time, float value)
+{
+    Series *&s = parent->series[index];
+    if (s == nullptr) {
+        // full name for series retrieval
+        s = series(parent->name % QStringLiteral(".") % QString::fromStdString(name));
+    }
+    addPoint(s, time, value);
+}
+
+void PlotExtractor::addPoint(Series *series, float time, float value)
+{
+    if (!m_freeze) {
+        series->plot->addPoint(time, value);
+        return;
+    }
+    // save data into a hidden plot while freezed
+    if (!series->frozen) {
+        series->frozen.reset(new Plot(series->plot->name()));
+    }
+    series->frozen->addPoint(time, value);
+}
+
+void PlotExtractor::setFreeze(bool freeze)
+{
+    if (!freeze && m_freeze) {
+        // merge plots on unfreezing
+        for (const auto &s : m_series) {
+            if (s->frozen) {
+                s->plot->mergeFrom(s->frozen.get());
+                s->frozen.reset();
+            }
+        }
+    }
+    m_freeze = freeze;
+}
+
+void PlotExtractor::clearData()
+{
+    // fix loss of precision when loading multiple log files without restarting the plotter
+    m_startTime = 0;
+    // delete everything, the plots themselves are still referenced by the gui
+    for (const auto &s : m_series) {
+        s->frozen.reset();
+        s->plot->clearData();
+    }
+    // force unfreeze as no more data is available
+    m_freeze = false;
+}
@@ -0,0 +1,111 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef PLOTEXTRACTOR_H
+#define PLOTEXTRACTOR_H
+
+#include "protobuf/status.h"
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+    namespace protobuf {
+        class Descriptor;
+        class FieldDescriptor;
+        class Message;
+    }
+}
+
+class Plot;
+
+// Extracts the plotted values from the status messages, runs on a separate thread.
+// The plots are owned by the extractor and are filled in place, the gui draws them directly.
+class PlotExtractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    PlotExtractor();
+    ~PlotExtractor() override;
+    PlotExtractor(const PlotExtractor&) = delete;
+    PlotExtractor& operator=(const PlotExtractor&) = delete;
+
+signals:
+    void plotCreated(Plot *plot);
+    // time of the last handled status relative to the first one
+    void statusHandled(float time);
+
+public slots:
+    void handleStatuses(const QList<Status> &statuses);
+    void setFreeze(bool freeze);
+    void clearData();
+
+private:
+    struct Series {
+        std::unique_ptr<Plot> plot;
+        // receives the data while the plotter is frozen
+        std::unique_ptr<Plot> frozen;
+    };
+
+    struct Parent {
+        QString name;
+        const google::protobuf::Descriptor *descriptor;
+        // indexed like the fields of the field plan, followed by the vector lengths
+        QVector<Series*> series;
+    };
+
+    struct PlannedField {
+        const google::protobuf::FieldDescriptor *field;
+        bool isBool;
+        int special;
+    };
+    // precompiled list of the plottable fields of a message type
+    typedef std::vector<PlannedField> FieldPlan;
+
+    float extractStatus(const Status &status);
+    const FieldPlan &fieldPlan(const google::protobuf::Descriptor *descriptor);
+    Parent *parent(const QString &name);
+    template<typename NameFunction>
+    Parent *parent(quint64 key, NameFunction name);
+    Series *series(const QString &fullName);
+    void parseMessage(const google::protobuf::Message &message, Parent *parent, float time);
+    void addPoint(Parent *parent, int index, const std::string &name, float time, float value);
+    void addPoint(Series *series, float time, float value);
+    float normalizeTime(qint64 time) const { return (time - m_startTime) * 1E-9f; }
+
+private:
+    qint64 m_startTime;
+    bool m_freeze;
+    std::unordered_map<const google::protobuf::Descriptor*, FieldPlan> m_fieldPlans;
+    std::vector<std::unique_ptr<Parent>> m_parents;
+    QHash<QString, Parent*> m_namedParents;
+    // avoids building the parent names for every robot in every status
+    QHash<quint64, Parent*> m_keyedParents;
+    std::vector<std::unique_ptr<Series>> m_series;
+    QHash<QString, Series*> m_namedSeries;
+};
+
+#endif // PLOTEXTRACTOR_H
@@ -21,22 +21,21 @@
 #include "leaffilterproxymodel.h"
 #include "plotter.h"
 #include "plot.h"
+#include "plotextractor.h"
 #include "guihelper/guitimer.h"
 #include "ui_plotter.h"
-#include "google/protobuf/descriptor.h"
-#include "protobuf/status.pb.h"
-#include <cmath>
 #include <QComboBox>
 #include <QMenu>
 #include <QSettings>
-#include <QStringBuilder>
-#include <unordered_map>
+#include <QThread>
 #include <QCloseEvent>
 
 Plotter::Plotter() :
     QWidget(nullptr, Qt::Window),
     ui(new Ui::Plotter),
-    m_startTime(0),
+    m_extractorThread(new QThread(this)),
+    m_extractor(new PlotExtractor),
+    m_time(0),
     m_freeze(false),
     m_playingBacklog(false)
 {
@@ -108,13 +107,25 @@ Plotter::Plotter() :
     connect(m_guiTimer, &GuiTimer::timeout, this, &Plotter::invalidatePlots);
 
     loadSelection();
+
+    // parse the status messages in the background, the gui only creates the items
+    m_extractor->moveToThread(m_extractorThread);
+    m_extractorThread->setObjectName("Plotter Extractor Thread");
+    connect(this, &Plotter::extractStatuses, m_extractor, &PlotExtractor::handleStatuses);
+    connect(this, &Plotter::extractorFreezeChanged, m_extractor, &PlotExtractor::setFreeze);
+    connect(this, &Plotter::extractorDataCleared, m_extractor, &PlotExtractor::clearData);
+    connect(m_extractor, &PlotExtractor::plotCreated, this, &Plotter::plotCreated);
+    connect(m_extractor, &PlotExtractor::statusHandled, this, &Plotter::statusHandled);
+    m_extractorThread->start();
 }
 
 Plotter::~Plotter()
 {
+    m_extractorThread->quit();
+    m_extractorThread->wait();
+    // the plot widget references the plots of the extractor
     delete ui;
-    qDeleteAll(m_plots);
-    qDeleteAll(m_frozenPlots);
+    delete m_extractor;
 }
 
 void Plotter::closeEvent(QCloseEvent *event)
@@ -221,24 +232,9 @@ bool Plotter::eventFilter(QObject *obj, QEvent *event)
 
 void Plotter::setFreeze(bool freeze)
 {
-    if (!freeze && m_freeze) {
-        // merge plots on unfreezing
-        foreach (QStandardItem *item, m_items) {
-            Plot *freezePlot = m_frozenPlots.value(item, nullptr);
-            if (freezePlot == nullptr) {
-                continue;
-            }
-            // remove freeze plot entry
-            m_frozenPlots.remove(item);
-
-            Plot *plot = m_plots.value(item, nullptr);
-            if (plot != nullptr) { // merge freeze plot if there's already a plot
-                plot->mergeFrom(freezePlot);
-                delete freezePlot;
-            } else { // otherwise reuse it as plot
-                m_plots[item] = freezePlot;
-            }
-        }
+    if (freeze != m_freeze) {
+        // the extractor merges the plots on unfreezing
+        emit extractorFreezeChanged(freeze);
     }
     m_freeze = freeze;
     ui->btnFreeze->setChecked(freeze); // update button
@@ -251,11 +247,9 @@ void Plotter::handleUiResponse(const amun::UiResponse& response, qint64 time)
         Status s = Status::createArena();
         s->CopyFrom(st);
         handleStatus(s, true);
-        QCoreApplication::processEvents();
     }
     for (int i = 0;i<m_backlog.size();i++) {
         handleStatus(m_backlog[i], true);
-        QCoreApplication::processEvents();
     }
     m_backlog.clear();
     m_playingBacklog = false;
@@ -286,135 +280,38 @@ void Plotter::handleStatus(const Status &status, bool backlogStatus)
         return;
     }
 
-    m_guiTimer->requestTriggering();
+    emit extractStatuses({status});
+}
 
-    m_time = status->time();
-    // normalize time to be able to store it in floats
-    if (m_startTime == 0) {
-        m_startTime = status->time();
+void Plotter::handleStatuses(const QList<Status> &statuses)
+{
+    // don't consume cpu while closed
+    if (!isVisible()) {
+        return;
     }
 
-    const float time = (status->time() - m_startTime) * 1E-9f;
-
-    // handle each message
-    if (status->has_world_state()) {
-        const world::State &worldState = status->world_state();
-        float time = (worldState.time() - m_startTime) * 1E-9f;
-
-        if (worldState.reality_size() > 0) {
-            auto reality = worldState.reality(worldState.reality_size()-1);
-            float realityTime = reality.has_time() ? (reality.time() - m_startTime) * 1E-9f : time;
-            if (reality.has_ball()) {
-                parseMessage(reality.ball(), QStringLiteral("Ball.truth"), realityTime);
-            }
-            for (const auto &robot : reality.yellow_robots()) {
-                parseMessage(robot, QString(QStringLiteral("Yellow.%1.truth")).arg(robot.id()), realityTime);
+    // hand the status over as a whole, unless they need special handling
+    QList<Status> extract;
+    for (const Status &status : statuses) {
+        if (status->has_pure_ui_response() || m_playingBacklog) {
+            if (!extract.isEmpty()) {
+                emit extractStatuses(extract);
+                extract.clear();
             }
-            for (const auto &robot : reality.blue_robots()) {
-                parseMessage(robot, QString(QStringLiteral("Blue.%1.truth")).arg(robot.id()), realityTime);
-            }
-        }
-
-        if (worldState.has_ball()) {
-            parseMessage(worldState.ball(), QStringLiteral("Ball"), time);
-
-            for (int i = 0; i < worldState.ball().raw_size(); i++) {
-                const world::BallPosition &p = worldState.ball().raw(i);
-                parseMessage(p, QStringLiteral("Ball.raw"), (p.time() - m_startTime) * 1E-9f);
-            }
-        }
-
-        for (int i = 0; i < worldState.yellow_size(); i++) {
-            const world::Robot &robot = worldState.yellow(i);
-            parseMessage(robot, QString(QStringLiteral("Yellow.%1")).arg(robot.id()), time);
-
-            const QString rawParent = QString(QStringLiteral("Yellow.%1.raw")).arg(robot.id());
-            for (int i = 0; i < robot.raw_size(); i++) {
-                const world::RobotPosition &p = robot.raw(i);
-                parseMessage(p, rawParent, (p.time() - m_startTime) * 1E-9f);
-            }
-        }
-        for (int i = 0; i < worldState.simple_tracking_yellow_size(); i++) {
-            const world::Robot &robot = worldState.simple_tracking_yellow(i);
-            parseMessage(robot, QString(QStringLiteral("Yellow.%1.without radio commands")).arg(robot.id()), time);
-        }
-
-        for (int i = 0; i < worldState.blue_size(); i++) {
-            const world::Robot &robot = worldState.blue(i);
-            parseMessage(robot, QString(QStringLiteral("Blue.%1")).arg(robot.id()), time);
-
-            const QString rawParent = QString(QStringLiteral("Blue.%1.raw")).arg(robot.id());
-            for (int i = 0; i < robot.raw_size(); i++) {
-                const world::RobotPosition &p = robot.raw(i);
-                parseMessage(p, rawParent, (p.time() - m_startTime) * 1E-9f);
-            }
-        }
-        for (int i = 0; i < worldState.simple_tracking_blue_size(); i++) {
-            const world::Robot &robot = worldState.simple_tracking_blue(i);
-            parseMessage(robot, QString(QStringLiteral("Blue.%1.without radio commands")).arg(robot.id()), time);
-        }
-
-        for (int i = 0; i < worldState.radio_response_size(); i++) {
-            const robot::RadioResponse &response = worldState.radio_response(i);
-            const QString name = QString(QStringLiteral("%1-%2-%3")).arg(response.generation()).arg(response.is_blue() ? "blue" : "yellow").arg(response.id());
-            const float responseTime = (response.time() - m_startTime) * 1E-9f;
-            parseMessage(response, QString(QStringLiteral("RadioResponse.%1")).arg(name), responseTime);
-            parseMessage(response.estimated_speed(), QString(QStringLiteral("RadioResponse.%1.estimatedSpeed")).arg(name), responseTime);
+            handleStatus(status);
+        } else {
+            extract.append(status);
         }
     }
-
-    for (int i = 0; i < status->radio_command_size(); i++) {
-        const robot::RadioCommand &command = status->radio_command(i);
-        const QString name = QString(QStringLiteral("%1-%2-%3")).arg(command.generation()).arg(command.is_blue() ? "blue" : "yellow").arg(command.id());
-
-        const robot::Command &cmd = command.command();
-        parseMessage(cmd, QString(QStringLiteral("RadioCommand.%1")).arg(name), time);
-        parseMessage(cmd.output0(), QString(QStringLiteral("RadioCommand.%1.output0")).arg(name), time);
-        parseMessage(cmd.output1(), QString(QStringLiteral("RadioCommand.%1.output1")).arg(name), time);
-        parseMessage(cmd.output2(), QString(QStringLiteral("RadioCommand.%1.output2")).arg(name), time);
-    }
-
-    if (status->has_timing()) {
-        const amun::Timing &timing = status->timing();
-        parseMessage(timing, QStringLiteral("Timing"), time);
+    if (!extract.isEmpty()) {
+        emit extractStatuses(extract);
     }
+}
 
-    for (int j=0; j < status->debug_size(); ++j) {
-        const amun::DebugValues &debug = status->debug(j);
-        // ignore controller as it can create plots via RadioCommand.%1.debug
-        if (debug.source() != amun::Controller) {
-            float debugTime = (debug.has_time()) ? (debug.time() - m_startTime) * 1E-9f : time;
-            QVector<QStandardItem *> emptyLookup;
-            QString parent;
-            switch (debug.source()) {
-            case amun::StrategyBlue:
-                parent = "BlueStrategy";
-                break;
-            case amun::StrategyYellow:
-                parent = "YellowStrategy";
-                break;
-            case amun::ReplayBlue:
-                parent = "BlueReplay";
-                break;
-            case amun::ReplayYellow:
-                parent = "YellowReplay";
-                break;
-            case amun::Autoref:
-                parent = "Autoref";
-                break;
-            case amun::Tracking:
-                parent = "Tracking";
-                break;
-            default:
-                parent = "Unknown";
-            }
-            // strategies can add plots with arbitrary names
-            for (int i = 0; i < debug.plot_size(); ++i) {
-                const amun::PlotValue &value = debug.plot(i);
-                addPoint(value.name(), parent, debugTime, value.value(), emptyLookup, 0);
-            }
-        }
-    }
+void Plotter::statusHandled(float time)
+{
+    m_time = time;
+    m_guiTimer->requestTriggering();
 
     // don't move plots during freeze
     if (!m_freeze) {
@@ -451,189 +348,57 @@ void Plotter::invalidatePlots()
     if (!isVisible()) { // values aren't update while hidden
         return;
     }
+    // the plots don't receive data while frozen
+    if (m_freeze) {
+        return;
+    }
 
-    const float time = (m_time - m_startTime) * 1E-9f;
-
-    foreach (QStandardItem *item, m_items) {
-        // check the role that is currently updated
-        QHash<QStandardItem*, Plot*> &plots = (m_freeze) ? m_frozenPlots : m_plots;
-        Plot *plot = plots.value(item, nullptr);
-        if (plot == nullptr) {
-            continue;
-        }
-        if (plot->time() + 5 < time) {
+    for (auto it = m_plots.constBegin(); it != m_plots.constEnd(); ++it) {
+        QStandardItem *item = it.key();
+        if (it.value()->time() + 5 < m_time) {
             // mark old plots
             item->setForeground(Qt::gray);
+        } else if (item->data(Qt::ForegroundRole).isValid()) {
+            // only clear foreground if it's set, causes a serious performance regression
+            // if it's always done
+            item->setData(QVariant(), Qt::ForegroundRole); // clear foreground color
         }
     }
 }
 
-enum class SpecialFieldNames: int {
-    none = 0,
-    v_f = 1,
-    v_s = 2,
-    v_x = 3,
-    v_y = 4,
-    v_d_x = 5,
-    v_d_y = 6,
-    v_ctrl_out_f = 7,
-    v_ctrl_out_s = 8,
-    area = 9,
-    max = 10
-};
-
-static const std::unordered_map<std::string, SpecialFieldNames> fieldNameMap = {
-    std::make_pair("v_f", SpecialFieldNames::v_f),
-    std::make_pair("v_s", SpecialFieldNames::v_s),
-    std::make_pair("v_x", SpecialFieldNames::v_x),
-    std::make_pair("v_y", SpecialFieldNames::v_y),
-    std::make_pair("v_desired_x", SpecialFieldNames::v_d_x),
-    std::make_pair("v_desired_y", SpecialFieldNames::v_d_y),
-    std::make_pair("v_ctrl_out_f", SpecialFieldNames::v_ctrl_out_f),
-    std::make_pair("v_ctrl_out_s", SpecialFieldNames::v_ctrl_out_s),
-    std::make_pair("area", SpecialFieldNames::area),
-};
-
-void Plotter::parseMessage(const google::protobuf::Message &message, const QString &parent, float time)
-{
-    const google::protobuf::Descriptor *desc = message.GetDescriptor();
-    const google::protobuf::Reflection *refl = message.GetReflection();
-
-    float specialFields[static_cast<int>(SpecialFieldNames::max)];
-    for (int i = 0; i < static_cast<int>(SpecialFieldNames::max); ++i) {
-        specialFields[i] = NAN;
-    }
-
-    const int extraFields = 4;
-    if (!m_itemLookup.contains(parent)) {
-        m_itemLookup[parent] = QVector<QStandardItem *>(desc->field_count() + extraFields, nullptr);
-    }
-    // just a performance optimization
-    QVector<QStandardItem *> &childLookup = m_itemLookup[parent];
-
-    for (int i = 0; i < desc->field_count(); i++) {
-        const google::protobuf::FieldDescriptor *field = desc->field(i);
-
-        // check type and that the field exists
-        if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_FLOAT
-                && refl->HasField(message, field)) {
-            const std::string &name = field->name();
-            const float value = refl->GetFloat(message, field);
-            if (fieldNameMap.count(name) > 0) {
-                SpecialFieldNames fn = fieldNameMap.at(name);
-                specialFields[static_cast<int>(fn)] = value;
-            }
-            addPoint(name, parent, time, value, childLookup, i);
-        } else if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_BOOL
-                   && refl->HasField(message, field)) {
-            const std::string &name = field->name();
-            const float value = refl->GetBool(message,field) ? 1 : 0;
-            addPoint(name, parent, time, value, childLookup, i);
-        }
-    }
-
-    // precompute strings
-    static const std::string staticVLocal("v_local");
-    static const std::string staticVDesired("v_desired");
-    static const std::string staticVCtrlOut("v_ctrl_out");
-    static const std::string staticVGlobal("v_global");
-
-    // add length of speed vectors
-    tryAddLength(staticVLocal, parent, time,
-                 specialFields[static_cast<int>(SpecialFieldNames::v_f)],
-                 specialFields[static_cast<int>(SpecialFieldNames::v_s)],
-                 childLookup, desc->field_count()+0);
-    tryAddLength(staticVDesired, parent, time,
-                 specialFields[static_cast<int>(SpecialFieldNames::v_d_x)],
-                 specialFields[static_cast<int>(SpecialFieldNames::v_d_y)],
-                 childLookup, desc->field_count()+1);
-    tryAddLength(staticVCtrlOut, parent, time,
-                 specialFields[static_cast<int>(SpecialFieldNames::v_ctrl_out_f)],
-                 specialFields[static_cast<int>(SpecialFieldNames::v_ctrl_out_f)],
-                 childLookup, desc->field_count()+2);
-    tryAddLength(staticVGlobal, parent, time,
-                 specialFields[static_cast<int>(SpecialFieldNames::v_x)],
-                 specialFields[static_cast<int>(SpecialFieldNames::v_y)],
-                 childLookup, desc->field_count()+3);
-}
-
-void Plotter::tryAddLength(const std::string &name, const QString &parent, float time, float value1, float value2,
-                           QVector<QStandardItem *> &childLookup, int descriptorIndex)
+void Plotter::plotCreated(Plot *plot)
 {
-    // if both values are set
-    if (!std::isnan(value1) && !std::isnan(value2)) {
-        const float value = std::sqrt(value1 * value1 + value2 * value2);
-        addPoint(name, parent, time, value, childLookup, descriptorIndex);
-    }
-}
-
-void Plotter::addPoint(const std::string &name, const QString &parent, float time, float value,
-                       QVector<QStandardItem *> &childLookup, int descriptorIndex)
-{
-    QStandardItem *item;
-    if (childLookup.isEmpty() || childLookup[descriptorIndex] == nullptr) {
-        // full name for item retrieval
-        const QString fullName = parent % QStringLiteral(".") % QString::fromStdString(name);
-        item = getItem(fullName);
-        if (!childLookup.isEmpty()) {
-            childLookup[descriptorIndex] = item;
-        }
+    const QString &fullName = plot->name();
+    QStandardItem *item = getItem(fullName);
+    item->setCheckable(true);
+    if (m_selection.contains(fullName)) {
+        emit addPlot(plot); // manually add plot as itemChanged won't add it
+        item->setCheckState(Qt::Checked);
     } else {
-        item = childLookup[descriptorIndex];
-    }
-
-    // save data into a hidden plot while freezed
-    QHash<QStandardItem*, Plot*> &plots = (m_freeze) ? m_frozenPlots : m_plots;
-    Plot *plot = plots.value(item, nullptr);
-
-    if (plot == nullptr) { // create new plot
-        const QString fullName = parent % QStringLiteral(".") % QString::fromStdString(name);
-        plot = new Plot(fullName, this);
-        item->setCheckable(true);
-        if (m_selection.contains(fullName)) {
-            emit addPlot(plot); // manually add plot as itemChanged won't add it
-            item->setCheckState(Qt::Checked);
-        } else {
-            item->setCheckState(Qt::Unchecked);
-        }
-        // set plot information after the check state
-        // itemChanged only checks items in m_plots
-        // thus no enable / disable flickering will occur
-        plots[item] = plot;
-    }
-    // only clear foreground if it's set, causes a serious performance regression
-    // if it's always done
-    if (item->data(Qt::ForegroundRole).isValid()) {
-        item->setData(QVariant(), Qt::ForegroundRole); // clear foreground color
+        item->setCheckState(Qt::Unchecked);
     }
-    plot->addPoint(time, value);
+    // set plot information after the check state
+    // itemChanged only checks items in m_plots
+    // thus no enable / disable flickering will occur
+    m_plots[item] = plot;
 }
 
 void Plotter::clearData()
 {
-    // fix loss of precision when loading multiple log files without restarting the plotter
-    m_startTime = 0;
+    m_time = 0;
     m_guiTimer->requestTriggering();
-    // delete everything
-    foreach (QStandardItem *item, m_items) {
-        // just drop the freeze plot
-        if (m_frozenPlots.contains(item)) {
-            delete m_frozenPlots[item];
-            m_frozenPlots.remove(item);
-        }
-        if (m_plots.contains(item)) {
-            m_plots[item]->clearData();
-        }
-    }
+    // the extractor clears the plots and resets the start time
+    emit extractorDataCleared();
     // force unfreeze as no more data is available
-    setFreeze(false);
+    m_freeze = false;
+    ui->btnFreeze->setChecked(false);
 }
 
 void Plotter::itemChanged(QStandardItem *item)
 {
     // always use m_plots as that's what governs which plot to display
     if (m_plots.contains(item)) {
-        Plot *plot = m_plots[item];
+        const Plot *plot = m_plots[item];
         const QString name = item->data(Plotter::FullNameRole).toString();
         if (item->checkState() == Qt::Checked) {
             // only add plot if it isn't in our selection yet
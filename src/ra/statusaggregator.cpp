@@ -0,0 +1,176 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "statusaggregator.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+StatusAggregator::StatusAggregator(QObject *parent) :
+    QObject(parent),
+    m_flushTimer(new QTimer(this))
+{
+    // deliver the collected status once per display frame
+    qreal refreshRate = 60;
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    if (screen != nullptr && screen->refreshRate() > 0) {
+        refreshRate = screen->refreshRate();
+    }
+    m_flushTimer->setTimerType(Qt::PreciseTimer);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(std::max(1, static_cast<int>(1000 / refreshRate)));
+    connect(m_flushTimer, &QTimer::timeout, this, &StatusAggregator::flush);
+}
+
+void StatusAggregator::handleStatus(const Status &status)
+{
+    if (status->has_pure_ui_response()) {
+        // ui responses are handled immediately, but must not overtake older status
+        flush();
+        emit gotStatusSnapshot(status);
+        emit gotStatusBatch({status});
+        return;
+    }
+
+    if (m_snapshot.isNull()) {
+        m_snapshot = Status::createArena();
+    }
+    mergeSnapshot(*m_snapshot, *status);
+    m_batch.append(status);
+
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void StatusAggregator::flush()
+{
+    m_flushTimer->stop();
+    if (m_batch.isEmpty()) {
+        return;
+    }
+
+    const Status snapshot = m_snapshot;
+    m_snapshot.clear();
+    QList<Status> batch;
+    batch.swap(m_batch);
+
+    emit gotStatusSnapshot(snapshot);
+    emit gotStatusBatch(batch);
+}
+
+bool StatusAggregator::containsRepeated(const google::protobuf::Descriptor *descriptor)
+{
+    // only used from the gui thread
+    static std::unordered_map<const google::protobuf::Descriptor*, bool> cache;
+    auto it = cache.find(descriptor);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    // messages can contain themselves
+    cache[descriptor] = false;
+
+    bool result = false;
+    for (int i = 0; i < descriptor->field_count() && !result; i++) {
+        const google::protobuf::FieldDescriptor *field = descriptor->field(i);
+        result = field->is_repeated()
+                || (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE && containsRepeated(field->message_type()));
+    }
+    cache[descriptor] = result;
+    return result;
+}
+
+void StatusAggregator::mergeSnapshot(amun::Status &snapshot, const amun::Status &status)
+{
+    const google::protobuf::Reflection *refl = status.GetReflection();
+    std::vector<const google::protobuf::FieldDescriptor*> fields;
+    refl->ListFields(status, &fields);
+
+    for (const google::protobuf::FieldDescriptor *field : fields) {
+        if (field->number() == amun::Status::kDebugFieldNumber) {
+            // keep the latest debug values of every source
+            for (const amun::DebugValues &debug : status.debug()) {
+                amun::DebugValues *target = nullptr;
+                for (amun::DebugValues &existing : *snapshot.mutable_debug()) {
+                    if (existing.source() == debug.source()) {
+                        target = &existing;
+                        break;
+                    }
+                }
+                if (target == nullptr) {
+                    target = snapshot.add_debug();
+                }
+                target->CopyFrom(debug);
+            }
+        } else if (field->is_repeated()) {
+            if (field->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+                continue;
+            }
+            // the top level lists are always complete, e.g. the radio commands of one frame
+            refl->ClearField(&snapshot, field);
+            for (int i = 0; i < refl->FieldSize(status, field); i++) {
+                refl->AddMessage(&snapshot, field)->CopyFrom(refl->GetRepeatedMessage(status, field, i));
+            }
+        } else if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+            google::protobuf::Message *target = refl->MutableMessage(&snapshot, field);
+            const google::protobuf::Message &source = refl->GetMessage(status, field);
+            // merging would concatenate lists like the robots of a world state
+            if (containsRepeated(field->message_type())) {
+                target->CopyFrom(source);
+            } else {
+                target->MergeFrom(source);
+            }
+        } else {
+            switch (field->cpp_type()) {
+            case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+                refl->SetInt32(&snapshot, field, refl->GetInt32(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+                refl->SetInt64(&snapshot, field, refl->GetInt64(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+                refl->SetUInt32(&snapshot, field, refl->GetUInt32(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+                refl->SetUInt64(&snapshot, field, refl->GetUInt64(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+                refl->SetFloat(&snapshot, field, refl->GetFloat(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+                refl->SetDouble(&snapshot, field, refl->GetDouble(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+                refl->SetBool(&snapshot, field, refl->GetBool(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+                refl->SetEnum(&snapshot, field, refl->GetEnum(status, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+                refl->SetString(&snapshot, field, refl->GetString(status, field));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef STATUSAGGREGATOR_H
+#define STATUSAGGREGATOR_H
+
+#include "protobuf/status.h"
+#include <QList>
+#include <QObject>
+
+class QTimer;
+namespace google {
+    namespace protobuf {
+        class Descriptor;
+    }
+}
+
+// Collects the status messages between two display frames.
+// Widgets that only show the latest state get one merged snapshot per frame,
+// widgets that need every status get them as a batch.
+class StatusAggregator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StatusAggregator(QObject *parent = nullptr);
+    StatusAggregator(const StatusAggregator&) = delete;
+    StatusAggregator& operator=(const StatusAggregator&) = delete;
+
+    static void mergeSnapshot(amun::Status &snapshot, const amun::Status &status);
+
+signals:
+    void gotStatusSnapshot(const Status &status);
+    void gotStatusBatch(const QList<Status> &statuses);
+
+public slots:
+    void handleStatus(const Status &status);
+    void flush();
+
+private:
+    static bool containsRepeated(const google::protobuf::Descriptor *descriptor);
+
+private:
+    QTimer *m_flushTimer;
+    Status m_snapshot;
+    QList<Status> m_batch;
+};
+
+#endif // STATUSAGGREGATOR_H
@@ -27,6 +27,7 @@
 #include <QMenu>
 #include <cmath>
 #include <QGraphicsRectItem>
+#include <QPainter>
 #include <QOpenGLWidget>
 #include <QSettings>
 #include <QLabel>
@@ -53,6 +54,41 @@
 
 const float ballRadius = 0.02133f;
 
+// paints consecutive visualizations with the same pen and brush
+// every path is still painted separately to keep the blending of overlapping shapes
+class VisualizationBatchItem : public QGraphicsItem
+{
+public:
+    VisualizationBatchItem(const QPen &pen, const QBrush &brush, const QVector<QPainterPath> &paths) :
+        m_pen(pen),
+        m_brush(brush),
+        m_paths(paths)
+    {
+        for (const QPainterPath &path : m_paths) {
+            m_boundingRect |= path.boundingRect();
+        }
+        const qreal margin = (m_pen.style() == Qt::NoPen) ? 0 : m_pen.widthF() / 2;
+        m_boundingRect.adjust(-margin, -margin, margin, margin);
+    }
+
+    QRectF boundingRect() const override { return m_boundingRect; }
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) override
+    {
+        painter->setPen(m_pen);
+        painter->setBrush(m_brush);
+        for (const QPainterPath &path : m_paths) {
+            painter->drawPath(path);
+        }
+    }
+
+private:
+    const QPen m_pen;
+    const QBrush m_brush;
+    const QVector<QPainterPath> m_paths;
+    QRectF m_boundingRect;
+};
+
 class TouchStatusGesture : public QGesture
 {
 public:
@@ -575,7 +611,10 @@ void FieldWidget::updateTeam(RobotMap &team, QHash<uint, robot::Specs> &specsMap
 void FieldWidget::visualizationsChanged(const QStringList &items)
 {
     // list of visible visualizations was changed
-    m_visibleVisualizations = items;
+    m_visibleVisualizations.clear();
+    for (const QString &item : items) {
+        m_visibleVisualizations.insert(item.toStdString());
+    }
     m_visualizationsUpdated = true; // force redraw
     m_guiTimer->requestTriggering();
 }
@@ -637,9 +676,10 @@ void FieldWidget::updateVisualizations()
     }
     m_visualizationsUpdated = false; // don't redraw if nothing new has happened
 
-    // delete visualizations and redraw everything
-    qDeleteAll(m_visualizationItems);
-    m_visualizationItems.clear();
+    // reuse the items of unchanged visualizations, everything else is redrawn
+    Items previousItems;
+    previousItems.swap(m_visualizationItems);
+    m_visualizationOrder = 0;
 
     const bool yellowReplayRunning = m_actionShowYellowReplayVis->isEnabled()
             && m_actionShowYellowReplayVis->isChecked()
@@ -654,20 +694,22 @@ void FieldWidget::updateVisualizations()
             if (m_visibleVisSources.value(debug.source())) {
                 const bool grey = (debug.source() == amun::DebugSource::StrategyYellow && yellowReplayRunning)
                     || (debug.source() == amun::DebugSource::StrategyBlue && blueReplayRunning);
-                updateVisualizations(debug, grey);
+                updateVisualizations(debug, grey, previousItems);
             }
         }
     }
+
+    for (const auto &entry : previousItems) {
+        delete entry.second;
+    }
 }
 
-void FieldWidget::updateVisualizations(const amun::DebugValues &v, const bool grey)
+void FieldWidget::updateVisualizations(const amun::DebugValues &v, const bool grey, Items &previousItems)
 {
-    // use introspection to iterate through the visualizations
-    const google::protobuf::RepeatedPtrField<amun::Visualization> &viss = v.visualization();
-    for (google::protobuf::RepeatedPtrField<amun::Visualization>::const_iterator it = viss.begin(); it != viss.end(); it++) {
-        const amun::Visualization &vis = *it;
+    VisualizationBatch batch;
+    for (const amun::Visualization &vis : v.visualization()) {
         // only draw visible visualizations
-        if (!m_visibleVisualizations.contains(QString::fromStdString(vis.name()))) {
+        if (m_visibleVisualizations.count(vis.name()) == 0) {
             continue;
         }
 
@@ -730,22 +772,104 @@ void FieldWidget::updateVisualizations(const amun::DebugValues &v, const bool gr
             brush = QBrush(col);
         }
 
+        const bool hasPath = vis.has_path() && vis.path().point_size() > 1;
+        if (vis.has_circle() || vis.has_polygon() || hasPath) {
+            if (!batch.paths.isEmpty() && (batch.pen != pen || batch.brush != brush || batch.background != vis.background())) {
+                addVisualizationBatch(batch, previousItems);
+            }
+            if (batch.paths.isEmpty()) {
+                batch.pen = pen;
+                batch.brush = brush;
+                batch.background = vis.background();
+                batch.key = grey ? "g" : "c";
+            }
+            batch.key += vis.SerializeAsString();
+        }
+
         if (vis.has_circle()) {
-            m_visualizationItems << createCircle(pen, brush, vis);
+            const float r = vis.circle().radius();
+            QPainterPath path;
+            path.addEllipse(QPointF(vis.circle().p_x(), vis.circle().p_y()), r, r);
+            batch.paths.append(path);
         }
 
         if (vis.has_polygon()) {
-            m_visualizationItems << createPolygon(pen, brush, vis);
+            QPolygonF polygon;
+            for (const amun::Point &point : vis.polygon().point()) {
+                polygon.append(QPointF(point.x(), point.y()));
+            }
+            QPainterPath path;
+            path.addPolygon(polygon);
+            path.closeSubpath();
+            batch.paths.append(path);
         }
 
-        if (vis.has_path() && vis.path().point_size() > 1) {
-            m_visualizationItems << createPath(pen, brush, vis);
+        if (hasPath) {
+            QPainterPath path;
+            // if the start and end point of a simple line are the same, QPainterPath.lineTo draws nothing (even with a positive line width)
+            if (vis.path().point_size() == 2 && vis.path().point(0).x() == vis.path().point(1).x() &&
+                    vis.path().point(0).y() == vis.path().point(1).y()) {
+                // a radius of zero will discard the ellipse, just use a very very small radius
+                const float EPS = 0.00001f;
+                path.addEllipse(vis.path().point(0).x(), vis.path().point(0).y(), EPS, 0);
+            } else {
+                // a regular line
+                path.moveTo(vis.path().point(0).x(), vis.path().point(0).y());
+                for (int i = 1; i < vis.path().point_size(); i++) {
+                    path.lineTo(vis.path().point(i).x(), vis.path().point(i).y());
+                }
+            }
+            batch.paths.append(path);
         }
 
         if (vis.has_image()) {
-            m_visualizationItems << createFieldFunction(vis);
+            // keep the drawing order
+            addVisualizationBatch(batch, previousItems);
+            // images without draw area depend on the field size
+            const std::string key = "i" + vis.SerializeAsString() + std::to_string(m_fieldRect.left()) + "," + std::to_string(m_fieldRect.top())
+                    + "," + std::to_string(m_fieldRect.width()) + "," + std::to_string(m_fieldRect.height());
+            QGraphicsItem *item = takeVisualizationItem(key, previousItems);
+            if (item == nullptr) {
+                item = createFieldFunction(vis);
+            }
+            addVisualizationItem(key, item, vis.background());
         }
     }
+    addVisualizationBatch(batch, previousItems);
+}
+
+void FieldWidget::addVisualizationBatch(VisualizationBatch &batch, Items &previousItems)
+{
+    if (batch.paths.isEmpty()) {
+        return;
+    }
+    QGraphicsItem *item = takeVisualizationItem(batch.key, previousItems);
+    if (item == nullptr) {
+        item = new VisualizationBatchItem(batch.pen, batch.brush, batch.paths);
+        m_scene->addItem(item);
+    }
+    addVisualizationItem(batch.key, item, batch.background);
+    batch.paths.clear();
+    batch.key.clear();
+}
+
+QGraphicsItem* FieldWidget::takeVisualizationItem(const std::string &key, Items &previousItems)
+{
+    auto it = previousItems.find(key);
+    if (it == previousItems.end()) {
+        return nullptr;
+    }
+    QGraphicsItem *item = it->second;
+    previousItems.erase(it);
+    return item;
+}
+
+void FieldWidget::addVisualizationItem(const std::string &key, QGraphicsItem *item, bool background)
+{
+    // reused items would otherwise be drawn below the newly created ones
+    const qreal order = std::min(m_visualizationOrder++, 500000) * 1E-6;
+    item->setZValue((background ? 1.0f : 10.0f) + order);
+    m_visualizationItems.emplace(key, item);
 }
 
 QGraphicsItem* FieldWidget::createFieldFunction(const amun::Visualization &vis)
@@ -779,70 +903,6 @@ QGraphicsItem* FieldWidget::createFieldFunction(const amun::Visualization &vis)
     return item;
 }
 
-QGraphicsItem* FieldWidget::createCircle(const QPen &pen, const QBrush &brush, const amun::Visualization &vis)
-{
-    QGraphicsEllipseItem *item = new QGraphicsEllipseItem;
-    item->setPen(pen);
-    item->setBrush(brush);
-
-    float r = vis.circle().radius();
-    QRectF rect;
-    rect.setWidth(2 * r);
-    rect.setHeight(2 * r);
-    rect.moveCenter(QPointF(vis.circle().p_x(), vis.circle().p_y()));
-    item->setRect(rect);
-    item->setZValue(vis.background() ? 1.0f : 10.0f);
-    m_scene->addItem(item);
-    return item;
-}
-
-QGraphicsItem* FieldWidget::createPolygon(const QPen &pen, const QBrush &brush, const amun::Visualization &vis)
-{
-    QGraphicsPolygonItem *item = new QGraphicsPolygonItem;
-    item->setPen(pen);
-    item->setBrush(brush);
-
-    QPolygonF polygon;
-    const google::protobuf::RepeatedPtrField<amun::Point> &pts = vis.polygon().point();
-    for (google::protobuf::RepeatedPtrField<amun::Point>::const_iterator it = pts.begin(); it != pts.end(); it++) {
-        const amun::Point &point = *it;
-        polygon.append(QPointF(point.x(), point.y()));
-    }
-
-    item->setPolygon(polygon);
-    item->setZValue(vis.background() ? 1.0f : 10.0f);
-    m_scene->addItem(item);
-    return item;
-}
-
-QGraphicsItem* FieldWidget::createPath(const QPen &pen, const QBrush &brush, const amun::Visualization &vis)
-{
-    QGraphicsPathItem *item = new QGraphicsPathItem;
-    item->setPen(pen);
-    item->setBrush(brush);
-
-    QPainterPath path;
-
-    // if the start and end point of a simple line are the same, QPainterPath.lineTo draws nothing (even with a positive line width)
-    if (vis.path().point_size() == 2 && vis.path().point(0).x() == vis.path().point(1).x() &&
-            vis.path().point(0).y() == vis.path().point(1).y()) {
-        // a radius of zero will discard the ellipse, just use a very very small radius
-        const float EPS = 0.00001f;
-        path.addEllipse(vis.path().point(0).x(), vis.path().point(0).y(), EPS, 0);
-    } else {
-        // a regular line
-        path.moveTo(vis.path().point(0).x(), vis.path().point(0).y());
-        for (int i = 1; i < vis.path().point_size(); i++) {
-            path.lineTo(vis.path().point(i).x(), vis.path().point(i).y());
-        }
-    }
-
-    item->setPath(path);
-    item->setZValue(vis.background() ? 1.0f : 10.0f);
-    m_scene->addItem(item);
-    return item;
-}
-
 void FieldWidget::clearBallTraces()
 {
     clearTrace(m_ballTrace);
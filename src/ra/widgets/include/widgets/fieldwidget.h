@@ -29,6 +29,11 @@
 #include <QMap>
 #include <QHash>
 #include <QQueue>
+#include <QPainterPath>
+#include <QPen>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 class GuiTimer;
 class QLabel;
@@ -73,6 +78,19 @@ private:
     };
 
     typedef QMap<uint, Robot> RobotMap;
+
+    // consecutive visualizations with the same style, drawn by a single item
+    struct VisualizationBatch
+    {
+        QPen pen;
+        QBrush brush;
+        bool background = false;
+        // serialized visualizations, identifies the item between frames
+        std::string key;
+        QVector<QPainterPath> paths;
+    };
+    // visualization items indexed by their content, unchanged items are reused
+    typedef std::unordered_multimap<std::string, QGraphicsItem*> Items;
     enum DragType {
         DragNone =          0x00,
         DragBall =          0x10,
@@ -175,7 +193,10 @@ private:
     void updateGeometry();
     void updateInfoText();
     void updateVisualizations();
-    void updateVisualizations(const amun::DebugValues &v, const bool grey = false);
+    void updateVisualizations(const amun::DebugValues &v, const bool grey, Items &previousItems);
+    void addVisualizationBatch(VisualizationBatch &batch, Items &previousItems);
+    QGraphicsItem* takeVisualizationItem(const std::string &key, Items &previousItems);
+    void addVisualizationItem(const std::string &key, QGraphicsItem *item, bool background);
     void clearTeamData(RobotMap &team);
     void updateTeam(RobotMap &team, QHash<uint, robot::Specs> &specsMap, const robot::Team &specs);
     void setBall(const world::Ball &ball);
@@ -193,10 +214,7 @@ private:
     void sendSimulatorTeleportBall(const QPointF &p);
     void drawLines(QPainter *painter, QRectF rect, bool cosmetic);
     void drawGoal(QPainter *painter, float side, bool cosmetic);
-    QGraphicsItem* createCircle(const QPen &pen, const QBrush &brush, const amun::Visualization &vis);
     QGraphicsItem* createFieldFunction(const amun::Visualization &vis);
-    QGraphicsItem* createPolygon(const QPen &pen, const QBrush &brush, const amun::Visualization &vis);
-    QGraphicsItem* createPath(const QPen &pen, const QBrush &brush, const amun::Visualization &vis);
     void switchScene(int scene);
 
     void invalidateTraces(Trace &trace, TraceMap::iterator begin, TraceMap::iterator end);
@@ -258,9 +276,10 @@ private:
     QGraphicsEllipseItem *m_rollingBall;
     QGraphicsEllipseItem *m_flyingBall;
     QGraphicsEllipseItem *m_realBall = nullptr;
-    QStringList m_visibleVisualizations;
-    typedef QList<QGraphicsItem*> Items;
+    std::unordered_set<std::string> m_visibleVisualizations;
     Items m_visualizationItems;
+    // used to keep the drawing order of reused visualization items
+    int m_visualizationOrder = 0;
     RobotMap m_robotsBlue;
     RobotMap m_robotsYellow;
     RobotMap m_realRobotsBlue;
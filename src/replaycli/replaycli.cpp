@@ -21,9 +21,11 @@
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <clocale>
 #include <QtGlobal>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <memory>
@@ -34,6 +36,7 @@
 #include "strategy/strategyreplayhelper.h"
 #include "strategy/script/compilerregistry.h"
 #include "timingstatistics.h"
+#include "core/allocationprofiler.h"
 #include "core/timer.h"
 #include "replaytestrunner.h"
 
@@ -92,6 +95,8 @@ int main(int argc, char* argv[])
     QCommandLineOption showLogOption({"l", "show-log"}, "Print log output to std::cout");
     QCommandLineOption abortExecution({"d", "die-on-error"}, "Die when a strategy problem occurs");
     QCommandLineOption runTestScript({"t", "test-script"}, "A script to evaluate the test results", "script");
+    QCommandLineOption framesInFlight("frames-in-flight", "Only has effect together with test-script: how many frames the test script may lag behind the strategy", "frames", "20");
+    QCommandLineOption allocationProfile("alloc-profile", "Sample heap allocations during the replay and write them to the specified file (pprof format)", "file");
 
 
     parser.addOption(asBlueOption);
@@ -108,6 +113,8 @@ int main(int argc, char* argv[])
     parser.addOption(showLogOption);
     parser.addOption(abortExecution);
     parser.addOption(runTestScript);
+    parser.addOption(framesInFlight);
+    parser.addOption(allocationProfile);
 
     // parse command line
     parser.process(app);
@@ -170,6 +177,9 @@ int main(int argc, char* argv[])
         timingWriter = std::make_unique<StdoutWriter>();
     }
 
+    // the log file is already loaded, only the replay itself is profiled
+    AllocationProfiler::setEnabled(parser.isSet(allocationProfile));
+
     for (unsigned int i=0; i < runsI; ++i) {
         if (redirect) {
             //keep the reference to filename bytes alive
@@ -191,7 +201,8 @@ int main(int argc, char* argv[])
         std::unique_ptr<Strategy> strategy(new Strategy(&timer, strategyColor, nullptr, &compilerRegistry, connection, false, true));
         std::unique_ptr<ReplayTestRunner> testRunner;
         if (runAsTest) {
-            testRunner.reset(new ReplayTestRunner(currentDirectory.absoluteFilePath(parser.value(runTestScript)), strategyColor, &compilerRegistry));
+            testRunner.reset(new ReplayTestRunner(currentDirectory.absoluteFilePath(parser.value(runTestScript)), strategyColor,
+                                                  &compilerRegistry, parser.value(framesInFlight).toInt()));
             strategy->connect(strategy.get(), SIGNAL(sendStatus(Status)), testRunner.get(), SLOT(handleOriginalStatus(Status)));
         }
 
@@ -238,6 +249,9 @@ int main(int argc, char* argv[])
 
         bool hasExecutionState = false;
         qint64 lastExecutionTime = 0;
+        const AllocationProfiler::Totals allocationsBefore = AllocationProfiler::totals();
+        QElapsedTimer replayTimer;
+        replayTimer.start();
         for (int i = 0; i<packetCount; i++) {
             Status status = logfile->readStatus(i);
 
@@ -293,10 +307,35 @@ int main(int argc, char* argv[])
 
         if (runAsTest) {
             testRunner->runFinalReplayJudgement();
-        } else {
+        }
+        // stdout may be parsed, thus report the throughput separately
+        const double replaySeconds = replayTimer.nsecsElapsed() * 1E-9;
+        std::cerr << "Replayed " << packetCount << " frames in " << replaySeconds << " s ("
+                  << packetCount / replaySeconds << " frames/s)";
+        if (runAsTest) {
+            const BlockingStrategyReplay &pipeline = testRunner->pipeline();
+            std::cerr << ", test script: " << pipeline.processedFrames() << " frames with up to "
+                      << pipeline.framesInFlight() << " in flight, waited " << pipeline.stallTime() * 1E-6 << " ms";
+        }
+        if (AllocationProfiler::isEnabled()) {
+            const AllocationProfiler::Totals allocations = AllocationProfiler::totals();
+            const quint64 count = allocations.allocations - allocationsBefore.allocations;
+            std::cerr << ", " << count << " allocations (" << count / double(std::max(packetCount, 1)) << " per frame, "
+                      << (allocations.bytes - allocationsBefore.bytes) / (1024 * 1024) << " MiB)";
+        }
+        std::cerr << std::endl;
+
+        if (!runAsTest) {
             // no timing statistics are printed if the cli is used as a replay test runner
             statistics.printStatistics(i, parser.isSet(showHistogramOption), parser.isSet(showHistogramCumulativeOption));
         }
     }
+
+    if (parser.isSet(allocationProfile)) {
+        AllocationProfiler::setEnabled(false);
+        if (!AllocationProfiler::writePprofProfile(parser.value(allocationProfile))) {
+            std::cerr << "Could not write allocation profile to " << parser.value(allocationProfile).toStdString() << std::endl;
+        }
+    }
     return 0;
 }
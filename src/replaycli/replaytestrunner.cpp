@@ -46,18 +46,40 @@ Command createLoadCommand(bool asBlue, QString initScript, QString entryPoint, b
     return command;
 }
 
-ReplayTestRunner::ReplayTestRunner(QString testFile, StrategyType type, CompilerRegistry* compilerRegistry) :
+ReplayTestRunner::ReplayTestRunner(QString testFile, StrategyType type, CompilerRegistry* compilerRegistry, int framesInFlight) :
     m_compilerRegistry(compilerRegistry),
     m_gameControllerConnection(new StrategyGameControllerMediator(false)),
-    m_testStrategy(&m_timer, type, nullptr, m_compilerRegistry, m_gameControllerConnection, false, true),
+    m_testStrategy(new Strategy(&m_timer, type, nullptr, m_compilerRegistry, m_gameControllerConnection, false, true)),
     m_exitCode(255),
     m_type(type),
     m_firstGameStateCopied(false)
 {
     m_timer.setTime(0, 1.0);
-    connect(&m_testStrategy, SIGNAL(sendStatus(Status)), this, SLOT(handleTestStatus(Status)));
+    connect(m_testStrategy, SIGNAL(sendStatus(Status)), this, SLOT(handleTestStatus(Status)));
+    m_testStrategy->moveToThread(&m_testThread);
+    connect(&m_testThread, SIGNAL(finished()), m_testStrategy, SLOT(deleteLater()));
+    m_pipeline.reset(new BlockingStrategyReplay(m_testStrategy, framesInFlight));
+    m_testThread.start();
+
+    // the script must be created in the strategy thread, the load is queued before any status
     // use the replay strategy type, as the replay information is only present in the given color
-    m_testStrategy.handleCommand(createLoadCommand(type == StrategyType::BLUE, testFile, "", true));
+    const Command load = createLoadCommand(type == StrategyType::BLUE, testFile, "", true);
+    Strategy *strategy = m_testStrategy;
+    QMetaObject::invokeMethod(m_testStrategy, [strategy, load]() {
+        strategy->handleCommand(load);
+    }, Qt::QueuedConnection);
+}
+
+ReplayTestRunner::~ReplayTestRunner()
+{
+    m_testThread.quit();
+    m_testThread.wait();
+}
+
+void ReplayTestRunner::deliverTestStatus()
+{
+    // the test strategy results are queued for this thread, which does not run an event loop during the replay
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
 }
 
 void ReplayTestRunner::runFinalReplayJudgement()
@@ -72,7 +94,9 @@ void ReplayTestRunner::runFinalReplayJudgement()
     emptyStatus->mutable_execution_state()->set_time(0);
     Q_ASSERT(m_firstGameStateCopied);
     emptyStatus->mutable_execution_game_state()->CopyFrom(m_firstGameState);
-    m_testStrategy.handleStatus(emptyStatus);
+    m_pipeline->handleStatus(emptyStatus);
+    m_pipeline->flush();
+    deliverTestStatus();
 }
 
 void ReplayTestRunner::handleOriginalStatus(const Status &status)
@@ -102,7 +126,8 @@ void ReplayTestRunner::handleOriginalStatus(const Status &status)
     if (!status->has_time() || !status->has_execution_state()) {
         return;
     }
-    m_testStrategy.handleStatus(status);
+    m_pipeline->handleStatus(status);
+    deliverTestStatus();
 }
 
 void ReplayTestRunner::handleStrategyStatus(const amun::StatusStrategy &strategy)
@@ -22,8 +22,11 @@
 #define REPLAYTESTRUNNER_H
 
 #include <QObject>
+#include <QThread>
+#include <memory>
 
 #include "strategy/strategy.h"
+#include "strategy/strategyreplayhelper.h"
 #include "core/timer.h"
 
 class CompilerRegistry;
@@ -34,8 +37,13 @@ class ReplayTestRunner : public QObject
 {
     Q_OBJECT
 public:
-    explicit ReplayTestRunner(QString testFile, StrategyType type, CompilerRegistry *compilerRegistry);
+    explicit ReplayTestRunner(QString testFile, StrategyType type, CompilerRegistry *compilerRegistry, int framesInFlight);
+    ~ReplayTestRunner() override;
+    ReplayTestRunner(const ReplayTestRunner&) = delete;
+    ReplayTestRunner& operator=(const ReplayTestRunner&) = delete;
+
     void runFinalReplayJudgement();
+    const BlockingStrategyReplay &pipeline() const { return *m_pipeline; }
 
 public slots:
     // this slot must be connected externally
@@ -46,12 +54,16 @@ private slots:
 
 private:
     void handleStrategyStatus(const amun::StatusStrategy &strategy);
+    void deliverTestStatus();
 
 private:
     Timer m_timer;
     CompilerRegistry* m_compilerRegistry;
     std::shared_ptr<StrategyGameControllerMediator> m_gameControllerConnection;
-    Strategy m_testStrategy;
+    // runs in its own thread, overlapping with the strategy under test
+    QThread m_testThread;
+    Strategy *m_testStrategy;
+    std::unique_ptr<BlockingStrategyReplay> m_pipeline;
     int m_exitCode;
     StrategyType m_type;
     // used to create the last final judgement packet, since an initialized game state is needed. The content is not relevant
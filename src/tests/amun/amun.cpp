@@ -151,3 +151,53 @@ TEST(Amun, DISABLED_TrackingReplay) {
         }
     }
 }
+
+#ifdef V8_FOUND
+TEST(Amun, LockstepIsReproducible) {
+    const QStringList logfiles = {"temp_unittest_lockstep_1.log", "temp_unittest_lockstep_2.log"};
+    class DeleteFiles {
+    public:
+        DeleteFiles(const QStringList &files) : m_files(files) {}
+        ~DeleteFiles() {
+            for (const QString &file : m_files) {
+                QFile::remove(file);
+            }
+        }
+    private:
+        const QStringList m_files;
+    };
+    DeleteFiles del(logfiles);
+
+    const QString strategy = QString::fromStdString(ERFORCE_STRATEGYDIR) + "typescript/glados/init.ts";
+    const QString amunCliExecutable = QString("%1/amun-cli").arg(AMUNCLI_DIR);
+    for (const QString &logfile : logfiles) {
+        int exitCode = QProcess::execute(amunCliExecutable, {"-c", "both", "-s", "2020", "-t", "3", "-n", "6", "--robot-generation",
+                                                            "generation_2020", "-r", logfile, "--lockstep", "--seed", "42",
+                                                            "--silent", "-f", strategy, "main"});
+        ASSERT_EQ(exitCode, 0);
+    }
+
+    LogFileReader first;
+    ASSERT_TRUE(first.open(logfiles[0]));
+    LogFileReader second;
+    ASSERT_TRUE(second.open(logfiles[1]));
+    ASSERT_EQ(first.packetCount(), second.packetCount());
+
+    int worldStates = 0;
+    for (int i = 0;i<first.packetCount();i++) {
+        Status s1 = first.readStatus(i);
+        Status s2 = second.readStatus(i);
+        ASSERT_FALSE(s1.isNull());
+        ASSERT_FALSE(s2.isNull());
+        ASSERT_EQ(s1->time(), s2->time());
+        ASSERT_EQ(s1->has_world_state(), s2->has_world_state());
+        if (s1->has_world_state()) {
+            ASSERT_EQ(s1->world_state().time(), s2->world_state().time());
+            checkWorldEquality(s1->world_state(), s2->world_state());
+            worldStates++;
+        }
+    }
+    // 3 seconds of simulation must yield enough world states for a meaningful comparison
+    ASSERT_GT(worldStates, 100);
+}
+#endif
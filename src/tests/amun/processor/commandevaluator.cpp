@@ -0,0 +1,171 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "commandevaluator.h"
+#include "protobuf/debug.pb.h"
+#include "protobuf/world.pb.h"
+#include <cmath>
+#include <vector>
+
+static const qint64 CONTROL_STEP_NS = 10 * 1000 * 1000;
+
+static robot::Spline makeSpline(float tStart, float tEnd, float seed)
+{
+    robot::Spline spline;
+    spline.set_t_start(tStart);
+    spline.set_t_end(tEnd);
+    robot::Polynomial *polynomials[3] = { spline.mutable_x(), spline.mutable_y(), spline.mutable_phi() };
+    for (int i = 0; i < 3; i++) {
+        polynomials[i]->set_a0(seed + i);
+        polynomials[i]->set_a1(0.5f * seed - i);
+        polynomials[i]->set_a2(0.25f * (i + 1) - 0.1f * seed);
+        polynomials[i]->set_a3(0.05f * seed * (i - 1));
+    }
+    return spline;
+}
+
+// the speed of the first spline that contains t, evaluated from the protobuf coefficients
+static void referenceSpeed(const robot::ControllerInput &input, float t, float speed[3])
+{
+    speed[0] = speed[1] = speed[2] = 0;
+    for (const robot::Spline &spline : input.spline()) {
+        if (spline.t_start() <= t && t < spline.t_end()) {
+            const robot::Polynomial *polynomials[3] = { &spline.x(), &spline.y(), &spline.phi() };
+            for (int i = 0; i < 3; i++) {
+                speed[i] = polynomials[i]->a1() + (2 * polynomials[i]->a2() + 3 * polynomials[i]->a3() * t) * t;
+            }
+            return;
+        }
+    }
+}
+
+static void expectSpeed(const robot::SpeedVector &output, const robot::ControllerInput &input, qint64 worldTime, qint64 startTime)
+{
+    float expected[3];
+    referenceSpeed(input, (worldTime - startTime) * 1E-9f, expected);
+    EXPECT_NEAR(output.v_x(), expected[0], 1E-3f);
+    EXPECT_NEAR(output.v_y(), expected[1], 1E-3f);
+    EXPECT_NEAR(output.omega(), expected[2], 1E-3f);
+}
+
+class CommandEvaluatorTest : public ::testing::Test
+{
+protected:
+    CommandEvaluatorTest()
+    {
+        m_specs.set_generation(3);
+        m_specs.set_year(2020);
+        m_specs.set_id(1);
+        // practically unlimited, the outputs then follow the spline exactly
+        robot::LimitParameters *limits[2] = { m_specs.mutable_acceleration(), m_specs.mutable_strategy() };
+        for (robot::LimitParameters *limit : limits) {
+            limit->set_a_speedup_f_max(1E6f);
+            limit->set_a_speedup_s_max(1E6f);
+            limit->set_a_speedup_phi_max(1E6f);
+            limit->set_a_brake_f_max(1E6f);
+            limit->set_a_brake_s_max(1E6f);
+            limit->set_a_brake_phi_max(1E6f);
+        }
+
+        m_robot.set_id(1);
+        m_robot.set_p_x(0);
+        m_robot.set_p_y(0);
+        m_robot.set_phi(0.3f);
+        m_robot.set_v_x(0);
+        m_robot.set_v_y(0);
+        m_robot.set_omega(0);
+    }
+
+    // compares the evaluation with the reference at the given times after the input start
+    void checkInput(CommandEvaluator &evaluator, const robot::ControllerInput &input, qint64 startTime,
+                    const std::vector<float> &times)
+    {
+        evaluator.setInput(input, startTime);
+        for (float time : times) {
+            SCOPED_TRACE(time);
+            const qint64 worldTime = startTime + qint64(time * 1E9) - CONTROL_STEP_NS;
+
+            amun::DebugValues debug;
+            debug.set_source(amun::Controller);
+            robot::Command command;
+            evaluator.calculateCommand(&m_robot, worldTime, command, &debug);
+
+            expectSpeed(command.output1(), input, worldTime + CONTROL_STEP_NS, startTime);
+            expectSpeed(command.output2(), input, worldTime + 2 * CONTROL_STEP_NS, startTime);
+        }
+    }
+
+    robot::Specs m_specs;
+    world::Robot m_robot;
+};
+
+// times outside of the splines, in gaps and going backwards like after a seek
+static const std::vector<float> TIMES = { -0.5f, 0.f, 0.13f, 0.49f, 0.55f, 0.7f, 1.1f, 1.3f, 0.3f, 1.9f, 2.2f, 3.4f, 3.6f, 0.05f, 5.f };
+
+TEST_F(CommandEvaluatorTest, OrderedSplines) {
+    robot::ControllerInput input;
+    *input.add_spline() = makeSpline(0, 0.5f, 1);
+    *input.add_spline() = makeSpline(0.5f, 1.2f, 2);
+    *input.add_spline() = makeSpline(1.2f, 3, -1);
+    *input.add_spline() = makeSpline(3.5f, INFINITY, 0.5f);
+
+    CommandEvaluator evaluator(m_specs);
+    checkInput(evaluator, input, 1000000000LL, TIMES);
+}
+
+TEST_F(CommandEvaluatorTest, OverlappingSplines) {
+    robot::ControllerInput input;
+    *input.add_spline() = makeSpline(0, 1, 1);
+    *input.add_spline() = makeSpline(0.5f, 2, -2);
+    *input.add_spline() = makeSpline(0.2f, 0.6f, 3);
+    *input.add_spline() = makeSpline(1.5f, 4, 0.5f);
+
+    CommandEvaluator evaluator(m_specs);
+    checkInput(evaluator, input, 1000000000LL, TIMES);
+}
+
+TEST_F(CommandEvaluatorTest, UnorderedSplines) {
+    robot::ControllerInput input;
+    *input.add_spline() = makeSpline(1.2f, 3, 2);
+    *input.add_spline() = makeSpline(0, 0.5f, 1);
+    *input.add_spline() = makeSpline(3.5f, INFINITY, -1);
+    *input.add_spline() = makeSpline(0.5f, 1.2f, 0.5f);
+
+    CommandEvaluator evaluator(m_specs);
+    checkInput(evaluator, input, 1000000000LL, TIMES);
+}
+
+TEST_F(CommandEvaluatorTest, NewInputResetsTime) {
+    robot::ControllerInput first;
+    *first.add_spline() = makeSpline(0, 1, 1);
+    *first.add_spline() = makeSpline(1, 2, 2);
+    *first.add_spline() = makeSpline(2, 3, 3);
+
+    robot::ControllerInput second;
+    *second.add_spline() = makeSpline(0, 0.4f, -1);
+    *second.add_spline() = makeSpline(0.4f, 0.8f, -2);
+    *second.add_spline() = makeSpline(0.8f, INFINITY, -3);
+
+    // the last active spline of the first input must not be used for the second one
+    CommandEvaluator evaluator(m_specs);
+    checkInput(evaluator, first, 1000000000LL, { 0.5f, 1.5f, 2.5f });
+    checkInput(evaluator, second, 3450000000LL, { 0.1f, 0.5f, 0.9f, 0.2f });
+    checkInput(evaluator, first, 4500000000LL, { 2.5f, 0.5f });
+}
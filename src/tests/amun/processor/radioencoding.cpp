@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "processor/radio_address.h"
+#include "processor/radiocommandencoder.h"
+#include "processor/transceiverpacket.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace Radio;
+
+static robot::Command makeCommand(int id)
+{
+    robot::Command command;
+    command.set_kick_style(robot::Command::Linear);
+    command.set_kick_power(id * 0.5f);
+    command.set_dribbler(0.5f);
+    command.set_cur_v_s(0.1f * id);
+    command.set_cur_v_f(-0.1f * id);
+    command.set_cur_phi(0.2f * id);
+    command.set_cur_omega(0.3f);
+    for (robot::SpeedVector *output : {command.mutable_output0(), command.mutable_output1(), command.mutable_output2()}) {
+        output->set_v_x(0.2f * id);
+        output->set_v_y(-0.1f * id);
+        output->set_v_s(0.1f);
+        output->set_v_f(0.3f);
+        output->set_omega(1.5f);
+    }
+    return command;
+}
+
+TEST(RadioEncoding, PacketLayout) {
+    TransceiverPacket packet;
+    ASSERT_EQ(packet.size(), 0u);
+
+    char payload[RadioCommandEncoder::MAX_PAYLOAD_SIZE];
+    const std::size_t size = RadioCommandEncoder::encodePasta(makeCommand(1), 1, true, 42, 10, 1000, payload);
+    ASSERT_GT(size, 0u);
+    ASSERT_LE(size, RadioCommandEncoder::MAX_PAYLOAD_SIZE);
+
+    ASSERT_TRUE(packet.addSendCommand(Address { Unicast, Generation::GenPasta, 1 }, RadioCommandEncoder::expectedResponseSizePasta(), payload, size));
+    // command header, nrf24 target address and the payload
+    const std::size_t commandSize = packet.size();
+    ASSERT_EQ(commandSize, 2 + 6 + size);
+    ASSERT_EQ(std::string(packet.data() + commandSize - size, size), std::string(payload, size));
+
+    ASSERT_TRUE(packet.addPing(12345));
+    ASSERT_EQ(packet.size(), commandSize + 2 + 8);
+    ASSERT_TRUE(packet.addStatusRequest());
+    ASSERT_EQ(packet.size(), commandSize + 2 + 8 + 2);
+
+    packet.clear();
+    ASSERT_EQ(packet.size(), 0u);
+}
+
+TEST(RadioEncoding, FullPacketRejectsCommands) {
+    TransceiverPacket packet;
+    char payload[RadioCommandEncoder::MAX_PAYLOAD_SIZE];
+    const std::size_t size = RadioCommandEncoder::encode2014(makeCommand(3), 3, false, 1, 0, payload);
+
+    const Address target { Unicast, Generation::Gen2014, 3 };
+    while (packet.addSendCommand(target, RadioCommandEncoder::expectedResponseSize2014(), payload, size));
+    const std::size_t fullSize = packet.size();
+    ASSERT_LE(fullSize, TransceiverPacket::CAPACITY);
+    ASSERT_GT(fullSize + 2 + 6 + size, TransceiverPacket::CAPACITY);
+
+    ASSERT_FALSE(packet.addSendCommand(target, RadioCommandEncoder::expectedResponseSize2014(), payload, size));
+    ASSERT_EQ(packet.size(), fullSize);
+}
+
+// encodes the commands for a full team, as done by the RadioSystem every 10 ms
+// disabled by default, run it with --gtest_also_run_disabled_tests
+TEST(RadioEncoding, DISABLED_Benchmark16Robots) {
+    std::vector<robot::Command> commands;
+    for (int i = 0; i < 16; i++) {
+        commands.push_back(makeCommand(i));
+    }
+
+    const int CYCLES = 20000;
+    TransceiverPacket packet;
+    std::vector<std::int64_t> durations;
+    durations.reserve(CYCLES);
+    std::size_t expectedSize = 0;
+
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        const auto start = std::chrono::steady_clock::now();
+
+        const quint8 counter = cycle % 256;
+        char payload[RadioCommandEncoder::MAX_PAYLOAD_SIZE];
+        packet.clear();
+        for (int id = 0; id < 16; id++) {
+            const std::size_t size = RadioCommandEncoder::encodePasta(commands[id], id, true, counter, 0, 500000, payload);
+            packet.addSendCommand(Address { Unicast, Generation::GenPasta, id }, RadioCommandEncoder::expectedResponseSizePasta(), payload, size);
+        }
+        packet.addPing(cycle);
+
+        const auto end = std::chrono::steady_clock::now();
+        durations.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+        if (cycle == 0) {
+            expectedSize = packet.size();
+        }
+        ASSERT_EQ(packet.size(), expectedSize);
+    }
+
+    std::sort(durations.begin(), durations.end());
+    std::cout << "[ BENCH    ] radio encoding of 16 robots: median " << durations[CYCLES / 2]
+              << " ns, 99th percentile " << durations[CYCLES * 99 / 100]
+              << " ns, max " << durations.back() << " ns" << std::endl;
+}
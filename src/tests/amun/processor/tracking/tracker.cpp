@@ -0,0 +1,108 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "protobuf/ssl_detection.pb.h"
+#include "protobuf/ssl_geometry.pb.h"
+#include "protobuf/world.pb.h"
+#include "tracking/tracker.h"
+#include "tracking/worldparameters.h"
+
+static SSL_DetectionFrame createFrame(int frameNumber, qint64 time)
+{
+    const float t = frameNumber * 0.01f;
+
+    SSL_DetectionFrame frame;
+    frame.set_frame_number(frameNumber);
+    frame.set_t_capture(time * 1E-9);
+    frame.set_t_sent(time * 1E-9);
+    frame.set_camera_id(0);
+
+    SSL_DetectionRobot *robot = frame.add_robots_yellow();
+    robot->set_confidence(1);
+    robot->set_robot_id(3);
+    robot->set_x(1000 * t);
+    robot->set_y(-500 + 300 * t);
+    robot->set_orientation(t);
+    robot->set_pixel_x(0);
+    robot->set_pixel_y(0);
+
+    SSL_DetectionBall *ball = frame.add_balls();
+    ball->set_confidence(1);
+    ball->set_area(100);
+    ball->set_x(-2000 * t);
+    ball->set_y(100);
+    ball->set_pixel_x(0);
+    ball->set_pixel_y(0);
+    return frame;
+}
+
+static void runFrames(Tracker &tracker, int start, int end, world::State &state)
+{
+    const qint64 FRAME_TIME = 10 * 1000 * 1000;
+    for (int i = start; i < end; i++) {
+        const qint64 time = 1000000000LL + i * FRAME_TIME;
+        tracker.queuePacket(createFrame(i, time), time);
+        tracker.process(time + FRAME_TIME / 2);
+        state.Clear();
+        tracker.worldState(&state, time + FRAME_TIME / 2, true);
+    }
+}
+
+TEST(Tracker, CheckpointRestoresState)
+{
+    WorldParameters worldParameters(false, true);
+    Tracker tracker(false, false, &worldParameters);
+
+    SSL_GeometryCameraCalibration camera;
+    camera.set_camera_id(0);
+    camera.set_focal_length(400);
+    camera.set_principal_point_x(0);
+    camera.set_principal_point_y(0);
+    camera.set_distortion(0);
+    camera.set_q0(0);
+    camera.set_q1(0);
+    camera.set_q2(0);
+    camera.set_q3(0);
+    camera.set_tx(0);
+    camera.set_ty(0);
+    camera.set_tz(0);
+    camera.set_derived_camera_world_tx(0);
+    camera.set_derived_camera_world_ty(0);
+    camera.set_derived_camera_world_tz(4000);
+    tracker.updateCamera(camera, "test");
+
+    world::State state;
+    runFrames(tracker, 0, 50, state);
+    ASSERT_EQ(state.yellow_size(), 1);
+    ASSERT_TRUE(state.has_ball());
+
+    auto checkpoint = tracker.checkpoint();
+
+    world::State continuous;
+    runFrames(tracker, 50, 100, continuous);
+
+    // the tracker is modified after the checkpoint was taken, this must not change the result
+    tracker.reset();
+    tracker.restore(*checkpoint);
+    world::State restored;
+    runFrames(tracker, 50, 100, restored);
+
+    ASSERT_EQ(continuous.SerializeAsString(), restored.SerializeAsString());
+}
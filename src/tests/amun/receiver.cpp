@@ -0,0 +1,81 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "receiver.h"
+#include "core/timer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QUdpSocket>
+#include <string>
+
+#ifdef Q_OS_LINUX
+
+static const quint16 TEST_PORT = 10099;
+
+TEST(Receiver, DeliversPendingDatagramsTogether) {
+    std::string appName = "unittest";
+    char* args[2] = {const_cast<char*>(appName.c_str()), nullptr};
+    int argCount = 1;
+    QCoreApplication app(argCount, args);
+
+    Timer timer;
+    timer.setTime(1000 * 1000 * 1000, 1.0);
+    Receiver receiver(QHostAddress(), TEST_PORT, &timer);
+    QList<QList<Datagram>> batches;
+    QObject::connect(&receiver, &Receiver::gotPackets, [&batches](const QList<Datagram> &packets) {
+        batches.append(packets);
+    });
+    receiver.startListen();
+
+    const int COUNT = 5;
+    QUdpSocket sender;
+    const qint64 sendStart = timer.currentTime();
+    for (int i = 0; i < COUNT; i++) {
+        const QByteArray data = QByteArray("datagram ") + QByteArray::number(i);
+        ASSERT_EQ(sender.writeDatagram(data, QHostAddress::LocalHost, TEST_PORT), data.size());
+    }
+    const qint64 sendEnd = timer.currentTime();
+
+    // the receive times must not include the time until the receiver gets to read the datagrams
+    QThread::msleep(50);
+    QElapsedTimer timeout;
+    timeout.start();
+    while (batches.isEmpty() && timeout.elapsed() < 1000) {
+        app.processEvents();
+    }
+
+    ASSERT_EQ(batches.size(), 1);
+    const QList<Datagram> &packets = batches.first();
+    ASSERT_EQ(packets.size(), COUNT);
+    qint64 lastTime = sendStart;
+    for (int i = 0; i < COUNT; i++) {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(packets[i].data, QByteArray("datagram ") + QByteArray::number(i));
+        EXPECT_EQ(packets[i].sender, QString("127.0.0.1"));
+        // kernel timestamps converted to the internal time of the timer
+        EXPECT_GE(packets[i].time, lastTime);
+        EXPECT_LE(packets[i].time, sendEnd);
+        lastTime = packets[i].time;
+    }
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "seshat/logfilecatalog.h"
+#include "seshat/logfilewriter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+static void writeLog(const QString &filename, const std::string &hash, int packets)
+{
+    LogFileWriter writer;
+    ASSERT_TRUE(writer.open(filename, true));
+    for (int i = 0;i<packets;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        if (i == 0 && !hash.empty()) {
+            status->mutable_log_id()->add_parts()->set_hash(hash);
+        }
+        writer.writeStatus(status);
+    }
+    writer.close();
+}
+
+static logfile::Uid makeUid(const std::string &hash)
+{
+    logfile::Uid uid;
+    uid.add_parts()->set_hash(hash);
+    return uid;
+}
+
+static QStringList offeredNames(const LogFileCatalog &catalog, const std::string &hash, const QStringList &directories)
+{
+    logfile::LogOffer offers;
+    catalog.addOffers(makeUid(hash), directories, &offers);
+    QStringList names;
+    for (const auto &entry : offers.entries()) {
+        names.append(QString::fromStdString(entry.name()));
+    }
+    return names;
+}
+
+TEST(LogFileCatalog, FindsLogsAndPersists) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QStringList directories = {dir.path() + "/logs"};
+    ASSERT_TRUE(QDir().mkpath(directories[0]));
+    const QString catalogFile = dir.filePath("catalog");
+
+    writeLog(directories[0] + "/a.log", "aaaa", 5);
+    writeLog(directories[0] + "/b.log", "bbbb", 5);
+    writeLog(directories[0] + "/nouid.log", "", 5);
+
+    {
+        LogFileCatalog catalog(catalogFile);
+        catalog.update(directories);
+        ASSERT_EQ(catalog.fileCount(), 3);
+        // logs without uid are always offered
+        ASSERT_EQ(offeredNames(catalog, "aaaa", directories), QStringList({"a.log", "nouid.log"}));
+        ASSERT_EQ(offeredNames(catalog, "cccc", directories), QStringList({"nouid.log"}));
+        ASSERT_TRUE(catalog.save());
+    }
+
+    {
+        // the stored catalog is used without scanning the directories
+        LogFileCatalog catalog(catalogFile);
+        catalog.update({});
+        ASSERT_EQ(catalog.fileCount(), 3);
+        ASSERT_EQ(offeredNames(catalog, "bbbb", directories), QStringList({"b.log", "nouid.log"}));
+
+        // modified and removed files are detected
+        writeLog(directories[0] + "/a.log", "cccc", 10);
+        ASSERT_TRUE(QFile::remove(directories[0] + "/b.log"));
+        catalog.update(directories);
+        ASSERT_EQ(catalog.fileCount(), 2);
+        ASSERT_EQ(offeredNames(catalog, "aaaa", directories), QStringList({"nouid.log"}));
+        ASSERT_EQ(offeredNames(catalog, "cccc", directories), QStringList({"a.log", "nouid.log"}));
+    }
+}
+
+TEST(LogFileCatalog, DetectsChangesOfKnownFiles) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QStringList directories = {dir.path()};
+
+    // a log which is still being recorded has no readable status yet
+    writeLog(directories[0] + "/recording.log", "", 0);
+
+    LogFileCatalog catalog(dir.filePath("catalog"));
+    catalog.update(directories);
+    ASSERT_EQ(catalog.fileCount(), 1);
+    ASSERT_EQ(offeredNames(catalog, "aaaa", directories), QStringList({"recording.log"}));
+
+    // the directory itself is unchanged, the file must be read again nonetheless
+    writeLog(directories[0] + "/recording.log", "aaaa", 20);
+    catalog.update(directories);
+    ASSERT_EQ(catalog.fileCount(), 1);
+    ASSERT_EQ(offeredNames(catalog, "aaaa", directories), QStringList({"recording.log"}));
+    ASSERT_EQ(offeredNames(catalog, "bbbb", directories), QStringList());
+}
@@ -60,3 +60,114 @@ TEST(LogfileReader, TimestampZeroIsInvalid) {
     writer.close();
     ASSERT_FALSE(reader.open(filename));
 }
+
+TEST(LogfileReader, SeekReturnsCompleteStatus) {
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+    DeleteFile del;
+
+    LogFileWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    for (int i = 0;i<1300;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        if (i == 3) {
+            robot::Specs *specs = status->mutable_team_blue()->add_robot();
+            specs->set_generation(3);
+            specs->set_year(2020);
+            specs->set_id(7);
+        }
+        // only every other status contains a world state, seek to odd packets to test it
+        if (i % 2 == 0) {
+            status->mutable_world_state()->set_time(i + 1);
+        }
+        writer.writeStatus(status);
+    }
+    writer.close();
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+
+    QList<QPair<int, Status>> received;
+    QObject::connect(&reader, &StatusSource::gotStatus, [&received](int packet, const Status &status) {
+        received.append(qMakePair(packet, status));
+    });
+
+    for (int packet : {1201, 3, 1201, 801}) {
+        received.clear();
+        reader.seekPackets(packet, 3);
+        ASSERT_EQ(received.size(), 3);
+        for (int i = 0;i<3;i++) {
+            ASSERT_EQ(received[i].first, packet + i);
+            ASSERT_EQ(received[i].second->time(), packet + i + 1);
+        }
+
+        const Status &complete = received[0].second;
+        ASSERT_TRUE(complete->has_world_state());
+        ASSERT_EQ(complete->world_state().time(), packet);
+        ASSERT_EQ(complete->has_team_blue(), packet >= 3);
+        if (complete->has_team_blue()) {
+            ASSERT_EQ(complete->team_blue().robot_size(), 1);
+            ASSERT_EQ(complete->team_blue().robot(0).id(), 7u);
+        }
+        // only the first status is amended
+        ASSERT_FALSE(received[1].second->has_team_blue());
+    }
+}
+
+TEST(LogfileReader, SeekPastKeyframeKeepsBoundaryPacket) {
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+    DeleteFile del;
+
+    // the last world state and debug output are in packet 500, which ends the first keyframe
+    LogFileWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    for (int i = 0;i<1100;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        if (i == 100 || i == 500) {
+            status->mutable_world_state()->set_time(i + 1);
+            amun::DebugValues *debug = status->add_debug();
+            debug->set_source(amun::Tracking);
+            debug->set_time(i + 1);
+        }
+        if (i == 200) {
+            amun::DebugValues *debug = status->add_debug();
+            debug->set_source(amun::Controller);
+            debug->set_time(i + 1);
+        }
+        writer.writeStatus(status);
+    }
+    writer.close();
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+
+    QList<Status> received;
+    QObject::connect(&reader, &StatusSource::gotStatus, [&received](int, const Status &status) {
+        received.append(status);
+    });
+
+    for (int packet : {501, 1050, 501}) {
+        received.clear();
+        reader.seekPackets(packet, 1);
+        ASSERT_EQ(received.size(), 1);
+
+        const Status &complete = received[0];
+        ASSERT_TRUE(complete->has_world_state());
+        ASSERT_EQ(complete->world_state().time(), 501);
+        ASSERT_EQ(complete->debug_size(), 2);
+        for (const amun::DebugValues &debug : complete->debug()) {
+            ASSERT_EQ(debug.time(), debug.source() == amun::Tracking ? 501 : 201);
+        }
+    }
+}
@@ -33,8 +33,10 @@
 #include <QObject>
 #include <QQuaternion>
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <cmath>
+#include <iostream>
 
 constexpr const float SHOOT_LINEAR_MAX = 8.0f;
 
@@ -248,6 +250,31 @@ TEST_F(FastSimulatorTest, VisionRate) {
     ASSERT_GE(test.m_counter, exp_packets * 0.8);
 }
 
+TEST_F(FastSimulatorTest, InProcessVision) {
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    std::vector<SSL_WrapperPacket> serialized;
+    test.handleDetectionWrapper = [&serialized] (const SSL_WrapperPacket &packet, qint64) {
+        serialized.push_back(packet);
+    };
+    std::vector<SSL_WrapperPacket> direct;
+    QObject::connect(s, &Simulator::gotVisionPackets, [&direct](const QList<SSL_WrapperPacket> &packets, qint64, QString sender) {
+        ASSERT_EQ(sender, QString("simulator"));
+        direct.insert(direct.end(), packets.begin(), packets.end());
+    });
+    int states = 0;
+    QObject::connect(s, &Simulator::sendRealState, [&states](const world::SimulatorState &) {
+        states++;
+    });
+
+    FastSimulator::goDelta(s, &t, 2e8); // 200 millisecond
+    ASSERT_GT(direct.size(), 0u);
+    ASSERT_GT(states, 0);
+    ASSERT_EQ(direct.size(), serialized.size());
+    for (std::size_t i = 0; i < direct.size(); i++) {
+        ASSERT_EQ(direct[i].SerializeAsString(), serialized[i].SerializeAsString());
+    }
+}
+
 TEST_F(FastSimulatorTest, OriginString) {
     QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
     FastSimulator::goDelta(s, &t, 5e8); // 500 millisecond
@@ -382,6 +409,55 @@ TEST_F(FastSimulatorTest, DriveRobotForwardBlue) {
     FastSimulator::goDeltaCallback(s, &t, 18e8, callback2); // summa summarum 2 seconds
 }
 
+TEST_F(FastSimulatorTest, SnapshotRestore) {
+    loadRobots(1, 1);
+    FastSimulator::goDelta(s, &t, 1e8);
+
+    SSLSimRobotControl control{new sslsim::RobotControl};
+    auto* cmd = control->add_robot_commands();
+    cmd->set_id(0);
+    auto * localVel = cmd->mutable_move_command()->mutable_local_velocity();
+    localVel->set_forward(0.5);
+    localVel->set_left(0.2);
+    localVel->set_angular(1);
+    auto callback = [&control, this]() {
+        emit this->test.sendSSLRadioCommand(control, true, 0);
+    };
+    FastSimulator::goDeltaCallback(s, &t, 2e8, callback);
+
+    const auto snapshot = s->snapshot();
+    const qint64 snapshotTime = t.currentTime();
+
+    world::SimulatorState lastTruth;
+    test.handleSimulatorTruth = [&lastTruth](const world::SimulatorState &truth) {
+        lastTruth = truth;
+    };
+    auto rollout = [&]() {
+        s->restore(*snapshot);
+        t.setTime(snapshotTime, 0);
+        FastSimulator::goDeltaCallback(s, &t, 5e8, callback);
+        return lastTruth;
+    };
+
+    const world::SimulatorState first = rollout();
+    // a different branch must not leak into the next rollout
+    loadRobots(2, 0);
+    FastSimulator::goDelta(s, &t, 1e8);
+    const world::SimulatorState second = rollout();
+
+    ASSERT_EQ(first.time(), second.time());
+    ASSERT_EQ(second.blue_robots_size(), 1);
+    ASSERT_EQ(second.yellow_robots_size(), 1);
+    ASSERT_NEAR(first.blue_robots(0).p_x(), second.blue_robots(0).p_x(), 1e-4);
+    ASSERT_NEAR(first.blue_robots(0).p_y(), second.blue_robots(0).p_y(), 1e-4);
+    ASSERT_NEAR(first.blue_robots(0).v_x(), second.blue_robots(0).v_x(), 1e-4);
+    ASSERT_NEAR(first.blue_robots(0).v_y(), second.blue_robots(0).v_y(), 1e-4);
+    ASSERT_NEAR(first.yellow_robots(0).p_x(), second.yellow_robots(0).p_x(), 1e-4);
+    ASSERT_NEAR(first.yellow_robots(0).p_y(), second.yellow_robots(0).p_y(), 1e-4);
+    ASSERT_NEAR(first.ball().p_x(), second.ball().p_x(), 1e-4);
+    ASSERT_NEAR(first.ball().p_y(), second.ball().p_y(), 1e-4);
+}
+
 TEST_F(FastSimulatorTest, DriveRobotRightBlue) {
     loadRobots(1, 0);
     float phi=0.f, x = 0.f, y = 0.f;
@@ -941,6 +1017,117 @@ TEST_F(FastSimulatorTest, CameraOverlap) {
     checkCameras(Vector(2, -0.49), {0, 2});
 }
 
+class PerformanceProfileTest : public FastSimulatorTest {
+protected:
+    PerformanceProfileTest() : FastSimulatorTest() {
+        loadConfiguration("cpptests/simulator-2020", &baseSetup, false);
+
+        // half of each team drives around, the others stand still and may fall asleep
+        for (int id = 0; id < 6; id++) {
+            auto* cmd = control->add_robot_commands();
+            cmd->set_id(id);
+            auto * localVel = cmd->mutable_move_command()->mutable_local_velocity();
+            localVel->set_forward(0.3f + 0.1f * id);
+            localVel->set_left(0.05f * id);
+            localVel->set_angular(0.2f * (id - 3));
+        }
+    }
+
+    // runs 11 robots per team for the given time, returns the last simulator state
+    world::SimulatorState simulate(const amun::SimulatorSetup &setup, qint64 duration) {
+        createSimulator(setup);
+        loadRobots(11, 11);
+        world::SimulatorState lastTruth;
+        test.handleSimulatorTruth = [&lastTruth](const world::SimulatorState &truth) {
+            lastTruth = truth;
+        };
+        FastSimulator::goDeltaCallback(s, &t, duration, [this]() {
+            emit test.sendSSLRadioCommand(control, true, 0);
+            emit test.sendSSLRadioCommand(control, false, 0);
+        });
+        test.handleSimulatorTruth = [](const world::SimulatorState&) {};
+        return lastTruth;
+    }
+
+    amun::SimulatorSetup setupWith(const amun::SimulatorPerformanceProfile &profile) const {
+        amun::SimulatorSetup setup = baseSetup;
+        setup.mutable_performance()->CopyFrom(profile);
+        return setup;
+    }
+
+    // maximum distance of the ball or any robot between the two states
+    static float divergence(const world::SimulatorState &a, const world::SimulatorState &b) {
+        float maxDistance = Vector(a.ball().p_x() - b.ball().p_x(), a.ball().p_y() - b.ball().p_y()).length();
+        for (int i = 0; i < a.blue_robots_size(); i++) {
+            maxDistance = std::max(maxDistance, Vector(a.blue_robots(i).p_x() - b.blue_robots(i).p_x(),
+                                                       a.blue_robots(i).p_y() - b.blue_robots(i).p_y()).length());
+        }
+        for (int i = 0; i < a.yellow_robots_size(); i++) {
+            maxDistance = std::max(maxDistance, Vector(a.yellow_robots(i).p_x() - b.yellow_robots(i).p_x(),
+                                                       a.yellow_robots(i).p_y() - b.yellow_robots(i).p_y()).length());
+        }
+        return maxDistance;
+    }
+
+    amun::SimulatorSetup baseSetup;
+    SSLSimRobotControl control{new sslsim::RobotControl};
+};
+
+TEST_F(PerformanceProfileTest, DefaultProfileKeepsSimulation) {
+    const qint64 DURATION = 1e9;
+    const world::SimulatorState reference = simulate(baseSetup, DURATION);
+    ASSERT_EQ(reference.blue_robots_size(), 11);
+    ASSERT_EQ(reference.yellow_robots_size(), 11);
+
+    // an explicitly set default profile must not change anything
+    const world::SimulatorState truth = simulate(setupWith(amun::SimulatorPerformanceProfile()), DURATION);
+    ASSERT_EQ(truth.time(), reference.time());
+    ASSERT_EQ(divergence(reference, truth), 0.0f);
+}
+
+TEST_F(PerformanceProfileTest, AxisSweepStaysClose) {
+    const qint64 DURATION = 1e9;
+    const world::SimulatorState reference = simulate(baseSetup, DURATION);
+
+    // the broadphase only changes the order in which the contact pairs are found,
+    // which may only cause rounding differences within one second
+    amun::SimulatorPerformanceProfile profile;
+    profile.set_broadphase(amun::SimulatorPerformanceProfile::AXIS_SWEEP);
+    const world::SimulatorState truth = simulate(setupWith(profile), DURATION);
+    ASSERT_EQ(truth.time(), reference.time());
+    ASSERT_EQ(truth.blue_robots_size(), reference.blue_robots_size());
+    ASSERT_EQ(truth.yellow_robots_size(), reference.yellow_robots_size());
+    ASSERT_LT(divergence(reference, truth), 0.01f);
+}
+
+// run with --gtest_also_run_disabled_tests to compare the speed of the profiles
+TEST_F(PerformanceProfileTest, DISABLED_Benchmark) {
+    const qint64 DURATION = 3e9;
+    auto run = [&](const amun::SimulatorPerformanceProfile &profile, world::SimulatorState &truth) {
+        const auto start = std::chrono::steady_clock::now();
+        truth = simulate(setupWith(profile), DURATION);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return DURATION * 1E-9 / seconds;
+    };
+
+    amun::SimulatorPerformanceProfile tuned;
+    tuned.set_broadphase(amun::SimulatorPerformanceProfile::AXIS_SWEEP);
+    tuned.set_solver_iterations(6);
+    tuned.set_robot_sleeping_speed(0.1f);
+    amun::SimulatorPerformanceProfile coarse = tuned;
+    coarse.set_sub_step_rate(100);
+
+    world::SimulatorState reference;
+    const double referenceSpeed = run(amun::SimulatorPerformanceProfile(), reference);
+    std::cout << "default profile: " << referenceSpeed << "x real time" << std::endl;
+    for (const auto &profile : { tuned, coarse }) {
+        world::SimulatorState truth;
+        const double speed = run(profile, truth);
+        std::cout << profile.solver_iterations() << " solver iterations at " << profile.sub_step_rate() << " Hz: "
+                  << speed << "x real time, " << divergence(reference, truth) << " m divergence" << std::endl;
+    }
+}
+
 TEST_F(ShootTest, ShootSpeed) {
     for (const float expected_speed : { 2.0f, 4.0f, 6.0f, 8.0f }) {
         prepareShoot();
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "amun/statusbus.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <string>
+#include <vector>
+
+static Status createStatus(qint64 time)
+{
+    Status status(new amun::Status);
+    status->set_time(time);
+    return status;
+}
+
+TEST(StatusBus, LosslessKeepsOrderOnOverflow) {
+    std::string appName = "unittest";
+    char* args[2] = {const_cast<char*>(appName.c_str()), nullptr};
+    int argCount = 1;
+    QCoreApplication app(argCount, args);
+
+    QObject context;
+    std::vector<qint64> received;
+    StatusBus bus;
+    bus.subscribe("lossless", &context, [&received](const Status &status) {
+        received.push_back(status->time());
+    }, StatusBus::Policy::Lossless, 4);
+
+    const int COUNT = 20;
+    for (int i = 0; i < COUNT; i++) {
+        bus.publish(createStatus(i));
+    }
+    ASSERT_EQ(bus.metrics().first().depth, COUNT);
+    ASSERT_TRUE(received.empty());
+
+    QCoreApplication::processEvents();
+    ASSERT_EQ(received.size(), static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; i++) {
+        ASSERT_EQ(received[i], i);
+    }
+
+    const StatusBus::QueueMetrics metrics = bus.metrics(true).first();
+    ASSERT_EQ(metrics.depth, 0);
+    ASSERT_EQ(metrics.delivered, static_cast<quint64>(COUNT));
+    ASSERT_EQ(metrics.dropped, 0u);
+    ASSERT_EQ(bus.metrics().first().delivered, 0u);
+}
+
+TEST(StatusBus, DropOldestKeepsNewest) {
+    std::string appName = "unittest";
+    char* args[2] = {const_cast<char*>(appName.c_str()), nullptr};
+    int argCount = 1;
+    QCoreApplication app(argCount, args);
+
+    QObject context;
+    std::vector<qint64> received;
+    StatusBus bus;
+    bus.subscribe("dropping", &context, [&received](const Status &status) {
+        received.push_back(status->time());
+    }, StatusBus::Policy::DropOldest, 4);
+
+    for (int i = 0; i < 10; i++) {
+        bus.publish(createStatus(i));
+    }
+    QCoreApplication::processEvents();
+
+    ASSERT_EQ(received, std::vector<qint64>({6, 7, 8, 9}));
+    const StatusBus::QueueMetrics metrics = bus.metrics().first();
+    ASSERT_EQ(metrics.capacity, 4);
+    ASSERT_EQ(metrics.dropped, 6u);
+    ASSERT_EQ(metrics.delivered, 4u);
+}
+
+TEST(StatusBus, DeliversOnContextThread) {
+    std::string appName = "unittest";
+    char* args[2] = {const_cast<char*>(appName.c_str()), nullptr};
+    int argCount = 1;
+    QCoreApplication app(argCount, args);
+
+    QThread thread;
+    QObject *context = new QObject;
+    context->moveToThread(&thread);
+    QObject::connect(&thread, &QThread::finished, context, &QObject::deleteLater);
+
+    const int COUNT = 1000;
+    std::vector<qint64> received;
+    bool wrongThread = false;
+    StatusBus bus;
+    bus.subscribe("threaded", context, [&](const Status &status) {
+        wrongThread |= QThread::currentThread() != &thread;
+        received.push_back(status->time());
+        if (received.size() == COUNT) {
+            thread.quit();
+        }
+    }, StatusBus::Policy::Lossless, 64);
+
+    thread.start();
+    for (int i = 0; i < COUNT; i++) {
+        bus.publish(createStatus(i));
+    }
+    ASSERT_TRUE(thread.wait(10000));
+
+    ASSERT_FALSE(wrongThread);
+    ASSERT_EQ(received.size(), static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; i++) {
+        ASSERT_EQ(received[i], i);
+    }
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "core/rng.h"
+#include "path/distancefield.h"
+#include "path/worldinformation.h"
+
+#include <algorithm>
+
+static WorldInformation constructWorld(float distanceFieldResolution) {
+    WorldInformation world;
+    world.setRadius(0.08f);
+    world.setBoundary(-3, -4, 3, 4);
+    world.setRobotId(0);
+    world.clearObstacles();
+    world.addCircle(1, 1, 0.5f, "circle", 1);
+    world.addRect(-2, -3, -1, -2, "rect", 1, 0.1f);
+    world.addLine(0, -2, 2, 0, 0.05f, "line", 1);
+    world.addTriangle(-2, 1, -1, 2, -2, 3, 0.02f, "triangle", 1);
+    world.setStaticDistanceFieldResolution(distanceFieldResolution);
+    world.collectObstacles();
+    return world;
+}
+
+TEST(StaticDistanceField, ErrorBound) {
+    const WorldInformation world = constructWorld(0.02f);
+    const StaticDistanceField *field = world.staticDistanceField();
+    ASSERT_NE(field, nullptr);
+
+    RNG rng(1);
+    for (int i = 0;i<10000;i++) {
+        const Vector pos = rng.uniformVectorIn(Vector(-3, -4), Vector(3, 4));
+        ASSERT_TRUE(field->contains(pos));
+        float exact = 1.0f;
+        for (const auto o : world.staticObstacles()) {
+            exact = std::min(exact, o->distance(pos));
+        }
+        ASSERT_NEAR(field->distance(pos), exact, field->errorBound());
+    }
+}
+
+TEST(StaticDistanceField, SameQueryResults) {
+    const WorldInformation exactWorld = constructWorld(0);
+    const WorldInformation rasterWorld = constructWorld(0.05f);
+    ASSERT_EQ(exactWorld.staticDistanceField(), nullptr);
+
+    RNG rng(2);
+    for (int i = 0;i<10000;i++) {
+        const Vector pos = rng.uniformVectorIn(Vector(-3, -4), Vector(3, 4));
+        ASSERT_EQ(exactWorld.isInStaticObstacle(pos), rasterWorld.isInStaticObstacle(pos));
+    }
+}
+
+TEST(StaticDistanceField, Cached) {
+    const WorldInformation world1 = constructWorld(0.05f);
+    const WorldInformation world2 = constructWorld(0.05f);
+    ASSERT_EQ(world1.staticDistanceField(), world2.staticDistanceField());
+    const WorldInformation world3 = constructWorld(0.04f);
+    ASSERT_NE(world1.staticDistanceField(), world3.staticDistanceField());
+}
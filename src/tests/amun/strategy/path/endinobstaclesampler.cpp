@@ -137,3 +137,28 @@ TEST(EndInObstacleSampler, WholeSampling) {
         ASSERT_LE(s1.distance(target), 1.6 + RADIUS);
     }
 }
+
+// the parallel evaluation must not depend on the thread timing
+TEST(EndInObstacleSampler, ParallelDeterministic) {
+    const Vector s0(1, 1);
+    const Vector s1(5, 5);
+    const TrajectoryInput input = constructBasicInput(s0, s1);
+
+    WorldInformation world = constructWorld();
+    world.addCircle(s1.x, s1.y, 2, "circle around target", 50);
+    world.collectObstacles();
+
+    std::vector<Vector> endPoints[2];
+    for (auto &points : endPoints) {
+        PathDebug debug;
+        RNG rng(1);
+        EndInObstacleSampler sampler(&rng, world, debug);
+        sampler.setParallelEvaluation(true);
+        for (int i = 0;i<50;i++) {
+            ASSERT_TRUE(sampler.compute(input));
+            points.push_back(sampler.getResult()[0].endPosition());
+        }
+    }
+    ASSERT_EQ(endPoints[0], endPoints[1]);
+    ASSERT_LT(endPoints[0].back().distance(s1), 2.5f);
+}
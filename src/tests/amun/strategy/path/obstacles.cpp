@@ -594,7 +594,7 @@ TEST(Obstacles, FriendlyRobot_Distance) {
                                         {{Vector(0.5, 0), Vector(0, 0)}, 0.5},
                                         {{Vector(1, 0), Vector(0, 0)}, 1},
                                         {{Vector(1, 0.5), Vector(0, 0)}, 1.5}};
-    FriendlyRobotObstacle o(&points, 0.5, 0);
+    FriendlyRobotObstacle o(std::make_shared<SharedTrajectory>(points), 0.5, 0);
 
     ASSERT_FLOAT_EQ(o.distance({{Vector(0, 0), Vector(0, 0)}, 0}), -0.5);
     ASSERT_FLOAT_EQ(o.distance({{Vector(1, 0.5), Vector(0, 0)}, 4}), -0.5);
@@ -606,7 +606,7 @@ TEST(Obstacles, FriendlyRobot_Intersects) {
                                         {{Vector(0.5, 0), Vector(0, 0)}, 0.5},
                                         {{Vector(1, 0), Vector(0, 0)}, 1},
                                         {{Vector(1, 0.5), Vector(0, 0)}, 1.5}};
-    FriendlyRobotObstacle o(&points, 0.5, 0);
+    FriendlyRobotObstacle o(std::make_shared<SharedTrajectory>(points), 0.5, 0);
 
     ASSERT_TRUE(o.intersects({{Vector(0, 0), Vector(0, 0)}, 0}));
     ASSERT_TRUE(o.intersects({{Vector(0.49, 0), Vector(0, 0)}, 0}));
@@ -622,7 +622,7 @@ TEST(Obstacles, FriendlyRobot_ZonedDistance) {
                                         {{Vector(0.5, 0), Vector(0, 0)}, 0.5},
                                         {{Vector(1, 0), Vector(0, 0)}, 1},
                                         {{Vector(1, 0.5), Vector(0, 0)}, 1.5}};
-    FriendlyRobotObstacle o(&points, 0.5, 0);
+    FriendlyRobotObstacle o(std::make_shared<SharedTrajectory>(points), 0.5, 0);
 
     ASSERT_LE(o.zonedDistance({{Vector(0, 0), Vector(0, 0)}, 0}, 0.1), 0);
     ASSERT_LE(o.zonedDistance({{Vector(0.49, 0), Vector(0, 0)}, 0}, 0.1), 0);
@@ -639,7 +639,7 @@ TEST(Obstacles, FriendlyRobot_BoundingBox) {
                                         {{Vector(0.5, 0), Vector(0, 0)}, 0.5},
                                         {{Vector(1, 0), Vector(0, 0)}, 1},
                                         {{Vector(1, 0.5), Vector(0, 0)}, 1.5}};
-    FriendlyRobotObstacle o(&points, 0.5, 0);
+    FriendlyRobotObstacle o(std::make_shared<SharedTrajectory>(points), 0.5, 0);
 
     auto b = o.boundingBox();
 
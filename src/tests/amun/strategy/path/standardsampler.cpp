@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "core/rng.h"
+#include "path/standardsampler.h"
+#include "path/worldinformation.h"
+#include "path/trajectory.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+    // checks a fixed list of samples instead of the generated ones
+    class FixedSampleSampler : public LiveStandardSampler
+    {
+    public:
+        FixedSampleSampler(RNG *rng, const WorldInformation &world, PathDebug &debug,
+                           const std::vector<StandardTrajectorySample> &samples) :
+            LiveStandardSampler(rng, world, debug),
+            m_samples(samples)
+        { }
+
+    private:
+        void computeSamples(const TrajectoryInput &input, const StandardSamplerBestTrajectoryInfo&) override
+        {
+            checkSamples(input, m_samples);
+        }
+
+    private:
+        const std::vector<StandardTrajectorySample> m_samples;
+    };
+}
+
+static WorldInformation constructWorld()
+{
+    WorldInformation world;
+    world.setRadius(0.08f);
+    world.setBoundary(-10, -10, 10, 10);
+    world.setOutOfFieldObstaclePriority(50);
+    world.setRobotId(0);
+    world.clearObstacles();
+    world.addCircle(3, 3, 0.5f, "circle", 50);
+    world.addCircle(1, 4, 0.3f, "small circle", 50);
+    world.collectObstacles();
+    return world;
+}
+
+static TrajectoryInput constructInput(Vector s0, Vector s1)
+{
+    TrajectoryInput input;
+    input.start = RobotState(s0, Vector(0, 0));
+    input.target = RobotState(s1, Vector(0, 0));
+    input.t0 = 0;
+    input.exponentialSlowDown = true;
+    input.maxSpeed = 3;
+    input.maxSpeedSquared = input.maxSpeed * input.maxSpeed;
+    input.acceleration = 3.5;
+    return input;
+}
+
+// the parallel evaluation must select the same trajectory as checking the samples one after another
+TEST(StandardSampler, ParallelMatchesSerial) {
+    RNG sampleRng(3);
+    std::vector<StandardTrajectorySample> samples;
+    for (int i = 0;i<500;i++) {
+        Vector speed;
+        do {
+            speed = Vector(sampleRng.uniformFloat(-3, 3), sampleRng.uniformFloat(-3, 3));
+        } while (speed.lengthSquared() >= 9);
+        samples.emplace_back(sampleRng.uniformFloat(0, 4), sampleRng.uniformFloat(0, float(2 * M_PI)), speed);
+    }
+
+    const WorldInformation world = constructWorld();
+    PathDebug serialDebug, parallelDebug;
+    RNG serialRng(1), parallelRng(1);
+    FixedSampleSampler serial(&serialRng, world, serialDebug, samples);
+    FixedSampleSampler parallel(&parallelRng, world, parallelDebug, samples);
+    parallel.setParallelEvaluation(true);
+
+    const std::vector<Vector> targets = { Vector(5, 5), Vector(4.5f, 5.5f), Vector(-2, 3), Vector(0.5f, 6), Vector(5, 5) };
+    for (const Vector &target : targets) {
+        SCOPED_TRACE(target.x);
+        const TrajectoryInput input = constructInput(Vector(1, 1), target);
+        const bool serialValid = serial.compute(input);
+        ASSERT_EQ(parallel.compute(input), serialValid);
+        if (!serialValid) {
+            continue;
+        }
+
+        ASSERT_EQ(parallel.getScore(), serial.getScore());
+        const std::vector<Trajectory> &serialResult = serial.getResult();
+        const std::vector<Trajectory> &parallelResult = parallel.getResult();
+        ASSERT_EQ(parallelResult.size(), serialResult.size());
+        for (std::size_t i = 0;i<serialResult.size();i++) {
+            ASSERT_EQ(parallelResult[i].endTime(), serialResult[i].endTime());
+            ASSERT_EQ(parallelResult[i].endPosition(), serialResult[i].endPosition());
+        }
+    }
+}
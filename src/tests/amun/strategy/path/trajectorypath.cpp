@@ -56,14 +56,14 @@ TEST(TrajectoryPath, calculateTrajectory) {
 
         path.calculateTrajectory(startPos, startSpeed, endPos, Vector{0, 0}, 3, 3);
 
-        const auto obstaclePoints = path.getCurrentTrajectory();
-        const float desiredInterval = obstaclePoints->at(1).time - obstaclePoints->at(0).time;
-        for (std::size_t i = 1;i<obstaclePoints->size();i++) {
-            const float interval = obstaclePoints->at(i).time - obstaclePoints->at(i-1).time;
+        const auto &obstaclePoints = (*path.getCurrentTrajectory())->points();
+        const float desiredInterval = obstaclePoints.at(1).time - obstaclePoints.at(0).time;
+        for (std::size_t i = 1;i<obstaclePoints.size();i++) {
+            const float interval = obstaclePoints.at(i).time - obstaclePoints.at(i-1).time;
             ASSERT_LE(std::abs(desiredInterval - interval), 0.0001f);
         }
 
-        ASSERT_EQ(obstaclePoints->at(0).time, 0);
+        ASSERT_EQ(obstaclePoints.at(0).time, 0);
     }
 }
 
@@ -87,9 +87,10 @@ TEST(TrajectoryPath, serialize) {
     world.addMovingLine(Vector{5, 6}, Vector{7, 8}, Vector{9, 10}, Vector{11, 12}, Vector{13, 14}, Vector{15, 16}, 11, 12, 0.15, 42);
     world.addOpponentRobotObstacle(Vector{3, 4}, Vector{5, 6}, 7);
 
-    std::vector<TrajectoryPoint> friendlyObstacle = {{{Vector{0, 0}, Vector{1, 1}}, 0}, {{Vector{2, 2}, Vector{0, 0}}, 1},
-                                                    {{Vector{3, 3}, Vector{1, 0}}, 2}, {{Vector{4, 4}, Vector{0, 1}}, 3}};
-    world.addFriendlyRobotTrajectoryObstacle(&friendlyObstacle, 9, 0.2f);
+    const auto friendlyObstacle = std::make_shared<SharedTrajectory>(std::vector<TrajectoryPoint>{
+            {{Vector{0, 0}, Vector{1, 1}}, 0}, {{Vector{2, 2}, Vector{0, 0}}, 1},
+            {{Vector{3, 3}, Vector{1, 0}}, 2}, {{Vector{4, 4}, Vector{0, 1}}, 3}});
+    world.addFriendlyRobotTrajectoryObstacle(friendlyObstacle, 9, 0.2f);
 
     path.calculateTrajectory(Vector{0, 0}, Vector{1, 1}, Vector{2, 2}, Vector{3, 3}, 4, 5);
 
@@ -122,3 +123,23 @@ TEST(TrajectoryPath, serialize) {
                            [](const Obstacles::Obstacle *a, const Obstacles::Obstacle *b) { return (*a) == (*b); }));
     QFile::remove(filename);
 }
+
+TEST(TrajectoryPath, trajectorySnapshotSurvivesReplanning) {
+    TrajectoryPath path(1, nullptr, pathfinding::None);
+    path.world().setBoundary(-3, -3, 3, 3);
+    path.world().setRadius(0.09f);
+
+    path.calculateTrajectory(Vector{0, 0}, Vector{0, 0}, Vector{2, 0}, Vector{0, 0}, 3, 3);
+    const SharedTrajectoryPtr snapshot = *path.getCurrentTrajectory();
+    const std::vector<TrajectoryPoint> points = snapshot->points();
+    ASSERT_GT(points.size(), 1u);
+
+    path.calculateTrajectory(Vector{0, 0}, Vector{0, 0}, Vector{-2, 1}, Vector{0, 0}, 3, 3);
+    ASSERT_NE(snapshot, *path.getCurrentTrajectory());
+
+    ASSERT_EQ(snapshot->size(), points.size());
+    for (std::size_t i = 0;i<points.size();i++) {
+        ASSERT_EQ(snapshot->points()[i].state.pos, points[i].state.pos);
+        ASSERT_EQ(snapshot->points()[i].time, points[i].time);
+    }
+}
@@ -0,0 +1,243 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "core/allocationprofiler.h"
+
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+    // the parts of the protobuf wire format used by pprof
+    struct WireField {
+        int number;
+        quint64 value;
+        QByteArray bytes;
+    };
+
+    bool readVarint(const QByteArray &data, int &pos, quint64 &value)
+    {
+        value = 0;
+        for (int shift = 0; pos < data.size() && shift < 64; shift += 7) {
+            const quint8 byte = static_cast<quint8>(data[pos++]);
+            value |= static_cast<quint64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<WireField> decodeMessage(const QByteArray &data)
+    {
+        std::vector<WireField> fields;
+        int pos = 0;
+        while (pos < data.size()) {
+            quint64 tag;
+            EXPECT_TRUE(readVarint(data, pos, tag));
+            WireField field{static_cast<int>(tag >> 3), 0, QByteArray()};
+            if ((tag & 7) == 0) {
+                EXPECT_TRUE(readVarint(data, pos, field.value));
+            } else if ((tag & 7) == 2) {
+                quint64 length;
+                EXPECT_TRUE(readVarint(data, pos, length));
+                EXPECT_LE(pos + static_cast<qint64>(length), data.size());
+                field.bytes = data.mid(pos, static_cast<int>(length));
+                pos += static_cast<int>(length);
+            } else {
+                ADD_FAILURE() << "unexpected wire type " << (tag & 7);
+                return fields;
+            }
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    std::vector<quint64> decodePacked(const QByteArray &data)
+    {
+        std::vector<quint64> values;
+        int pos = 0;
+        quint64 value;
+        while (pos < data.size() && readVarint(data, pos, value)) {
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    // checks that the string indices of the given fields in message are within the string table
+    void checkStringIndices(const QByteArray &message, const std::set<int> &stringFields, size_t stringCount)
+    {
+        for (const WireField &field : decodeMessage(message)) {
+            if (stringFields.count(field.number) > 0) {
+                EXPECT_LT(field.value, stringCount) << "string index of field " << field.number;
+            }
+        }
+    }
+}
+
+static std::vector<std::unique_ptr<int>> allocateInts(int count)
+{
+    std::vector<std::unique_ptr<int>> result;
+    result.reserve(count);
+    for (int i = 0; i < count; i++) {
+        result.emplace_back(new int(i));
+    }
+    return result;
+}
+
+TEST(AllocationProfiler, DisabledCountsNothing) {
+    AllocationProfiler::setEnabled(false);
+    const AllocationProfiler::Totals before = AllocationProfiler::totals();
+    auto ints = allocateInts(100);
+    const AllocationProfiler::Totals after = AllocationProfiler::totals();
+    ASSERT_EQ(after.allocations, before.allocations);
+    ASSERT_EQ(after.bytes, before.bytes);
+}
+
+TEST(AllocationProfiler, CountsAllocationsOfAllThreads) {
+    AllocationProfiler::setEnabled(true);
+    const AllocationProfiler::Totals before = AllocationProfiler::totals();
+    auto ints = allocateInts(100);
+    std::thread thread([]() {
+        allocateInts(50);
+    });
+    thread.join();
+    const AllocationProfiler::Totals after = AllocationProfiler::totals();
+    AllocationProfiler::setEnabled(false);
+
+    // the vectors and the thread allocate as well
+    ASSERT_GE(after.allocations - before.allocations, 150u);
+    ASSERT_GE(after.bytes - before.bytes, 150 * sizeof(int));
+}
+
+TEST(AllocationProfiler, CountsMalloc) {
+    if (!AllocationProfiler::wrapsMalloc()) {
+        return;
+    }
+    AllocationProfiler::setEnabled(true);
+    const AllocationProfiler::Totals before = AllocationProfiler::totals();
+    std::vector<void*> blocks;
+    blocks.reserve(100);
+    for (int i = 0; i < 100; i++) {
+        blocks.push_back(std::malloc(64));
+    }
+    const AllocationProfiler::Totals after = AllocationProfiler::totals();
+    AllocationProfiler::setEnabled(false);
+    for (void *block : blocks) {
+        std::free(block);
+    }
+
+    ASSERT_GE(after.allocations - before.allocations, 100u);
+    ASSERT_GE(after.bytes - before.bytes, 100u * 64);
+}
+
+TEST(AllocationProfiler, ExportsValidProfile) {
+    AllocationProfiler::clear();
+    // sample every allocation
+    AllocationProfiler::setSampleInterval(1);
+    AllocationProfiler::setEnabled(true);
+    std::thread thread([]() {
+        auto ints = allocateInts(20);
+        ints.resize(10);
+    });
+    thread.join();
+    AllocationProfiler::setEnabled(false);
+    AllocationProfiler::setSampleInterval(512 * 1024);
+
+    const QByteArray profile = AllocationProfiler::pprofProfile();
+    const std::vector<WireField> fields = decodeMessage(profile);
+
+    std::vector<QByteArray> strings;
+    std::set<quint64> locationIds;
+    for (const WireField &field : fields) {
+        if (field.number == 6) {
+            strings.push_back(field.bytes);
+        } else if (field.number == 4) {
+            for (const WireField &locationField : decodeMessage(field.bytes)) {
+                if (locationField.number == 1) {
+                    locationIds.insert(locationField.value);
+                }
+            }
+        }
+    }
+    ASSERT_FALSE(strings.empty());
+    ASSERT_TRUE(strings[0].isEmpty());
+
+    int sampleTypes = 0;
+    int samples = 0;
+    for (const WireField &field : fields) {
+        switch (field.number) {
+        case 1: // sample_type
+        case 11: // period_type
+            checkStringIndices(field.bytes, {1, 2}, strings.size());
+            sampleTypes += field.number == 1;
+            break;
+        case 3: // mapping
+            checkStringIndices(field.bytes, {5, 6}, strings.size());
+            break;
+        case 5: // function
+            checkStringIndices(field.bytes, {2, 3, 4}, strings.size());
+            break;
+        case 7: // drop_frames
+        case 8: // keep_frames
+        case 14: // default_sample_type
+            EXPECT_LT(field.value, strings.size()) << "string index of field " << field.number;
+            break;
+        default:
+            break;
+        }
+    }
+    ASSERT_EQ(sampleTypes, 5);
+
+    for (const WireField &field : fields) {
+        if (field.number != 2) {
+            continue;
+        }
+        samples++;
+        bool hasThreadLabel = false;
+        for (const WireField &sampleField : decodeMessage(field.bytes)) {
+            if (sampleField.number == 1) {
+                for (quint64 id : decodePacked(sampleField.bytes)) {
+                    EXPECT_EQ(locationIds.count(id), 1u);
+                }
+            } else if (sampleField.number == 2) {
+                EXPECT_EQ(decodePacked(sampleField.bytes).size(), 5u);
+            } else if (sampleField.number == 3) {
+                checkStringIndices(sampleField.bytes, {1, 2, 4}, strings.size());
+                for (const WireField &labelField : decodeMessage(sampleField.bytes)) {
+                    if (labelField.number == 1 && labelField.value < strings.size() && strings[labelField.value] == "thread") {
+                        hasThreadLabel = true;
+                    }
+                }
+            }
+        }
+        EXPECT_TRUE(hasThreadLabel);
+    }
+    ASSERT_GT(samples, 0);
+
+    AllocationProfiler::clear();
+    int remainingSamples = 0;
+    for (const WireField &field : decodeMessage(AllocationProfiler::pprofProfile())) {
+        remainingSamples += field.number == 2;
+    }
+    ASSERT_EQ(remainingSamples, 0);
+}
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "core/tracing.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <thread>
+
+static QJsonArray spanEvents(const char *name)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(Tracing::chromeTrace());
+    QJsonArray result;
+    for (const QJsonValue &event : doc.object().value("traceEvents").toArray()) {
+        if (event.toObject().value("name").toString() == name) {
+            result.append(event);
+        }
+    }
+    return result;
+}
+
+TEST(Tracing, DisabledRecordsNothing) {
+    Tracing::clear();
+    Tracing::setEnabled(false);
+    {
+        TraceSpan span("Test::disabled", 42);
+    }
+    ASSERT_EQ(spanEvents("Test::disabled").size(), 0);
+}
+
+TEST(Tracing, ExportsSpansOfFinishedThreads) {
+    Tracing::clear();
+    Tracing::setEnabled(true);
+    std::thread thread([]() {
+        TraceSpan span("Test::worker");
+        span.setTick(1234);
+    });
+    thread.join();
+    {
+        TraceSpan span("Test::main \"quoted\"");
+    }
+    Tracing::setEnabled(false);
+
+    const QJsonArray workerSpans = spanEvents("Test::worker");
+    ASSERT_EQ(workerSpans.size(), 1);
+    const QJsonObject span = workerSpans.first().toObject();
+    ASSERT_EQ(span.value("ph").toString(), QString("X"));
+    ASSERT_GE(span.value("dur").toDouble(), 0);
+    ASSERT_EQ(span.value("args").toObject().value("tick").toDouble(), 1234);
+    ASSERT_EQ(spanEvents("Test::main \"quoted\"").size(), 1);
+
+    Tracing::clear();
+    ASSERT_EQ(spanEvents("Test::worker").size(), 0);
+}
@@ -0,0 +1,154 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "timeline/timelinereader.h"
+#include "timeline/timelinewriter.h"
+
+#include <QDataStream>
+#include <QFile>
+
+const static QString filename("temp_unittest_timeline.timeline");
+
+namespace {
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+}
+
+static timeline::TimelineInit makeInit()
+{
+    timeline::TimelineInit init;
+    init.mutable_primary()->set_hash("primary");
+    init.set_state(timeline::TimelineInit::Solved);
+    return init;
+}
+
+static timeline::Status makeStatus(int i)
+{
+    timeline::Status status;
+    status.mutable_wrapper()->set_tag(QString("tag %1").arg(i).toStdString());
+    return status;
+}
+
+TEST(Timeline, RandomAccess) {
+    DeleteFile del;
+    // spans multiple blocks
+    const int COUNT = 1000;
+    {
+        TimelineWriter writer;
+        ASSERT_TRUE(writer.open(filename));
+        ASSERT_TRUE(writer.writeInit(makeInit()));
+        for (int i = 0; i < COUNT; i++) {
+            ASSERT_TRUE(writer.writeStatus(makeStatus(i)));
+        }
+        writer.close();
+    }
+
+    TimelineReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.version(), 1);
+    ASSERT_EQ(reader.statusCount(), COUNT);
+
+    timeline::TimelineInit init;
+    ASSERT_TRUE(reader.readInit(init));
+    ASSERT_EQ(init.primary().hash(), "primary");
+
+    for (int i : {999, 0, 500, 257, 256, 255, 1}) {
+        timeline::Status status;
+        ASSERT_TRUE(reader.readStatus(i, status));
+        ASSERT_EQ(status.wrapper().tag(), makeStatus(i).wrapper().tag());
+    }
+    timeline::Status status;
+    ASSERT_FALSE(reader.readStatus(COUNT, status));
+    ASSERT_FALSE(reader.readStatus(-1, status));
+
+    QList<timeline::Status> list;
+    ASSERT_TRUE(reader.readFile(list, init));
+    ASSERT_EQ(list.size(), COUNT);
+    ASSERT_EQ(list[123].wrapper().tag(), makeStatus(123).wrapper().tag());
+}
+
+TEST(Timeline, ReadsVersion0) {
+    DeleteFile del;
+    {
+        QFile file(filename);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_4_6);
+        stream << QString("TIMELINE");
+        stream << (qint32) 0;
+        const auto write = [&stream](const google::protobuf::Message &message) {
+            QByteArray data;
+            data.resize(message.ByteSize());
+            message.SerializeToArray(data.data(), data.size());
+            stream << qCompress(data);
+        };
+        write(makeInit());
+        for (int i = 0; i < 10; i++) {
+            write(makeStatus(i));
+        }
+    }
+
+    TimelineReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.version(), 0);
+    ASSERT_EQ(reader.statusCount(), 10);
+
+    timeline::Status status;
+    ASSERT_TRUE(reader.readStatus(7, status));
+    ASSERT_EQ(status.wrapper().tag(), "tag 7");
+
+    QList<timeline::Status> list;
+    timeline::TimelineInit init;
+    ASSERT_TRUE(reader.readFile(list, init));
+    ASSERT_EQ(list.size(), 10);
+    ASSERT_EQ(init.primary().hash(), "primary");
+}
+
+TEST(Timeline, RecoversWithoutIndex) {
+    DeleteFile del;
+    {
+        TimelineWriter writer;
+        ASSERT_FALSE(writer.writeFile({}, makeInit()));
+        ASSERT_TRUE(writer.open(filename));
+        QList<timeline::Status> list;
+        for (int i = 0; i < 300; i++) {
+            list.append(makeStatus(i));
+        }
+        ASSERT_TRUE(writer.writeFile(list, makeInit()));
+        writer.close();
+    }
+    // cut off the index (48 bytes) and the end of the second block,
+    // as if the writer crashed while writing it
+    QFile file(filename);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.resize(file.size() - 60));
+    file.close();
+
+    TimelineReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.statusCount(), 256);
+    timeline::Status status;
+    ASSERT_TRUE(reader.readStatus(255, status));
+    ASSERT_EQ(status.wrapper().tag(), "tag 255");
+}
@@ -27,6 +27,8 @@
 #include <QDataStream>
 #include <QFile>
 #include <QList>
+#include <QPair>
+#include <QVector>
 
 class TimelineReader
 {
@@ -36,6 +38,7 @@ public:
     TimelineReader(const TimelineReader &) = delete;
     TimelineReader& operator=(const TimelineReader &) = delete;
 
+    // only reads the header and the index, entries are decoded on demand
     bool open(const QString &filename);
     void close();
     bool isOpen() const { return m_file.isOpen(); }
@@ -43,13 +46,40 @@ public:
     bool atEnd() const { return m_stream.atEnd(); }
 
     QString filename() const { return m_file.fileName(); }
+    qint32 version() const { return m_version; }
+    int statusCount() const { return m_statusCount; }
+
+    bool readInit(timeline::TimelineInit& init);
+    // random access, only the block containing the entry is decompressed
+    bool readStatus(int index, timeline::Status& status);
     bool readFile(QList<timeline::Status>& list, timeline::TimelineInit& init);
 
+private:
+    bool readIndex();
+    bool scanBlocks();
+    bool loadBlock(int block);
 
 private:
+    struct BlockInfo {
+        qint64 offset;
+        qint32 firstEntry;
+        qint32 entryCount;
+    };
+
     QFile m_file;
     QDataStream m_stream;
     QString m_errorMsg;
+
+    qint32 m_version;
+    qint64 m_initOffset;
+    int m_statusCount;
+    // version 0 files are treated as consisting of blocks with a single entry
+    QVector<BlockInfo> m_blocks;
+
+    int m_cachedBlock;
+    QByteArray m_blockData;
+    // start and size of the entries in m_blockData
+    QVector<QPair<int, int>> m_blockEntries;
 };
 
 #endif // TIMELINEREADER_H
@@ -27,6 +27,7 @@
 #include <QDataStream>
 #include <QFile>
 #include <QList>
+#include <QVector>
 
 class TimelineWriter
 {
@@ -37,15 +38,38 @@ public:
     TimelineWriter& operator=(const TimelineWriter &) = delete;
 
     bool open(const QString &filename);
+    // writes the pending block and the index
     void close();
     bool isOpen() const { return m_file.isOpen(); }
 
     QString filename() const { return m_file.fileName(); }
     bool writeFile(const QList<timeline::Status>& list, const timeline::TimelineInit& init);
 
+    // streaming interface, the init message has to be written first
+    bool writeInit(const timeline::TimelineInit& init);
+    bool writeStatus(const timeline::Status& status);
+
+private:
+    bool flushBlock();
+    bool writeIndex();
+
 private:
+    struct BlockInfo {
+        qint64 offset;
+        qint32 firstEntry;
+        qint32 entryCount;
+    };
+
     QFile m_file;
     QDataStream m_stream;
+
+    bool m_hasInit;
+    bool m_failed;
+    qint32 m_entryCount;
+    // uncompressed entries of the current block
+    QByteArray m_block;
+    qint32 m_blockEntries;
+    QVector<BlockInfo> m_index;
 };
 
 #endif // TIMELINEWRITER_H
@@ -0,0 +1,39 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef TIMELINEFORMAT_H
+#define TIMELINEFORMAT_H
+
+#include <QtGlobal>
+
+// Version 0: every entry is a separately compressed QByteArray
+// Version 1: the init message is followed by compressed blocks, each containing
+//   up to MAX_BLOCK_ENTRIES entries prefixed with their size as big endian quint32.
+//   The file ends with an index of all blocks (count, then offset, first entry, entry count per block)
+//   and a trailer containing the offset of the index and INDEX_MAGIC.
+namespace TimelineFormat {
+    constexpr qint32 CURRENT_VERSION = 1;
+    constexpr quint32 INDEX_MAGIC = 0x544c4958; // "TLIX"
+    constexpr qint64 TRAILER_SIZE = sizeof(qint64) + sizeof(quint32);
+
+    constexpr int MAX_BLOCK_ENTRIES = 256;
+    constexpr int MAX_BLOCK_BYTES = 256 * 1024;
+}
+
+#endif // TIMELINEFORMAT_H
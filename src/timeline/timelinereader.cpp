@@ -19,10 +19,17 @@
  ***************************************************************************/
 
 #include "timelinereader.h"
+#include "timelineformat.h"
+#include <QtEndian>
+#include <algorithm>
 
 TimelineReader::TimelineReader():
     m_file(),
-    m_stream(&m_file)
+    m_stream(&m_file),
+    m_version(-1),
+    m_initOffset(0),
+    m_statusCount(0),
+    m_cachedBlock(-1)
 {
     // ensure compatibility across qt versions
     m_stream.setVersion(QDataStream::Qt_4_6);
@@ -56,39 +63,189 @@ bool TimelineReader::open(const QString& filename)
         return false;
     }
 
-    qint32 version;
-    m_stream >> version;
+    m_stream >> m_version;
+    if (m_version < 0 || m_version > TimelineFormat::CURRENT_VERSION) {
+        m_errorMsg = "File format not supported!";
+        return false;
+    }
 
-    switch (version) {
-        case 0:
-            break;
-        default:
-            m_errorMsg = "File format not supported!";
-            return false;
+    // the init message is stored in the same way for all versions
+    m_initOffset = m_file.pos();
+    quint32 initSize;
+    m_stream >> initSize;
+    if (m_stream.status() != QDataStream::Ok || initSize == 0xFFFFFFFF || m_stream.skipRawData(initSize) != int(initSize)) {
+        close();
+        m_errorMsg = "Invalid format";
+        return false;
+    }
+
+    // a missing index means that the writer didn't finish, recover by scanning the blocks
+    if ((m_version == 0 || !readIndex()) && !scanBlocks()) {
+        close();
+        m_errorMsg = "Invalid format";
+        return false;
     }
     return true;
 }
 
 void TimelineReader::close()
 {
+    m_blocks.clear();
+    m_statusCount = 0;
+    m_cachedBlock = -1;
+    m_blockData.clear();
+    m_blockEntries.clear();
     if (!m_file.isOpen()) {
         return;
     }
     m_file.close();
 }
 
-static bool deserializeMessage(google::protobuf::Message& message, QDataStream& stream)
+bool TimelineReader::readIndex()
 {
-    // read and parse status
+    const qint64 dataStart = m_file.pos();
+    if (m_file.size() - dataStart < TimelineFormat::TRAILER_SIZE + qint64(sizeof(qint32))) {
+        return false;
+    }
+    m_file.seek(m_file.size() - TimelineFormat::TRAILER_SIZE);
+    qint64 indexOffset;
+    quint32 magic;
+    m_stream >> indexOffset >> magic;
+    if (magic != TimelineFormat::INDEX_MAGIC || indexOffset < dataStart || indexOffset > m_file.size() - TimelineFormat::TRAILER_SIZE) {
+        m_file.seek(dataStart);
+        return false;
+    }
+
+    m_file.seek(indexOffset);
+    qint32 blockCount;
+    m_stream >> blockCount;
+    if (blockCount < 0) {
+        m_file.seek(dataStart);
+        return false;
+    }
+    m_blocks.reserve(blockCount);
+    int expectedFirst = 0;
+    for (qint32 i = 0; i < blockCount; i++) {
+        BlockInfo block;
+        m_stream >> block.offset >> block.firstEntry >> block.entryCount;
+        if (m_stream.status() != QDataStream::Ok || block.firstEntry != expectedFirst || block.entryCount <= 0
+                || block.offset < dataStart || block.offset >= indexOffset) {
+            m_blocks.clear();
+            m_stream.resetStatus();
+            m_file.seek(dataStart);
+            return false;
+        }
+        expectedFirst += block.entryCount;
+        m_blocks.append(block);
+    }
+    m_statusCount = expectedFirst;
+    return true;
+}
+
+bool TimelineReader::scanBlocks()
+{
+    // only skips over the compressed data, the entries of a block are counted by decompressing them
+    m_blocks.clear();
+    m_statusCount = 0;
+    while (!m_stream.atEnd()) {
+        const qint64 offset = m_file.pos();
+        if (m_version == 0) {
+            quint32 size;
+            m_stream >> size;
+            if (m_stream.status() != QDataStream::Ok || size == 0xFFFFFFFF || m_stream.skipRawData(size) != int(size)) {
+                return false;
+            }
+            m_blocks.append(BlockInfo{offset, m_statusCount, 1});
+            m_statusCount++;
+        } else {
+            QByteArray compressed;
+            m_stream >> compressed;
+            const QByteArray block = qUncompress(compressed);
+            if (m_stream.status() != QDataStream::Ok || block.isEmpty()) {
+                // the index or a partially written block follows
+                break;
+            }
+            qint32 count = 0;
+            for (int pos = 0; pos + int(sizeof(quint32)) <= block.size(); count++) {
+                pos += sizeof(quint32) + qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(block.constData() + pos));
+            }
+            m_blocks.append(BlockInfo{offset, m_statusCount, count});
+            m_statusCount += count;
+        }
+    }
+    m_stream.resetStatus();
+    return true;
+}
+
+bool TimelineReader::loadBlock(int block)
+{
+    if (block == m_cachedBlock) {
+        return true;
+    }
+    m_cachedBlock = -1;
+    m_blockEntries.clear();
+
+    m_file.seek(m_blocks[block].offset);
+    QByteArray compressed;
+    m_stream >> compressed;
+    m_blockData = qUncompress(compressed);
+    if (m_stream.status() != QDataStream::Ok || m_blockData.isEmpty()) {
+        m_stream.resetStatus();
+        return false;
+    }
+
+    if (m_version == 0) {
+        m_blockEntries.append(qMakePair(0, m_blockData.size()));
+    } else {
+        int pos = 0;
+        while (pos + int(sizeof(quint32)) <= m_blockData.size()) {
+            const int size = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(m_blockData.constData() + pos));
+            pos += sizeof(quint32);
+            if (size < 0 || pos + size > m_blockData.size()) {
+                return false;
+            }
+            m_blockEntries.append(qMakePair(pos, size));
+            pos += size;
+        }
+        if (m_blockEntries.size() != m_blocks[block].entryCount) {
+            return false;
+        }
+    }
+    m_cachedBlock = block;
+    return true;
+}
+
+bool TimelineReader::readInit(timeline::TimelineInit& init)
+{
+    if (!isOpen()) {
+        return false;
+    }
+    m_file.seek(m_initOffset);
     QByteArray packet;
-    stream >> packet;
+    m_stream >> packet;
     packet = qUncompress(packet);
-    if (!packet.isEmpty()) {
-        if (message.ParseFromArray(packet.data(), packet.size())) {
-            return true;
-        }
+    if (packet.isEmpty() || !init.ParseFromArray(packet.data(), packet.size())) {
+        m_stream.resetStatus();
+        return false;
+    }
+    return true;
+}
+
+bool TimelineReader::readStatus(int index, timeline::Status& status)
+{
+    if (!isOpen() || index < 0 || index >= m_statusCount) {
+        return false;
+    }
+    // find the last block starting at or before the index
+    const auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), index, [](int i, const BlockInfo &block) {
+        return i < block.firstEntry;
+    });
+    const int block = int(it - m_blocks.begin()) - 1;
+    if (!loadBlock(block)) {
+        return false;
     }
-    return false;
+    const QPair<int, int> &entry = m_blockEntries[index - m_blocks[block].firstEntry];
+    return status.ParseFromArray(m_blockData.constData() + entry.first, entry.second);
 }
 
 bool TimelineReader::readFile(QList<timeline::Status>& list, timeline::TimelineInit& init)
@@ -96,13 +253,14 @@ bool TimelineReader::readFile(QList<timeline::Status>& list, timeline::TimelineI
     if (!isOpen()) {
         return false;
     }
-    if (!deserializeMessage(init, m_stream)) {
+    if (!readInit(init)) {
         close();
         return false;
     }
-    while (!atEnd()) {
+    list.reserve(list.size() + m_statusCount);
+    for (int i = 0; i < m_statusCount; i++) {
         timeline::Status s;
-        if (!deserializeMessage(s, m_stream)) {
+        if (!readStatus(i, s)) {
             close();
             return false;
         }
@@ -19,13 +19,21 @@
  ***************************************************************************/
 
 #include "timelinewriter.h"
+#include "timelineformat.h"
+#include <QtEndian>
 
 TimelineWriter::TimelineWriter():
     m_file(),
-    m_stream(&m_file)
+    m_stream(&m_file),
+    m_hasInit(false),
+    m_failed(false),
+    m_entryCount(0),
+    m_blockEntries(0)
 {
     // ensure compatibility across qt versions
     m_stream.setVersion(QDataStream::Qt_4_6);
+    // keeps the buffer allocated when the block is reset
+    m_block.reserve(TimelineFormat::MAX_BLOCK_BYTES);
 }
 
 TimelineWriter::~TimelineWriter()
@@ -35,15 +43,23 @@ TimelineWriter::~TimelineWriter()
 
 bool TimelineWriter::open(const QString& filename)
 {
+    close();
     m_file.setFileName(filename);
 
     if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         close();
         return false;
     }
+    m_hasInit = false;
+    m_failed = false;
+    m_entryCount = 0;
+    m_block.resize(0);
+    m_blockEntries = 0;
+    m_index.clear();
+
     // write log header
     m_stream << QString("TIMELINE");
-    m_stream << (qint32) 0; // log file version
+    m_stream << TimelineFormat::CURRENT_VERSION; // log file version
     return true;
 }
 
@@ -52,30 +68,100 @@ void TimelineWriter::close()
     if (!m_file.isOpen()) {
         return;
     }
+    // a file without init can't be read anyway
+    if (m_hasInit && !m_failed) {
+        if (flushBlock()) {
+            writeIndex();
+        }
+    }
     m_file.close();
 }
 
-static bool serializeMessage(const google::protobuf::Message& message, QDataStream& stream)
+static bool serializeMessage(const google::protobuf::Message& message, QByteArray &data)
 {
-    QByteArray data;
     data.resize(message.ByteSize());
-    if (!message.IsInitialized() || !message.SerializeToArray(data.data(), data.size())) {
+    return message.IsInitialized() && message.SerializeToArray(data.data(), data.size());
+}
+
+bool TimelineWriter::writeInit(const timeline::TimelineInit& init)
+{
+    if (!isOpen() || m_hasInit) {
+        return false;
+    }
+    QByteArray data;
+    if (!serializeMessage(init, data)) {
+        return false;
+    }
+    m_stream << qCompress(data);
+    m_hasInit = true;
+    return m_stream.status() == QDataStream::Ok;
+}
+
+bool TimelineWriter::writeStatus(const timeline::Status& status)
+{
+    if (!isOpen() || !m_hasInit || m_failed) {
+        return false;
+    }
+    const int size = status.ByteSize();
+    if (!status.IsInitialized()) {
         return false;
     }
-    stream << qCompress(data);
+
+    // append the entry in place
+    const int start = m_block.size();
+    m_block.resize(start + sizeof(quint32) + size);
+    qToBigEndian<quint32>(size, reinterpret_cast<uchar*>(m_block.data() + start));
+    if (!status.SerializeToArray(m_block.data() + start + sizeof(quint32), size)) {
+        m_block.resize(start);
+        return false;
+    }
+    m_blockEntries++;
+    m_entryCount++;
+
+    if (m_blockEntries >= TimelineFormat::MAX_BLOCK_ENTRIES || m_block.size() >= TimelineFormat::MAX_BLOCK_BYTES) {
+        return flushBlock();
+    }
     return true;
 }
 
+bool TimelineWriter::flushBlock()
+{
+    if (m_blockEntries == 0) {
+        return true;
+    }
+    const BlockInfo info{m_file.pos(), m_entryCount - m_blockEntries, m_blockEntries};
+    m_stream << qCompress(m_block);
+    if (m_stream.status() != QDataStream::Ok) {
+        m_failed = true;
+        return false;
+    }
+    m_index.append(info);
+    m_block.resize(0);
+    m_blockEntries = 0;
+    return true;
+}
+
+bool TimelineWriter::writeIndex()
+{
+    const qint64 indexOffset = m_file.pos();
+    m_stream << qint32(m_index.size());
+    for (const BlockInfo &block : m_index) {
+        m_stream << block.offset << block.firstEntry << block.entryCount;
+    }
+    m_stream << indexOffset << TimelineFormat::INDEX_MAGIC;
+    return m_stream.status() == QDataStream::Ok;
+}
+
 bool TimelineWriter::writeFile(const QList<timeline::Status>& list, const timeline::TimelineInit& init)
 {
     if (!isOpen()) {
         return false;
     }
-    if (!serializeMessage(init, m_stream)) {
+    if (!writeInit(init)) {
         return false;
     }
     for (const auto& event: list) {
-        if (!serializeMessage(event, m_stream)) {
+        if (!writeStatus(event)) {
             return false;
         }
     }
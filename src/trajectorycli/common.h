@@ -52,4 +52,5 @@ enum class CollisionTestType {
 
 int testCollisions(CollisionTestType testType, int scenarioCount, bool useOldObstacle, bool writeLogs);
 
-void checkTiming(std::vector<Situation> situations);
+// a positive distance field resolution also reports the static obstacle raster accuracy
+void checkTiming(std::vector<Situation> situations, float distanceFieldResolution);
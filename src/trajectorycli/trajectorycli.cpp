@@ -90,6 +90,8 @@ int main(int argc, char* argv[])
     parser.addOption(countCollisions);
     QCommandLineOption computeTiming("t", "Compute trajectory pathfinding timing");
     parser.addOption(computeTiming);
+    QCommandLineOption distanceField("d", "Use a static obstacle distance field with the given resolution for the timing", "resolution in meters", "0");
+    parser.addOption(distanceField);
 
     // parse command line
     parser.process(app);
@@ -193,7 +195,7 @@ int main(int argc, char* argv[])
             std::cerr <<"Error: trying to use pathfinding inputs not collected for the whole trajectorypath!"<<std::endl;
             exit(1);
         }
-        checkTiming(situations);
+        checkTiming(situations, parser.value(distanceField).toFloat());
     }
 
     return 0;
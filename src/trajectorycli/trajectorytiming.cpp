@@ -21,9 +21,47 @@
 #include "common.h"
 #include "path/trajectorypath.h"
 #include "core/timer.h"
+#include <algorithm>
+#include <cmath>
 
-void checkTiming(std::vector<Situation> situations)
+static void checkDistanceFieldAccuracy(std::vector<Situation> &situations, float resolution)
 {
+    float maxError = 0;
+    float errorBound = 0;
+    double errorSum = 0;
+    int samples = 0;
+    for (auto &situation : situations) {
+        situation.world.setStaticDistanceFieldResolution(resolution);
+        situation.world.collectObstacles();
+        const StaticDistanceField *field = situation.world.staticDistanceField();
+        if (!field) {
+            continue;
+        }
+        errorBound = field->errorBound();
+        for (const Vector &pos : {situation.input.start.pos, situation.input.target.pos}) {
+            if (!field->contains(pos)) {
+                continue;
+            }
+            // the raster is clamped, larger distances are irrelevant for the path finding
+            float exact = 1.0f;
+            for (const auto o : situation.world.staticObstacles()) {
+                exact = std::min(exact, o->distance(pos));
+            }
+            const float error = std::abs(field->distance(pos) - exact);
+            maxError = std::max(maxError, error);
+            errorSum += error;
+            samples++;
+        }
+    }
+    if (samples > 0) {
+        std::cout <<"Distance field error: "<<errorSum / samples * 1000<<" mm mean, "<<maxError * 1000<<" mm max, "
+                 <<errorBound * 1000<<" mm bound"<<std::endl;
+    }
+}
+
+void checkTiming(std::vector<Situation> situations, float distanceFieldResolution)
+{
+
     qint64 timeDiff = 0;
     const int ITERATIONS = 1;
 
@@ -42,6 +80,7 @@ void checkTiming(std::vector<Situation> situations)
         for (const auto &situation : situations) {
             auto &path = pathfindings[situation.world.robotId()];
             path->world() = situation.world;
+            path->world().setStaticDistanceFieldResolution(distanceFieldResolution);
 
             const auto &input = situation.input;
             path->calculateTrajectory(input.start.pos, input.start.speed, input.target.pos, input.target.speed, input.maxSpeed, input.acceleration);
@@ -53,4 +92,8 @@ void checkTiming(std::vector<Situation> situations)
 
     const float iterationTimeMs = (timeDiff / situations.size()) / 1000000.0f;
     std::cout <<"Time: "<<iterationTimeMs / ITERATIONS<<" ms per call"<<std::endl;
+
+    if (distanceFieldResolution > 0) {
+        checkDistanceFieldAccuracy(situations, distanceFieldResolution);
+    }
 }
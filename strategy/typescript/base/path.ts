@@ -221,6 +221,7 @@ interface PathObjectTrajectory extends PathObjectCommon {
 	maxIntersectingObstaclePrio(): number;
 	setRobotId?(id: number): void;
 	addOpponentRobotObstacle?(startX: number, startY: number, speedX: number, speedY: number, prio: number): void;
+	setParallelSampleEvaluation?(parallel: boolean): void;
 }
 
 interface AmunPath {
@@ -551,5 +552,12 @@ export class Path {
 	public maxIntersectingObstaclePrio(): number {
 		return this._trajectoryInst.maxIntersectingObstaclePrio();
 	}
+
+	/** Uses multiple threads to lower the path finding latency of this robot */
+	public setParallelSampleEvaluation(parallel: boolean) {
+		if (this._trajectoryInst.setParallelSampleEvaluation) {
+			this._trajectoryInst.setParallelSampleEvaluation(parallel);
+		}
+	}
 }
 